@@ -0,0 +1,12 @@
+#version 420 core
+out vec4 fragColor;
+
+in vec2 uvPosition;
+
+layout (binding = 0) uniform sampler2D uTexture;
+
+void main()
+{
+    // Layer texture holds premultiplied color
+    fragColor = texture(uTexture, uvPosition);
+}
@@ -0,0 +1,17 @@
+#version 420 core
+layout (std140, binding = 2) uniform CGUILayerBlock
+{
+    vec4 uRect;     // xy - bottom left, zw - top right, in NDC
+    vec2 uUVScale;  // used part of pooled texture
+};
+
+out vec2 uvPosition;
+
+void main()
+{
+    // Triangle strip corners are generated from vertex id, no vertex buffer is required
+    vec2 corner = vec2(float(gl_VertexID & 1), float((gl_VertexID >> 1) & 1));
+
+    uvPosition = corner * uUVScale;
+    gl_Position = vec4(mix(uRect.xy, uRect.zw, corner), 0.0f, 1.0f);
+}
@@ -0,0 +1,57 @@
+#version 420 core
+out vec4 fragColor;
+
+in vec2      vLocal;
+in float     vLength;
+in float     vHalfWidth;
+in float     vBevel;
+flat in vec2 vCaps;
+flat in vec4 vClip;
+
+layout (std140, binding = 1) uniform CGUILineBlock
+{
+    vec4  uTransform;   // xy - scale, zw - offset, data space to NDC
+    vec4  uColor;
+    vec2  uViewport;    // framebuffer size in pixels
+    float uWidth;       // line width in pixels
+    float uMiterLimit;  // miter length limit in half widths
+    int   uJoin;        // 0 - miter, 1 - round
+};
+
+void main()
+{
+    float distance_to_line;
+
+    if (vBevel >= 0.0f)
+    {
+        // Bevel triangle of the joint, only its outer edge is smoothed
+        distance_to_line = vBevel;
+    }
+    else if (uJoin == 1)
+    {
+        // Neighbour segment draws everything behind the bisector of the joint
+        if (dot(vLocal, vClip.xy) < 0.0f || dot(vLocal - vec2(vLength, 0.0f), vClip.zw) > 0.0f)
+        {
+            discard;
+        }
+
+        // Capsule distance, gives round joins and round caps
+        float along = max(max(-vLocal.x, vLocal.x - vLength), 0.0f);
+        distance_to_line = length(vec2(along, vLocal.y));
+    }
+    else
+    {
+        // Butt caps only on the open ends, miter area is left untouched
+        float start_cap = (vCaps.x > 0.5f) ? -vLocal.x : -1.0e6f;
+        float end_cap   = (vCaps.y > 0.5f) ? vLocal.x - vLength : -1.0e6f;
+        distance_to_line = max(abs(vLocal.y), max(start_cap, end_cap) + vHalfWidth);
+    }
+
+    float coverage = clamp(vHalfWidth - distance_to_line + 0.5f, 0.0f, 1.0f);
+    if (coverage <= 0.0f)
+    {
+        discard;
+    }
+
+    fragColor = vec4(uColor.rgb, uColor.a * coverage);
+}
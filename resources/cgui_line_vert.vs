@@ -0,0 +1,156 @@
+#version 420 core
+layout (location = 0) in vec2 aPrev;
+layout (location = 1) in vec2 aStart;
+layout (location = 2) in vec2 aEnd;
+layout (location = 3) in vec2 aNext;
+
+layout (std140, binding = 1) uniform CGUILineBlock
+{
+    vec4  uTransform;   // xy - scale, zw - offset, data space to NDC
+    vec4  uColor;
+    vec2  uViewport;    // framebuffer size in pixels
+    float uWidth;       // line width in pixels
+    float uMiterLimit;  // miter length limit in half widths
+    int   uJoin;        // 0 - miter, 1 - round
+};
+
+out vec2      vLocal;
+out float     vLength;
+out float     vHalfWidth;
+out float     vBevel;
+flat out vec2 vCaps;
+flat out vec4 vClip;
+
+const float CGUI_LINE_FEATHER = 1.0f;
+
+// Every instance is a quad of two triangles and a bevel triangle of its end joint
+const int CGUI_LINE_CORNERS[6] = int[6](0, 1, 2, 2, 1, 3);
+
+vec2 to_pixels(vec2 point)
+{
+    return ((point * uTransform.xy + uTransform.zw) * 0.5f + 0.5f) * uViewport;
+}
+
+vec2 normal_of(vec2 direction)
+{
+    return vec2(-direction.y, direction.x);
+}
+
+// Side of the joint, that is cut by the miter limit, 1 - side of the normal, -1 - opposite one
+float outer_side(vec2 direction, vec2 neighbour_direction)
+{
+    return (direction.x * neighbour_direction.y - direction.y * neighbour_direction.x > 0.0f) ? -1.0f : 1.0f;
+}
+
+bool is_over_limit(vec2 normal, vec2 neighbour_normal)
+{
+    vec2 miter_sum = normal + neighbour_normal;
+    return dot(miter_sum, miter_sum) < 1.0e-6f || dot(normalize(miter_sum), normal) * uMiterLimit < 1.0f;
+}
+
+vec2 miter_offset(vec2 normal, vec2 neighbour_normal, float half_width, float side, float outer)
+{
+    // Outer corner over the limit is closed by bevel triangle, inner corner always meets the neighbour
+    vec2 miter_sum = normal + neighbour_normal;
+    if (dot(miter_sum, miter_sum) < 1.0e-6f || (is_over_limit(normal, neighbour_normal) && side == outer))
+    {
+        return normal * half_width * side;
+    }
+
+    vec2 miter = normalize(miter_sum);
+    return miter * (half_width / dot(miter, normal)) * side;
+}
+
+// Joint is split by the bisector, so overlapping round ends are blended only once
+vec2 bisector_normal(vec2 direction, vec2 neighbour_direction)
+{
+    vec2 bisector_sum = direction + neighbour_direction;
+    return (dot(bisector_sum, bisector_sum) < 1.0e-6f) ? direction : normalize(bisector_sum);
+}
+
+void main()
+{
+    vec2 prev_point  = to_pixels(aPrev);
+    vec2 start_point = to_pixels(aStart);
+    vec2 end_point   = to_pixels(aEnd);
+    vec2 next_point  = to_pixels(aNext);
+
+    vec2 segment = end_point - start_point;
+    float segment_length = length(segment);
+    vec2 direction = (segment_length > 0.0f) ? segment / segment_length : vec2(1.0f, 0.0f);
+    vec2 normal = normal_of(direction);
+
+    vec2 prev_segment = start_point - prev_point;
+    vec2 next_segment = next_point - end_point;
+
+    // Endpoints are duplicated in the point buffer, so a zero length neighbour means an open end
+    bool has_prev = dot(prev_segment, prev_segment) > 1.0e-12f;
+    bool has_next = dot(next_segment, next_segment) > 1.0e-12f;
+
+    float half_width = uWidth * 0.5f + CGUI_LINE_FEATHER;
+
+    vec2 prev_direction = has_prev ? normalize(prev_segment) : direction;
+    vec2 next_direction = has_next ? normalize(next_segment) : direction;
+
+    vec2 position;
+    float bevel = -1.0f;
+
+    if (gl_VertexID >= 6)
+    {
+        // Bevel triangle of the end joint, it is degenerate, unless miter is over the limit
+        position = end_point;
+        if (uJoin == 0 && has_next && is_over_limit(normal, normal_of(next_direction)))
+        {
+            float outer = outer_side(direction, next_direction);
+            if (gl_VertexID == 7)
+            {
+                position += normal * half_width * outer;
+            }
+            else if (gl_VertexID == 8)
+            {
+                position += normal_of(next_direction) * half_width * outer;
+            }
+        }
+
+        // Distance to the bevel edge, scaled so that edge corners are at half width
+        bevel = (gl_VertexID == 6) ? 0.0f : half_width;
+    }
+    else
+    {
+        // Quad corners: 0 - start/left, 1 - start/right, 2 - end/left, 3 - end/right
+        int corner = CGUI_LINE_CORNERS[gl_VertexID];
+        bool at_end = corner >= 2;
+        float side = ((corner & 1) == 0) ? 1.0f : -1.0f;
+
+        if (uJoin == 1)
+        {
+            // Round joins and caps are produced by the capsule distance in the fragment stage
+            position = (at_end ? end_point + direction * half_width : start_point - direction * half_width) + normal * half_width * side;
+        }
+        else if (!at_end)
+        {
+            position = has_prev ? start_point + miter_offset(normal, normal_of(prev_direction), half_width, side, outer_side(prev_direction, direction))
+                                : start_point - direction * CGUI_LINE_FEATHER + normal * half_width * side;
+        }
+        else
+        {
+            position = has_next ? end_point + miter_offset(normal, normal_of(next_direction), half_width, side, outer_side(direction, next_direction))
+                                : end_point + direction * CGUI_LINE_FEATHER + normal * half_width * side;
+        }
+    }
+
+    vec2 local = position - start_point;
+
+    // Bisectors of both joints in segment space, zero ones do not clip anything
+    vec2 start_clip = (uJoin == 1 && has_prev) ? bisector_normal(prev_direction, direction) : vec2(0.0f);
+    vec2 end_clip   = (uJoin == 1 && has_next) ? bisector_normal(direction, next_direction) : vec2(0.0f);
+
+    vLocal      = vec2(dot(local, direction), dot(local, normal));
+    vLength     = segment_length;
+    vHalfWidth  = uWidth * 0.5f;
+    vBevel      = bevel;
+    vCaps       = vec2(has_prev ? 0.0f : 1.0f, has_next ? 0.0f : 1.0f);
+    vClip       = vec4(dot(start_clip, direction), dot(start_clip, normal), dot(end_clip, direction), dot(end_clip, normal));
+
+    gl_Position = vec4(position / uViewport * 2.0f - 1.0f, 0.0f, 1.0f);
+}
@@ -27,6 +27,13 @@
 // First shaders program (it is used for ...)
 #define GBG_VERT_SHADER_0 10
 #define GBG_FRAG_SHADER_0 11
-#define GBG_GEOM_SHADER_0 12
+
+// Second shaders program (it is used for instanced polylines)
+#define GBG_VERT_SHADER_1 20
+#define GBG_FRAG_SHADER_1 21
+
+// Third shaders program (it is used for layer compositing)
+#define GBG_VERT_SHADER_2 30
+#define GBG_FRAG_SHADER_2 31
 
 #endif // RESOURCES_HPP
\ No newline at end of file
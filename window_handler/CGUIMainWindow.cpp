@@ -44,7 +44,7 @@ CGUIMainWindow::CGUIMainWindow()
         close();
     }
 
-    debug_handler.post_log(__CGUI_OBF__("CGUI has been initialized successfully."), DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("CGUI has been initialized successfully."));
 
     if (!initialize_renderer())
     {
@@ -52,7 +52,7 @@ CGUIMainWindow::CGUIMainWindow()
         close();
     }
 
-    debug_handler.post_log(__CGUI_OBF__("Renderer has been initialized successfully."), DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("Renderer has been initialized successfully."));
 
     update_thread();
 
@@ -88,7 +88,19 @@ void CGUIMainWindow::hide()
  */
 void CGUIMainWindow::close()
 {
-    debug_handler.post_log(__CGUI_OBF__("Window has been closed."), DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("Window has been closed."));
+
+    // Uploader thread has to release shared context before it is destroyed
+    if (uploader != nullptr)
+    {
+        uploader->stop();
+    }
+
+    main_memory_tracker.report_leaks();
+
+    // Handlers, that are owned by this window and its renderer, are never destroyed
+    CGUILogWriter::stop_all();
+
     glfwSetWindowShouldClose(main_window, GLFW_TRUE);
     glfwTerminate();
     exit(EXIT_SUCCESS);
@@ -113,25 +125,31 @@ bool CGUIMainWindow::initialize(std::string main_window_name_arg, bool vertical_
     vertical_sync = vertical_sync_arg;
     full_screen = full_screen_arg;
 
-    debug_handler.post_log(__CGUI_OBF__("CGUI Initialization has started."), DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("CGUI Initialization has started."));
 
     // Add ini settings loader
-    debug_handler.post_log(__CGUI_OBF__("Ini file has been loaded. (Not implemented yet)"), DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("Ini file has been loaded. (Not implemented yet)"));
 
     glfwSetErrorCallback(CGUIDebugHandler::glfw_error_callback);
 
+    // Recent records of every thread are kept in memory and dumped on crash or Ctrl+Shift+D
+    if (!main_flight_recorder.install(debug_handler.get_log_path().parent_path()))
+    {
+        debug_handler.post_log(__CGUI_OBF__("Unable to install flight recorder."), DEBUG_MODE_WARNING);
+    }
+
     if (!glfwInit())
     {
         debug_handler.post_log(__CGUI_OBF__("Unable to initialize GLWF."), DEBUG_MODE_ERROR);
         return false;
     }
-    debug_handler.post_log(__CGUI_OBF__("GLFW has been initialized."), DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("GLFW has been initialized."));
 
     if (glfwPlatformSupported(GLFW_PLATFORM_X11))
     {
         glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_X11);
         glfwInitHint(GLFW_X11_XCB_VULKAN_SURFACE, GLFW_FALSE);
-        debug_handler.post_log(__CGUI_OBF__("Using X11 platform."), DEBUG_MODE_LOG);
+        CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("Using X11 platform."));
     }
 
     glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
@@ -164,7 +182,7 @@ bool CGUIMainWindow::initialize(std::string main_window_name_arg, bool vertical_
         glfwWindowHintString(GLFW_X11_INSTANCE_NAME, "CGUI");
     #endif
 
-    debug_handler.post_log(__CGUI_OBF__("Window hints have been set."), DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("Window hints have been set."));
 
     main_window = glfwCreateWindow(last_window_size.x, last_window_size.y, main_window_name.c_str(), NULL, NULL);
 
@@ -174,7 +192,29 @@ bool CGUIMainWindow::initialize(std::string main_window_name_arg, bool vertical_
         return false;
     }
 
-    debug_handler.post_log(__CGUI_OBF__("GLFW Window created."), DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("GLFW Window created."));
+
+    glfwMakeContextCurrent(main_window);
+
+    if (!gladLoadGL(glfwGetProcAddress))
+    {
+        debug_handler.post_log(__CGUI_OBF__("Unable to properly initialize GLAD."), DEBUG_MODE_ERROR);
+        return false;
+    }
+
+    // Has to wrap glad pointers before anything is created, so shader sources are known
+    main_frame_capture.install();
+
+    // Programs are compiled by driver, while the rest of the window is being set up
+    submit_shaders();
+
+    // Hidden window, whose context shares objects with the main one, is used by background uploader
+    upload_window = glfwCreateWindow(1, 1, main_window_name.c_str(), NULL, main_window);
+
+    if (!upload_window)
+    {
+        debug_handler.post_log(__CGUI_OBF__("Unable to create shared upload context."), DEBUG_MODE_WARNING);
+    }
 
     current_monitor = get_monitor_by_cpos(get_global_mouse_position(main_window));
 
@@ -182,17 +222,17 @@ bool CGUIMainWindow::initialize(std::string main_window_name_arg, bool vertical_
 
     last_window_position = {(monitor_video_mode->width - last_window_size.x) / 2, (monitor_video_mode->height - last_window_size.y) / 2};
 
-    debug_handler.post_log(__CGUI_OBF__("Monitor detected: ") + glfwGetMonitorName(current_monitor) + std::to_string(monitor_video_mode->width) + __CGUI_OBF__("x") + std::to_string(monitor_video_mode->height) , DEBUG_MODE_LOG);
+    CGUI_POST_FORMAT(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("Monitor detected: {}{}x{}"), glfwGetMonitorName(current_monitor), monitor_video_mode->width, monitor_video_mode->height);
 
     // Create invisible window in order to get mouse position
     if (full_screen)
     {
-        debug_handler.post_log(__CGUI_OBF__("Full screen window is being created."), DEBUG_MODE_LOG);
+        CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("Full screen window is being created."));
         set_fullscreen_mode();
     }
     else
     {
-        debug_handler.post_log(__CGUI_OBF__("Normal window is being created."), DEBUG_MODE_LOG);
+        CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("Normal window is being created."));
         set_windowed_mode();
     }
 
@@ -206,7 +246,7 @@ bool CGUIMainWindow::initialize(std::string main_window_name_arg, bool vertical_
 
     glfwSetWindowShouldClose(main_window, GLFW_FALSE);
 
-    debug_handler.post_log(__CGUI_OBF__("Window has been created."), DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("Window has been created."));
 
     glfwSetWindowUserPointer(main_window, reinterpret_cast<void *>(this));
 
@@ -221,17 +261,9 @@ bool CGUIMainWindow::initialize(std::string main_window_name_arg, bool vertical_
     glfwSetFramebufferSizeCallback(main_window, framebuffer_size_callback);
     glfwSetWindowSizeCallback(main_window, window_size_callback);
 
-    debug_handler.post_log(__CGUI_OBF__("Callback have been initialized."), DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("Callback have been initialized."));
 
 
-    glfwMakeContextCurrent(main_window);
-
-    if (!gladLoadGL(glfwGetProcAddress))
-    {
-        debug_handler.post_log(__CGUI_OBF__("Unable to properly initialize GLAD."), DEBUG_MODE_ERROR);
-        return false;
-    }
-
     if (vertical_sync)
     {
         glfwSwapInterval(1);
@@ -241,23 +273,112 @@ bool CGUIMainWindow::initialize(std::string main_window_name_arg, bool vertical_
 }
 
 /**
- * @brief      Initializes the renderer.
+ * @brief      Submits programs of the renderer for compilation.
  *
- * @return     Status of initialization.
+ *             Has to be called right after GL is loaded, handles are resolved by initialize_renderer.
  */
-bool CGUIMainWindow::initialize_renderer()
+void CGUIMainWindow::submit_shaders()
 {
     #if defined(_WIN32) || defined(WIN32) || defined(__CYGWIN__) || defined(__MINGW32__) || defined(__BORLANDC__)
-        shaders = new CGUIShaderCompiler(CGUI_SHADER_TRIANDLE, GBG_VERT_SHADER_0, GBG_FRAG_SHADER_0, GBG_GEOM_SHADER_0);
+        shaders = new CGUIShaderCompiler();
+        triangle_shader = shaders->add_shader(CGUI_SHADER_TRIANDLE, GBG_VERT_SHADER_0, GBG_FRAG_SHADER_0, 0);
+        line_shader = shaders->add_shader(CGUI_SHADER_LINE, GBG_VERT_SHADER_1, GBG_FRAG_SHADER_1, 0);
+        layer_shader = shaders->add_shader(CGUI_SHADER_LAYER, GBG_VERT_SHADER_2, GBG_FRAG_SHADER_2, 0);
     #endif // Windows
-    #if defined(__APPLE__) || defined(__unix__) || defined(__linux__)
-        shaders = new CGUIShaderCompiler(CGUI_SHADER_TRIANDLE, triangle_vertext_file_path, triangle_fragment_file_path, triangle_geometry_file_path);
+    #if defined(__APPLE__)
+        shaders = new CGUIShaderCompiler();
+        triangle_shader = shaders->add_shader_async(CGUI_SHADER_TRIANDLE, triangle_vertext_file_path, triangle_fragment_file_path, triangle_geometry_file_path).get_handle();
+        line_shader = shaders->add_shader_async(CGUI_SHADER_LINE, line_vertext_file_path, line_fragment_file_path, fs::path(__CGUI_OBF__(""))).get_handle();
+        layer_shader = shaders->add_shader_async(CGUI_SHADER_LAYER, layer_vertext_file_path, layer_fragment_file_path, fs::path(__CGUI_OBF__(""))).get_handle();
+    #elif defined(__unix__) || defined(__linux__)
+        shaders = new CGUIShaderCompiler();
+
+        // Shaders are embedded into binary, files are only used, when they are edited with hot reload
+        const char* shader_directory = getenv(__CGUI_OBF__("CGUI_SHADER_DIRECTORY").c_str());
+        if (shader_directory != nullptr)
+        {
+            fs::path shader_path = fs::path(shader_directory);
+
+            // Readahead of every file is started before the first one is mapped
+            shaders->get_asset_loader()->prefetch({shader_path / triangle_vertext_file_path, shader_path / triangle_fragment_file_path,
+                                                   shader_path / line_vertext_file_path, shader_path / line_fragment_file_path,
+                                                   shader_path / layer_vertext_file_path, shader_path / layer_fragment_file_path});
+
+            triangle_shader = shaders->add_shader_async(CGUI_SHADER_TRIANDLE, shader_path / triangle_vertext_file_path, shader_path / triangle_fragment_file_path, fs::path(__CGUI_OBF__(""))).get_handle();
+            line_shader = shaders->add_shader_async(CGUI_SHADER_LINE, shader_path / line_vertext_file_path, shader_path / line_fragment_file_path, fs::path(__CGUI_OBF__(""))).get_handle();
+            layer_shader = shaders->add_shader_async(CGUI_SHADER_LAYER, shader_path / layer_vertext_file_path, shader_path / layer_fragment_file_path, fs::path(__CGUI_OBF__(""))).get_handle();
+        }
+        else
+        {
+            // Embedded resources can be included by embedded shaders
+            for (const CGUIEmbeddedResource& embedded_resource : CGUIEmbeddedResources::get_resources())
+            {
+                shaders->get_preprocessor()->add_include_source(std::string(embedded_resource.name), std::string(embedded_resource.data));
+            }
+
+            triangle_shader = shaders->add_shader_async(CGUI_SHADER_TRIANDLE, std::string(CGUIEmbeddedResources::get_data(triangle_vertext_file_path.string())),
+                                                        std::string(CGUIEmbeddedResources::get_data(triangle_fragment_file_path.string())), __CGUI_OBF__("NONE")).get_handle();
+            line_shader = shaders->add_shader_async(CGUI_SHADER_LINE, std::string(CGUIEmbeddedResources::get_data(line_vertext_file_path.string())),
+                                                    std::string(CGUIEmbeddedResources::get_data(line_fragment_file_path.string())), __CGUI_OBF__("NONE")).get_handle();
+            layer_shader = shaders->add_shader_async(CGUI_SHADER_LAYER, std::string(CGUIEmbeddedResources::get_data(layer_vertext_file_path.string())),
+                                                     std::string(CGUIEmbeddedResources::get_data(layer_fragment_file_path.string())), __CGUI_OBF__("NONE")).get_handle();
+        }
     #endif // Macos or linux
+}
+
+/**
+ * @brief      Initializes the renderer.
+ *
+ * @return     Status of initialization.
+ */
+bool CGUIMainWindow::initialize_renderer()
+{
+    damage_tracker = new CGUIDamageTracker();
+    uploader = new CGUIUploader(upload_window);
+    uniform_ring = new CGUIUniformRing();
+
+    line_renderer = new CGUILineRenderer(shaders->get_shader_id(line_shader), uniform_ring);
+    layer_cache = new CGUILayerCache(shaders->get_shader_id(layer_shader), uniform_ring);
+
+    // Structures, written into uniform ring, have to match std140 layout of the shaders
+    shaders->check_uniform_block(line_shader, CGUI_UNIFORM_NAME("CGUILineBlock"), sizeof(CGUILineUniforms));
+    shaders->check_uniform_block(layer_shader, CGUI_UNIFORM_NAME("CGUILayerBlock"), sizeof(CGUILayerUniforms));
+
+    // Nothing uses it yet, so it is checked without waiting
+    shaders->poll_shaders();
+
+    shader_watcher.watch_files(shaders->get_shader_files());
+    watched_files_revision = shaders->get_shader_files_revision();
+
+    // Layer textures can be redrawn at any time, so they are evicted first when texture budget is exceeded
+    layer_eviction_callback = main_memory_tracker.add_eviction_callback(CGUI_MEMORY_TEXTURE, [this](std::size_t bytes_to_free){ return layer_cache->trim(bytes_to_free); });
     // ... VBO implementation
 
     return true;
 }
 
+/**
+ * @brief      Deletes renderer objects, has to be called from render thread.
+ */
+void CGUIMainWindow::release_renderer()
+{
+    main_memory_tracker.remove_eviction_callback(layer_eviction_callback);
+
+    line_renderer->destroy();
+    layer_cache->destroy();
+    damage_tracker->destroy();
+    uniform_ring->destroy();
+
+    shaders->report_shader_stats();
+    shaders->export_shader_stats();
+
+    shaders->del_shader(triangle_shader);
+    shaders->del_shader(line_shader);
+    shaders->del_shader(layer_shader);
+
+    main_deletion_queue.flush();
+}
+
 /**
  * @brief      Updates the frame.
  */
@@ -266,8 +387,8 @@ void CGUIMainWindow::update_thread()
     // Set GLFW context to NULL in order to render window in separate thread
     glfwMakeContextCurrent(NULL);
 
+    // Render thread is joined, so renderer objects are released before window is closed
     render_thread = new std::thread(&CGUIMainWindow::frame_renderer_wrapper, this);
-    render_thread->detach();
 
     update_events();
 
@@ -288,6 +409,7 @@ void CGUIMainWindow::render_frames()
     std::chrono::time_point<std::chrono::steady_clock> last_frame_render_time_start = std::chrono::steady_clock::now();
     std::chrono::time_point<std::chrono::steady_clock> last_frame_render_time_end = std::chrono::steady_clock::now();
     size_t frame_counter = 0;
+    size_t skipped_frame_counter = 0;
 
     while(!glfwWindowShouldClose(main_window))
     {
@@ -295,6 +417,7 @@ void CGUIMainWindow::render_frames()
 
         float framebuffer_ratio;
         glm::ivec2 framebuffer_size;
+        bool frame_submitted;
 
         {
             std::unique_lock thread_lock(thread_mutex);
@@ -303,40 +426,125 @@ void CGUIMainWindow::render_frames()
                 thread_con_v.wait(thread_lock, [this]{return is_resized;});
             }
 
-            glfwGetFramebufferSize(main_window, &framebuffer_size.x, &framebuffer_size.y);
-            framebuffer_ratio = framebuffer_size.x / (float) framebuffer_size.y;
+            // Objects, released by other threads, are deleted once GPU has finished their frames
+            main_deletion_queue.retire();
 
-            glViewport(0, 0, framebuffer_size.x, framebuffer_size.y);
-            glClearColor((rand() % 100) / 100.0f, (rand() % 100) / 100.0f, (rand() % 100) / 100.0f, 1.0f);
-            glClear(GL_COLOR_BUFFER_BIT);
+            // Reloaded programs replace old ones only between frames
+            for (CGUIShaderHandle shader_handle : shaders->update_reloads())
+            {
+                if (shader_handle == line_shader)
+                {
+                    shaders->check_uniform_block(line_shader, CGUI_UNIFORM_NAME("CGUILineBlock"), sizeof(CGUILineUniforms));
+                    line_renderer->set_program(shaders->get_shader_id(line_shader));
+                }
+                else if (shader_handle == layer_shader)
+                {
+                    shaders->check_uniform_block(layer_shader, CGUI_UNIFORM_NAME("CGUILayerBlock"), sizeof(CGUILayerUniforms));
+                    layer_cache->set_program(shaders->get_shader_id(layer_shader));
+                    damage_tracker->add_full_damage();
+                }
+            }
 
-            if (vertical_sync)
+            // Includes, that were added or removed by reloads, are watched from now on
+            if (shaders->get_shader_files_revision() != watched_files_revision)
             {
-                glFinish();
+                watched_files_revision = shaders->get_shader_files_revision();
+                shader_watcher.watch_files(shaders->get_shader_files());
             }
 
-            glfwSwapBuffers(main_window);
+            // Part of the ring, written by this frame, is released by its fence
+            uniform_ring->begin_frame();
+
+            glfwGetFramebufferSize(main_window, &framebuffer_size.x, &framebuffer_size.y);
+            framebuffer_ratio = framebuffer_size.x / (float) framebuffer_size.y;
+
+            main_frame_capture.begin_frame(framebuffer_size);
+
+            // Everything, that affects the frame, should be hashed here
+            damage_tracker->begin_draw_list();
+            damage_tracker->hash_draw_value(clear_color);
+            damage_tracker->hash_draw_value(framebuffer_size);
+            damage_tracker->hash_draw_value(line_renderer->get_revision());
 
-            if (vertical_sync)
+            frame_submitted = damage_tracker->end_draw_list(framebuffer_size);
+
+            if (frame_submitted)
             {
-                glFinish();
+                layer_cache->begin_frame(framebuffer_size);
+
+                damage_tracker->bind_target();
+                glClearColor(clear_color.x, clear_color.y, clear_color.z, clear_color.w);
+
+                for (const CGUIDamageRect& damage_rect : damage_tracker->get_damage())
+                {
+                    damage_tracker->scissor(damage_rect);
+                    glClear(GL_COLOR_BUFFER_BIT);
+
+                    if (layer_cache->begin_layer(CGUI_LAYER_LINE, {0, 0}, framebuffer_size, line_renderer->get_revision()))
+                    {
+                        line_renderer->draw(framebuffer_size);
+                    }
+                    layer_cache->end_layer();
+                }
+
+                damage_tracker->present_target();
+
+                if (vertical_sync)
+                {
+                    glFinish();
+                }
+
+                glfwSwapBuffers(main_window);
+
+                if (vertical_sync)
+                {
+                    glFinish();
+                }
+                glfwPostEmptyEvent();
             }
-            glfwPostEmptyEvent();
+
+            uniform_ring->end_frame();
+            main_deletion_queue.end_frame();
+            main_frame_capture.end_frame();
 
             thread_lock.unlock();
         }
 
+        if (!frame_submitted)
+        {
+            // Nothing has changed, sleep until new damage or wake from event thread
+            if (shaders->has_pending_reloads())
+            {
+                damage_tracker->wait_for_damage(std::chrono::milliseconds(CGUI_RELOAD_POLL_INTERVAL));
+            }
+            else
+            {
+                damage_tracker->wait_for_damage();
+            }
+        }
+
         last_frame_render_time_end = std::chrono::steady_clock::now();
-        last_frame_render_time = std::chrono::duration_cast<std::chrono::milliseconds>(last_frame_render_time_end - last_frame_render_time_start).count();
+        if (frame_submitted)
+        {
+            last_frame_render_time = std::chrono::duration_cast<std::chrono::milliseconds>(last_frame_render_time_end - last_frame_render_time_start).count();
+            frame_counter++;
+        }
+        else
+        {
+            skipped_frame_counter++;
+        }
 
         if (std::chrono::duration_cast<std::chrono::milliseconds>(last_frame_render_time_end - last_second_time_interval).count() > 1000)
         {
             last_second_time_interval = last_frame_render_time_end;
             last_frames_rendered_per_second = frame_counter;
+            last_frames_skipped_per_second = skipped_frame_counter;
             frame_counter = 0;
+            skipped_frame_counter = 0;
         }
-        frame_counter++;
     }
+
+    release_renderer();
     return;
 }
 
@@ -351,7 +559,25 @@ void CGUIMainWindow::update_events()
     while (!glfwWindowShouldClose(main_window))
     {
         last_frame_event_time_start = std::chrono::steady_clock::now();
-        glfwWaitEvents();
+
+        // Watched files can not wake the event loop, so it wakes up on its own
+        if (shader_watcher.is_active())
+        {
+            glfwWaitEventsTimeout(CGUI_WATCH_INTERVAL);
+
+            for (const fs::path& changed_file : shader_watcher.poll())
+            {
+                shaders->request_reload(changed_file);
+            }
+        }
+        else
+        {
+            glfwWaitEvents();
+        }
+
+        // Events may change state, that is hashed into the draw list, or close the window
+        damage_tracker->wake();
+
         last_frame_event_time_end = std::chrono::steady_clock::now();
         last_frame_event_time = std::chrono::duration_cast<std::chrono::milliseconds>(last_frame_event_time_end - last_frame_event_time_start).count();
     }
@@ -370,7 +596,7 @@ void CGUIMainWindow::frame_renderer_wrapper()
     std::stringstream thread_id;
     thread_id << std::this_thread::get_id();
 
-    this->debug_handler.post_log(std::string(__CGUI_OBF__("Renderer wrapper has been assigned to thread: ")) + thread_id.str(), DEBUG_MODE_LOG);
+    CGUI_POST_LOG(this->debug_handler, DEBUG_MODE_LOG, std::string(__CGUI_OBF__("Renderer wrapper has been assigned to thread: ")) + thread_id.str());
 
     this->render_frames();
     return;
@@ -383,7 +609,7 @@ void CGUIMainWindow::set_fullscreen_mode()
 {
     glfwGetWindowSize(main_window, &last_window_size.x, &last_window_size.y);
     glfwGetWindowPos(main_window, &last_window_position.x, &last_window_position.y);
-    debug_handler.post_log(__CGUI_OBF__("Window mode has been set to fullscreen."), DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("Window mode has been set to fullscreen."));
     full_screen = true;
 
     current_monitor = get_monitor_by_cpos(get_global_mouse_position(main_window));
@@ -399,7 +625,7 @@ void CGUIMainWindow::set_fullscreen_mode()
 void CGUIMainWindow::set_windowed_mode()
 {
     glfwHideWindow(main_window);
-    debug_handler.post_log(__CGUI_OBF__("Window mode has been set to windowed."), DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("Window mode has been set to windowed."));
     full_screen = false;
 
     current_monitor = get_monitor_by_cpos(get_global_mouse_position(main_window));
@@ -664,7 +890,7 @@ void CGUIMainWindow::key_callback(GLFWwindow* window, int key, int scan_code, in
                 case GLFW_KEY_ESCAPE:
                 {
                     glfwSetWindowShouldClose(main_window_handler->main_window, GLFW_TRUE);
-                    main_window_handler->debug_handler.post_log("Escape has been pressed, window will be closed.", DEBUG_MODE_LOG);
+                    CGUI_POST_LOG(main_window_handler->debug_handler, DEBUG_MODE_LOG, "Escape has been pressed, window will be closed.");
                 }
                 break;
 
@@ -682,28 +908,64 @@ void CGUIMainWindow::key_callback(GLFWwindow* window, int key, int scan_code, in
                         
                         main_window_handler->debug_handler.post_log(__CGUI_OBF__(""), DEBUG_MODE_NONE);
                         main_window_handler->debug_handler.post_log("/ DEBUG INFO START", DEBUG_MODE_MESSAGE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Time passed since program started: ") + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - main_window_handler->program_start_time).count()) + __CGUI_OBF__("ms")), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Time required to process last events: ") + std::to_string(main_window_handler->last_frame_event_time) + __CGUI_OBF__("ms")), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Time required to render last frame: ") + std::to_string(main_window_handler->last_frame_render_time) + __CGUI_OBF__("ms")), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Rough estimation of fps: ") + std::to_string(1000.0f / main_window_handler->last_frame_render_time) + __CGUI_OBF__("fps")), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Real amount of fps: ") + std::to_string(main_window_handler->last_frames_rendered_per_second) + __CGUI_OBF__("fps")), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| GLFW version string: ") + std::string(glfwGetVersionString())), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Current monitor: ") + std::string(glfwGetMonitorName(main_window_handler->get_current_monitor(main_window_handler->main_window)))), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Current window position: x=") + std::to_string(window_position.x) + __CGUI_OBF__(" y=") + std::to_string(window_position.y)), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Current window size: x=") + std::to_string(window_size.x) + __CGUI_OBF__(" y=") + std::to_string(window_size.y)), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Current cursor local position: x=") + std::to_string(local_mouse_position.x) + __CGUI_OBF__(" y=") + std::to_string(local_mouse_position.y)), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Current cursor global position: x=") + std::to_string(global_mouse_position.x) + __CGUI_OBF__(" y=") + std::to_string(global_mouse_position.y)), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Current window mode: ") + std::string((main_window_handler->full_screen == true) ? __CGUI_OBF__("Fullscreen") : __CGUI_OBF__("Windowed"))), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Current window decoration: ") + std::string((glfwGetWindowAttrib(main_window_handler->main_window, GLFW_DECORATED) == true) ? __CGUI_OBF__("Decorated") : __CGUI_OBF__("Not Decorated"))), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Current window floating: ") + std::string((glfwGetWindowAttrib(main_window_handler->main_window, GLFW_FLOATING) == true) ? __CGUI_OBF__("Floating") : __CGUI_OBF__("Not Floating"))), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Current window visible: ") + std::string((glfwGetWindowAttrib(main_window_handler->main_window, GLFW_VISIBLE) == true) ? __CGUI_OBF__("Visible") : __CGUI_OBF__("Not Visible"))), DEBUG_MODE_NONE);
-                        main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("| Current window resizable: ") + std::string((glfwGetWindowAttrib(main_window_handler->main_window, GLFW_RESIZABLE) == true) ? __CGUI_OBF__("Resizable") : __CGUI_OBF__("Not Resizable"))), DEBUG_MODE_NONE);
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Time passed since program started: {}ms"), std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - main_window_handler->program_start_time).count());
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Time required to process last events: {}ms"), main_window_handler->last_frame_event_time);
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Time required to render last frame: {}ms"), main_window_handler->last_frame_render_time);
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Rough estimation of fps: {}fps"), 1000.0f / main_window_handler->last_frame_render_time);
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Real amount of fps: {}fps"), main_window_handler->last_frames_rendered_per_second);
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Skipped unchanged frames: {}fps"), main_window_handler->last_frames_skipped_per_second);
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| GLFW version string: {}"), glfwGetVersionString());
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Current monitor: {}"), glfwGetMonitorName(main_window_handler->get_current_monitor(main_window_handler->main_window)));
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Current window position: x={} y={}"), window_position.x, window_position.y);
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Current window size: x={} y={}"), window_size.x, window_size.y);
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Current cursor local position: x={} y={}"), local_mouse_position.x, local_mouse_position.y);
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Current cursor global position: x={} y={}"), global_mouse_position.x, global_mouse_position.y);
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Current window mode: {}"), (main_window_handler->full_screen == true) ? __CGUI_OBF__("Fullscreen") : __CGUI_OBF__("Windowed"));
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Current window decoration: {}"), (glfwGetWindowAttrib(main_window_handler->main_window, GLFW_DECORATED) == true) ? __CGUI_OBF__("Decorated") : __CGUI_OBF__("Not Decorated"));
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Current window floating: {}"), (glfwGetWindowAttrib(main_window_handler->main_window, GLFW_FLOATING) == true) ? __CGUI_OBF__("Floating") : __CGUI_OBF__("Not Floating"));
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Current window visible: {}"), (glfwGetWindowAttrib(main_window_handler->main_window, GLFW_VISIBLE) == true) ? __CGUI_OBF__("Visible") : __CGUI_OBF__("Not Visible"));
+                        main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| Current window resizable: {}"), (glfwGetWindowAttrib(main_window_handler->main_window, GLFW_RESIZABLE) == true) ? __CGUI_OBF__("Resizable") : __CGUI_OBF__("Not Resizable"));
+                        for (std::size_t category = 0; category < CGUI_MEMORY_CATEGORY_COUNT; ++category)
+                        {
+                            main_window_handler->debug_handler.post_format<DEBUG_MODE_NONE>(__CGUI_OBF__("| GPU memory, {}: {} objects, {} bytes"), CGUIMemoryTracker::get_category_name(category), main_memory_tracker.get_count(category), main_memory_tracker.get_total(category));
+                        }
+                        if (main_window_handler->shaders != nullptr)
+                        {
+                            // Shaders are only reloaded by render thread, while it holds the lock
+                            std::lock_guard lock_shaders(main_window_handler->thread_mutex);
+                            main_window_handler->shaders->report_shader_stats();
+                        }
                         main_window_handler->debug_handler.post_log("\\ DEBUG INFO END", DEBUG_MODE_MESSAGE);
                         main_window_handler->debug_handler.post_log(__CGUI_OBF__(""), DEBUG_MODE_NONE);
                     }
                 }
                 break;
 
+                case GLFW_KEY_P:
+                {
+                    if (mods & GLFW_MOD_CONTROL && mods & GLFW_MOD_SHIFT)
+                    {
+                        main_frame_capture.request_capture();
+                    }
+                }
+                break;
+
+                case GLFW_KEY_D:
+                {
+                    if (mods & GLFW_MOD_CONTROL && mods & GLFW_MOD_SHIFT)
+                    {
+                        if (main_flight_recorder.dump())
+                        {
+                            CGUI_POST_RECORD(main_window_handler->debug_handler, CGUI_LOG_FLIGHT_RECORD_DUMP, main_flight_recorder.get_dump_path());
+                        }
+                        else
+                        {
+                            main_window_handler->debug_handler.post_log(__CGUI_OBF__("Unable to dump flight record."), DEBUG_MODE_ERROR);
+                        }
+                    }
+                }
+                break;
+
                 case GLFW_KEY_F1:
                 {
                     if (mods & GLFW_MOD_CONTROL && mods & GLFW_MOD_SHIFT)
@@ -759,11 +1021,7 @@ void CGUIMainWindow::character_callback(GLFWwindow* window, unsigned int charact
     CGUIMainWindow* main_window_handler = reinterpret_cast<CGUIMainWindow*>(glfwGetWindowUserPointer(window));
     if (main_window_handler->character_mode)
     {
-        wchar_t* input = new wchar_t[1];
-        input[0] = character;
-        std::wstring charater(input);
-        main_window_handler->debug_handler.post_log(std::wstring(__CGUI_WOBF__(L"Character: ")) + charater, DEBUG_MODE_LOG);
-        delete [] input;
+        CGUI_POST_RECORD(main_window_handler->debug_handler, CGUI_LOG_CHARACTER, (char32_t)character);
     }
     return;
 }
@@ -1001,7 +1259,7 @@ void CGUIMainWindow::cursor_position_callback(GLFWwindow* window, double xpos, d
 void CGUIMainWindow::cursor_enter_callback(GLFWwindow* window, int entered)
 {
     CGUIMainWindow* main_window_handler = reinterpret_cast<CGUIMainWindow*>(glfwGetWindowUserPointer(window));
-    main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("Cursor enteren main window: ") + std::to_string(entered)), DEBUG_MODE_LOG);
+    CGUI_POST_RECORD(main_window_handler->debug_handler, CGUI_LOG_CURSOR_ENTER, entered);
     return;
 }
 
@@ -1033,7 +1291,7 @@ void CGUIMainWindow::mouse_button_callback(GLFWwindow* window, int button, int a
                     glfwGetCursorPos(window, &new_mouse_press_position.x, &new_mouse_press_position.y);
                     main_window_handler->last_mouse_press_position = new_mouse_press_position;
 
-                    main_window_handler->debug_handler.post_log(__CGUI_OBF__("Left button has been pressed."), DEBUG_MODE_LOG);
+                    CGUI_POST_RECORD(main_window_handler->debug_handler, CGUI_LOG_LEFT_BUTTON_PRESS);
                 }
                 break;
 
@@ -1052,7 +1310,7 @@ void CGUIMainWindow::mouse_button_callback(GLFWwindow* window, int button, int a
                 case GLFW_MOUSE_BUTTON_LEFT:
                 {
                     main_window_handler->mouse_lb_pressed = false;
-                    main_window_handler->debug_handler.post_log(std::string("The left button was released, it was held: " + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - main_window_handler->last_lb_press_time).count()) + __CGUI_OBF__("ms")), DEBUG_MODE_LOG);
+                    CGUI_POST_RECORD(main_window_handler->debug_handler, CGUI_LOG_LEFT_BUTTON_RELEASE, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - main_window_handler->last_lb_press_time).count());
                 }
                 break;
 
@@ -1066,7 +1324,7 @@ void CGUIMainWindow::mouse_button_callback(GLFWwindow* window, int button, int a
 
         default:
         {
-            main_window_handler->debug_handler.post_log(__CGUI_OBF__("Invalid key callback action: ") + std::to_string(action), DEBUG_MODE_ERROR);
+            CGUI_POST_RECORD(main_window_handler->debug_handler, CGUI_LOG_MOUSE_ACTION_INVALID, action);
             return;
         }
     }
@@ -1083,7 +1341,7 @@ void CGUIMainWindow::mouse_button_callback(GLFWwindow* window, int button, int a
 void CGUIMainWindow::scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
     CGUIMainWindow* main_window_handler = reinterpret_cast<CGUIMainWindow*>(glfwGetWindowUserPointer(window));
-    main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("Scroll event main window: ") + std::to_string(xoffset) + std::string(__CGUI_OBF__(" ")) + std::to_string(yoffset)), DEBUG_MODE_LOG);
+    CGUI_POST_RECORD(main_window_handler->debug_handler, CGUI_LOG_SCROLL, xoffset, yoffset);
     return;
 }
 
@@ -1104,6 +1362,7 @@ void CGUIMainWindow::framebuffer_size_callback(GLFWwindow* window, int width, in
 
         //main_window_handler->debug_handler.post_log(std::string(__CGUI_OBF__("Framebuffer size changed main window: ") + std::to_string(width) + std::string(__CGUI_OBF__("x")) + std::to_string(height)), DEBUG_MODE_LOG);
         glViewport(0, 0, width, height);
+        main_window_handler->damage_tracker->add_full_damage();
 
         main_window_handler->is_resized = true;
     }
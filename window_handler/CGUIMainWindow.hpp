@@ -34,8 +34,12 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "debug_handler/CGUIDebugHandler.hpp"
+#include "memory_tracker/CGUIMemoryTracker.hpp"
 #include "shader_compiler/CGUIShaderCompiler.hpp"
 #include "object_renderer/CGUIObjectRenderer.hpp"
+#include "frame_capture/CGUIFrameCapture.hpp"
+#include "file_watcher/CGUIFileWatcher.hpp"
+#include "embedded_resources/CGUIEmbeddedResources.hpp"
 
 #include <sys/stat.h>
 #include <chrono>
@@ -48,6 +52,13 @@
  * Some useful defines for shader compiler.
  */
 #define CGUI_SHADER_TRIANDLE __CGUI_OBF__("CGUI_SHADER_TRIANDLE")
+#define CGUI_SHADER_LINE     __CGUI_OBF__("CGUI_SHADER_LINE")
+#define CGUI_SHADER_LAYER    __CGUI_OBF__("CGUI_SHADER_LAYER")
+
+/**
+ * Some useful defines for layer cache.
+ */
+#define CGUI_LAYER_LINE 1
 
 /**
  * Some useful defines for window press type.
@@ -83,6 +94,8 @@ public:
 private:
     bool initialize(std::string main_window_name_arg = __CGUI_OBF__("CGUI Default Window"), bool vertical_sync_arg = false, bool full_screen_arg = false);
     bool initialize_renderer();
+    void submit_shaders();
+    void release_renderer();
 
     void update_thread();
     void render_frames();
@@ -118,13 +131,34 @@ private:
     static void window_size_callback(GLFWwindow* window, int width, int height);
 
 private:
-    CGUIDebugHandler debug_handler;
+    CGUIDebugHandler debug_handler = CGUIDebugHandler(false);
 
     GLFWwindow*     main_window;
+    GLFWwindow*     upload_window;
     GLFWmonitor*    current_monitor;
     GLFWcursor*     current_cursor;
 
-    CGUIShaderCompiler* shaders;
+    CGUIShaderCompiler* shaders = nullptr;
+    CGUILineRenderer*   line_renderer;
+    CGUIDamageTracker*  damage_tracker;
+    CGUILayerCache*     layer_cache;
+    CGUIUploader*       uploader = nullptr;
+    CGUIUniformRing*    uniform_ring;
+
+    /**
+     * Shader names are only used, when shaders are added.
+     */
+    CGUIShaderHandle triangle_shader;
+    CGUIShaderHandle line_shader;
+    CGUIShaderHandle layer_shader;
+
+    std::size_t layer_eviction_callback = 0;
+
+    /**
+     * Shader files are watched by event thread, programs are swapped by render thread.
+     */
+    CGUIFileWatcher shader_watcher;
+    uint64_t        watched_files_revision = 0;
 
 private:
     std::string main_window_name;
@@ -142,6 +176,9 @@ private:
     size_t last_frame_render_time           = 0;
     size_t last_frame_event_time            = 0;
     size_t last_frames_rendered_per_second  = 0;
+    size_t last_frames_skipped_per_second   = 0;
+
+    glm::fvec4 clear_color = {0.0f, 0.0f, 0.0f, 1.0f};
 
     size_t  window_drag_offset  = 10;
     uint8_t window_press_type   = 0;
@@ -156,12 +193,27 @@ private:
         fs::path triangle_vertext_file_path     = __CGUI_OBF__("cgui_tri_vert.vs");
         fs::path triangle_fragment_file_path    = __CGUI_OBF__("cgui_tri_frag.fs");
         fs::path triangle_geometry_file_path    = __CGUI_OBF__("");
+
+        fs::path line_vertext_file_path         = __CGUI_OBF__("cgui_line_vert.vs");
+        fs::path line_fragment_file_path        = __CGUI_OBF__("cgui_line_frag.fs");
+
+        fs::path layer_vertext_file_path        = __CGUI_OBF__("cgui_layer_vert.vs");
+        fs::path layer_fragment_file_path       = __CGUI_OBF__("cgui_layer_frag.fs");
     #endif
 
     #if defined(__unix__) || defined(__linux__)
-        fs::path triangle_vertext_file_path     = __CGUI_OBF__("/usr/share/glfw-based-gui/resources/cgui_tri_vert.vs");
-        fs::path triangle_fragment_file_path    = __CGUI_OBF__("/usr/share/glfw-based-gui/resources/cgui_tri_frag.fs");
+        /**
+         * Names of embedded resources, also relative to CGUI_SHADER_DIRECTORY, when it is set.
+         */
+        fs::path triangle_vertext_file_path     = __CGUI_OBF__("cgui_tri_vert.vs");
+        fs::path triangle_fragment_file_path    = __CGUI_OBF__("cgui_tri_frag.fs");
         fs::path triangle_geometry_file_path    = __CGUI_OBF__("");
+
+        fs::path line_vertext_file_path         = __CGUI_OBF__("cgui_line_vert.vs");
+        fs::path line_fragment_file_path        = __CGUI_OBF__("cgui_line_frag.fs");
+
+        fs::path layer_vertext_file_path        = __CGUI_OBF__("cgui_layer_vert.vs");
+        fs::path layer_fragment_file_path       = __CGUI_OBF__("cgui_layer_frag.fs");
     #endif
 
     std::thread* render_thread;
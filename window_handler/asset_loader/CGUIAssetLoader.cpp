@@ -0,0 +1,284 @@
+/**
+ * @file       <CGUIAssetLoader.cpp>
+ * @brief      This source file implements CGUIAssetLoader class.
+ *
+ *             It is being used in order to load asset files without copying them,
+ *             they are mapped into memory and read at disk speed.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUIAssetLoader.hpp"
+
+#if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cerrno>
+#else
+    #include <fstream>
+    #include <iterator>
+#endif // POSIX
+
+#include <utility>
+
+/**
+ * @brief      Constructs a closed file.
+ */
+CGUIMappedFile::CGUIMappedFile()
+{
+}
+
+/**
+ * @brief      Takes mapping of other file.
+ *
+ * @param      other_file  The other file, it becomes closed.
+ */
+CGUIMappedFile::CGUIMappedFile(CGUIMappedFile&& other_file) noexcept
+{
+    *this = std::move(other_file);
+}
+
+/**
+ * @brief      Unmaps the file.
+ */
+CGUIMappedFile::~CGUIMappedFile()
+{
+    close();
+}
+
+/**
+ * @brief      Takes mapping of other file, own mapping is released.
+ *
+ * @param      other_file  The other file, it becomes closed.
+ *
+ * @return     This file.
+ */
+CGUIMappedFile& CGUIMappedFile::operator=(CGUIMappedFile&& other_file) noexcept
+{
+    if (this != &other_file)
+    {
+        close();
+
+        #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+            file_data = other_file.file_data;
+        #else
+            file_buffer = std::move(other_file.file_buffer);
+            file_data = file_buffer.data();
+        #endif // POSIX
+
+        file_size = other_file.file_size;
+        file_opened = other_file.file_opened;
+
+        other_file.file_data = nullptr;
+        other_file.file_size = 0;
+        other_file.file_opened = false;
+    }
+
+    return *this;
+}
+
+/**
+ * @brief      Maps whole file for sequential reading.
+ *
+ * @param[in]  file_path  Path of the file.
+ *
+ * @return     False if file can not be opened or mapped, errno is kept.
+ */
+bool CGUIMappedFile::open(const fs::path& file_path)
+{
+    close();
+
+    #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+        int file_descriptor = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file_descriptor == -1)
+        {
+            return false;
+        }
+
+        struct stat file_status;
+        if (fstat(file_descriptor, &file_status) == -1)
+        {
+            ::close(file_descriptor);
+            return false;
+        }
+
+        // Empty file can not be mapped, but it is a valid asset
+        file_size = (std::size_t)file_status.st_size;
+        if (file_size != 0)
+        {
+            void* mapped_data = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+            if (mapped_data == MAP_FAILED)
+            {
+                ::close(file_descriptor);
+                file_size = 0;
+                return false;
+            }
+
+            // Advices are not flags, so they are given one by one
+            madvise(mapped_data, file_size, MADV_SEQUENTIAL);
+            madvise(mapped_data, file_size, MADV_WILLNEED);
+            file_data = static_cast<const char*>(mapped_data);
+        }
+
+        // Mapping keeps its own reference to the file
+        ::close(file_descriptor);
+    #else
+        std::ifstream asset_file(file_path, std::ios::binary);
+        if (!asset_file.is_open())
+        {
+            return false;
+        }
+
+        file_buffer.assign(std::istreambuf_iterator<char>(asset_file), std::istreambuf_iterator<char>());
+        file_data = file_buffer.data();
+        file_size = file_buffer.size();
+    #endif // POSIX
+
+    file_opened = true;
+    return true;
+}
+
+/**
+ * @brief      Unmaps the file, view becomes invalid.
+ */
+void CGUIMappedFile::close()
+{
+    #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+        if (file_data != nullptr)
+        {
+            munmap(const_cast<char*>(file_data), file_size);
+        }
+    #else
+        file_buffer.clear();
+    #endif // POSIX
+
+    file_data = nullptr;
+    file_size = 0;
+    file_opened = false;
+}
+
+/**
+ * @brief      Checks whether file is opened.
+ *
+ * @return     True if view is valid.
+ */
+bool CGUIMappedFile::is_open() const
+{
+    return file_opened;
+}
+
+/**
+ * @brief      Gets contents of the file.
+ *
+ * @return     View of the whole file, empty if file is closed.
+ */
+std::string_view CGUIMappedFile::get_view() const
+{
+    return std::string_view(file_data, file_size);
+}
+
+/**
+ * @brief      Constructs asset loader.
+ */
+CGUIAssetLoader::CGUIAssetLoader()
+{
+    debug_handler = CGUIDebugHandler(main_debug_handler);
+}
+
+/**
+ * @brief      Destroys asset loader.
+ */
+CGUIAssetLoader::~CGUIAssetLoader()
+{
+    prefetched_files.clear();
+}
+
+/**
+ * @brief      Maps asset file, prefetched mapping is taken without opening file again.
+ *
+ * @param[in]  file_path  Path of the file.
+ *
+ * @return     Mapped file, closed if it can not be opened.
+ */
+CGUIMappedFile CGUIAssetLoader::load(const fs::path& file_path)
+{
+    CGUIMappedFile mapped_file;
+    {
+        std::error_code path_error;
+        std::lock_guard prefetch_lock(prefetch_mutex);
+
+        auto file_iterator = prefetched_files.find(fs::absolute(file_path, path_error).lexically_normal().string());
+        if (file_iterator != prefetched_files.end())
+        {
+            // Later loads of the file read it again, since it might have been changed
+            mapped_file = std::move(file_iterator->second);
+            prefetched_files.erase(file_iterator);
+            return mapped_file;
+        }
+    }
+
+    if (!mapped_file.open(file_path))
+    {
+        #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+            debug_handler.post_log(std::string("Unable to map asset file: ") + file_path.string() + " Error code: " + std::to_string(errno), DEBUG_MODE_ERROR);
+        #else
+            debug_handler.post_log(std::string("Unable to read asset file: ") + file_path.string(), DEBUG_MODE_ERROR);
+        #endif // POSIX
+    }
+
+    return mapped_file;
+}
+
+/**
+ * @brief      Maps files and starts their readahead without waiting for it.
+ *
+ *             Mappings are kept, so loading the files later neither opens them again,
+ *             nor touches disk.
+ *
+ * @param[in]  file_paths  Paths of the files.
+ *
+ * @return     Amount of files, whose readahead was started.
+ */
+std::size_t CGUIAssetLoader::prefetch(const std::vector<fs::path>& file_paths)
+{
+    std::size_t prefetched_count = 0;
+
+    #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+        for (const fs::path& file_path : file_paths)
+        {
+            // Mapping is already advised with MADV_WILLNEED by open
+            CGUIMappedFile mapped_file;
+            if (!mapped_file.open(file_path))
+            {
+                debug_handler.post_log(std::string("Unable to prefetch asset file: ") + file_path.string(), DEBUG_MODE_WARNING);
+                continue;
+            }
+
+            std::error_code path_error;
+            std::lock_guard prefetch_lock(prefetch_mutex);
+            prefetched_files[fs::absolute(file_path, path_error).lexically_normal().string()] = std::move(mapped_file);
+
+            ++prefetched_count;
+        }
+    #else
+        debug_handler.post_log(std::string("Asset prefetch is not supported on this platform, files: ") + std::to_string(file_paths.size()), DEBUG_MODE_WARNING);
+    #endif // POSIX
+
+    return prefetched_count;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file       <CGUIAssetLoader.hpp>
+ * @brief      This header file implements CGUIAssetLoader class.
+ *
+ *             It is being used in order to load asset files without copying them,
+ *             they are mapped into memory and read at disk speed.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUIASSETLOADER_HPP
+#define CGUIASSETLOADER_HPP
+
+#include "../debug_handler/CGUIDebugHandler.hpp"
+
+#include <unordered_map>
+#include <string_view>
+#include <cstddef>
+#include <vector>
+#include <string>
+#include <mutex>
+
+/**
+ * @brief      This class implements read-only view of whole file.
+ *
+ *             On POSIX file is mapped, so its pages are shared with page cache and are
+ *             never copied. On other platforms file is read into buffer once. View is
+ *             not terminated by zero, its length has to be passed along with it.
+ */
+class CGUIMappedFile
+{
+public:
+    CGUIMappedFile();
+    CGUIMappedFile(const CGUIMappedFile&) = delete;
+    CGUIMappedFile(CGUIMappedFile&& other_file) noexcept;
+    ~CGUIMappedFile();
+
+    CGUIMappedFile& operator=(const CGUIMappedFile&) = delete;
+    CGUIMappedFile& operator=(CGUIMappedFile&& other_file) noexcept;
+
+    bool open(const fs::path& file_path);
+    void close();
+
+    bool is_open() const;
+    std::string_view get_view() const;
+
+private:
+    const char* file_data   = nullptr;
+    std::size_t file_size   = 0;
+    bool        file_opened = false;
+
+    #if !defined(__unix__) && !defined(__linux__) && !defined(__APPLE__)
+        std::string file_buffer;
+    #endif // Not POSIX
+};
+
+/**
+ * @brief      This class implements loading of asset files.
+ *
+ *             Loaded files are mapped for sequential reading, prefetch maps files,
+ *             that would be loaded soon, and starts their asynchronous readahead.
+ *             Prefetched mapping is kept until the file is loaded once.
+ */
+class CGUIAssetLoader
+{
+public:
+    CGUIAssetLoader();
+    CGUIAssetLoader(const CGUIAssetLoader&) = delete;
+    ~CGUIAssetLoader();
+
+    CGUIMappedFile load(const fs::path& file_path);
+    std::size_t prefetch(const std::vector<fs::path>& file_paths);
+
+private:
+    /**
+     * Prefetched mappings by normalized absolute path.
+     */
+    std::unordered_map<std::string, CGUIMappedFile> prefetched_files;
+    std::mutex                                      prefetch_mutex;
+
+    CGUIDebugHandler debug_handler = CGUIDebugHandler(false);
+};
+
+#endif // CGUIASSETLOADER_HPP
@@ -55,6 +55,20 @@ CGUIDebugHandler::CGUIDebugHandler(bool clear_base_dir, std::string full_file_pa
         #endif // Unix
 
         debug_file_path += fs::path(__CGUI_OBF__("/log/debug_log_default.log"));
+
+        // Structured records are kept binary, cgui_logdump renders them
+        const char* binary_log = getenv(__CGUI_OBF__("CGUI_LOG_BINARY").c_str());
+        if (binary_log != nullptr && std::string(binary_log) != "0")
+        {
+            debug_file_path.replace_extension(__CGUI_OBF__(".cgl"));
+        }
+
+        // Runtime level, mode above compiled level has no effect
+        const char* log_level_name = getenv(__CGUI_OBF__("CGUI_LOG_LEVEL").c_str());
+        if (log_level_name != nullptr)
+        {
+            set_log_level((std::size_t)std::strtoul(log_level_name, nullptr, 10));
+        }
     }
 
     fs::create_directories(debug_file_path.parent_path());
@@ -64,22 +78,7 @@ CGUIDebugHandler::CGUIDebugHandler(bool clear_base_dir, std::string full_file_pa
         clear_log(debug_file_path);
     }
 
-    struct stat debug_buffer;
-    if (stat(debug_file_path.string().c_str(), &debug_buffer) != 0)
-    {
-
-        debug_file_out.open(debug_file_path.string().c_str(), std::ios::out | std::ios::app);
-        if (!debug_file_out.good())
-        {
-            std::cerr << __CGUI_OBF__("Unable to initialize debug handler with this name : ") << debug_file_path;
-        }
-        else
-        {
-            debug_disabled = false;
-            debug_file_out << "[LOADER DEBUG LOG]" << "\n";
-            debug_file_out.close();
-        }
-    }
+    open_log();
 }
 
 /**
@@ -91,114 +90,98 @@ CGUIDebugHandler::CGUIDebugHandler(const CGUIDebugHandler& debug_handler)
 {
     debug_file_path = debug_handler.debug_file_path;
     debug_disabled = debug_handler.debug_disabled;
-    struct stat debug_buffer;
-    if (stat(debug_file_path.string().c_str(), &debug_buffer) != 0)
-    {
-
-        debug_file_out.open(debug_file_path.string().c_str(), std::ios::out | std::ios::app);
-        if (!debug_file_out.good())
-        {
-            std::cerr << __CGUI_OBF__("Unable to initialize debug handler with this name : ") << debug_file_path;
-        }
-        else
-        {
-            debug_disabled = false;
-            debug_file_out << "[LOADER DEBUG LOG]" << "\n";
-            debug_file_out.close();
-        }
-    }
+    log_writer = debug_handler.log_writer;
+    open_log();
 }
 
 /**
- * @brief      Destructs debug handler instance.
+ * @brief      Destructs debug handler instance, writer is stopped with the last copy.
  */
 CGUIDebugHandler::~CGUIDebugHandler()
 {
-    if (debug_file_out.is_open())
-    {
-        debug_file_out.close();
-    }
+    log_writer.reset();
 }
 
 /**
- * @brief      Posts a log into file in string mode.
+ * @brief      Posts UTF-8 log into file.
  *
- * @param[in]  message  Message to post.
- * @param[in]  mode     Prefix that would be posted before message.
- */
-void CGUIDebugHandler::post_log(std::string message, size_t mode)
-{
-    post_log(str_to_wstr(message), mode);
-}
-
-/**
- * @brief      Posts a log into file in wstring mode.
+ *             Message is only copied into the ring, short messages are kept inside
+ *             of the record, formatting and writing is done by writer thread, so it
+ *             can be called from render thread. Flight recorder keeps the record,
+ *             even if runtime level does not let it into file.
  *
  * @param[in]  message  Message to post.
  * @param[in]  mode     Prefix that would be posted before message.
  */
-void CGUIDebugHandler::post_log(std::wstring message, size_t mode)
+void CGUIDebugHandler::post_log(std::string_view message, size_t mode)
 {
-    if (debug_disabled)
+    bool log_written = is_enabled(mode) && log_writer != nullptr;
+    bool log_recorded = is_recorded(mode);
+    if (!log_written && !log_recorded)
     {
         return;
     }
 
-    std::wstring error_tag;
-    switch (mode)
+    if (log_written && mode == DEBUG_MODE_ERROR)
     {
-        case DEBUG_MODE_ERROR:
-        {
-            error_tag = __CGUI_WOBF__(L"[ERROR]");
-            std::wcerr << message << std::endl;
-        }
-        break;
+        std::cerr << message << std::endl;
+    }
 
-        case DEBUG_MODE_WARNING:
-        {
-            error_tag = __CGUI_WOBF__(L"[WARNING]");
-        }
-        break;
+    CGUILogRecord log_record;
+    log_record.post_time = CGUILogClock::now();
+    log_record.mode = mode;
 
-        case DEBUG_MODE_MESSAGE:
-        {
-            error_tag = __CGUI_WOBF__(L"[MESSAGE]");
-        }
-        break;
-
-        case DEBUG_MODE_LOG:
-        {
-            error_tag = __CGUI_WOBF__(L"[LOG]");
-        }
-        break;
+    if (message.size() + 1 + sizeof(uint32_t) <= CGUI_LOG_PAYLOAD_SIZE)
+    {
+        log_record.argument_count = 1;
+        cgui_log_encode(log_record.payload.data(), log_record.payload_size, CGUI_LOG_PAYLOAD_SIZE, message);
+    }
+    else
+    {
+        log_record.message.assign(message);
+    }
 
-        case DEBUG_MODE_GLFW_CALLBACK:
-        {
-            error_tag = __CGUI_WOBF__(L"[GLFW]");
-        }
-        break;
+    if (log_recorded)
+    {
+        main_flight_recorder.record(log_record);
+    }
 
-        case DEBUG_MODE_NONE:
-        {
-            error_tag = __CGUI_WOBF__(L"");
-        }
-        break;
+    if (log_written)
+    {
+        log_writer->post(std::move(log_record));
+    }
+}
 
-        default:
-        {
-            error_tag = __CGUI_WOBF__(L"[UNDEFINED]");
-        }
-        break;
+/**
+ * @brief      Posts wide log, it is converted to UTF-8.
+ *
+ * @param[in]  message  Message to post.
+ * @param[in]  mode     Prefix that would be posted before message.
+ */
+void CGUIDebugHandler::post_log(std::wstring_view message, size_t mode)
+{
+    if (!is_enabled(mode) && !is_recorded(mode))
+    {
+        return;
     }
 
-    std::time_t time_current = std::time(0);
-    std::tm* time_struct = std::localtime(&time_current);
+    static thread_local std::string message_buffer;
+    message_buffer.clear();
+    wstr_to_str(message, message_buffer);
 
-    debug_file_out.open(debug_file_path.string().c_str(), std::ios::out | std::ios::app);
-    debug_file_out << std::setw(24) << std::left << str_to_wstr(__CGUI_OBF__("[") + fill_zeros(time_struct->tm_year + 1900, 4) + __CGUI_OBF__("-") + fill_zeros(time_struct->tm_mon + 1, 2) + __CGUI_OBF__("-") +  fill_zeros(time_struct->tm_mday, 2) + __CGUI_OBF__("-") + fill_zeros(time_struct->tm_hour, 2) + __CGUI_OBF__("-") + fill_zeros(time_struct->tm_min, 2) + __CGUI_OBF__("-") +  fill_zeros(time_struct->tm_sec, 2) + __CGUI_OBF__("]")) << std::setw(14) << std::left << error_tag << __CGUI_WOBF__(L" ") << message << L"\n";
-    debug_file_out.close();
+    post_log(std::string_view(message_buffer), mode);
 }
 
+/**
+ * @brief      Waits until every posted log is written to disk.
+ */
+void CGUIDebugHandler::flush()
+{
+    if (log_writer != nullptr)
+    {
+        log_writer->flush();
+    }
+}
 
 /**
  * @brief      Posts GLFW error into log file.
@@ -287,6 +270,28 @@ void CGUIDebugHandler::glfw_error_callback(int error, const char* description)
     main_debug_handler.post_log(formated_error.str(), 4);
 }
 
+/**
+ * @brief      Gets path of the log file.
+ *
+ * @return     Path of the active log file.
+ */
+fs::path CGUIDebugHandler::get_log_path() const
+{
+    return debug_file_path;
+}
+
+/**
+ * @brief      Sets most verbose mode, that is written by all handlers.
+ *
+ *             Modes above CGUI_LOG_LEVEL stay compiled out whatever is set here.
+ *
+ * @param[in]  mode  The mode, one of DEBUG_MODE_*.
+ */
+void CGUIDebugHandler::set_log_level(std::size_t mode)
+{
+    log_level.store(mode, std::memory_order_relaxed);
+}
+
 CGUIDebugHandler& CGUIDebugHandler::operator=(CGUIDebugHandler&& debug_handler)
 {
     this->~CGUIDebugHandler();
@@ -300,47 +305,109 @@ CGUIDebugHandler& CGUIDebugHandler::operator=(CGUIDebugHandler&& debug_handler)
 /**
  * @brief      Clears debug log folder.
  *
+ *             Files of running writers are kept, other handlers still write them.
+ *
  * @param[in]  log_file_directory  The log file directory.
  */
 void CGUIDebugHandler::clear_log(fs::path log_file_directory)
 {
+    std::lock_guard writers_lock(log_writers_mutex);
+
     for (const auto &file : fs::directory_iterator(log_file_directory.parent_path()))
     {
-        if (file.path().string().find(__CGUI_OBF__("debug_log_")) != std::string::npos)
+        if (file.path().string().find(__CGUI_OBF__("debug_log_")) == std::string::npos)
+        {
+            continue;
+        }
+
+        // Rotated segments of running writer start with its name as well
+        bool file_written = false;
+        for (const auto& [writer_path, writer] : log_writers)
+        {
+            if (!writer.expired() && writer_path.parent_path() == file.path().parent_path() &&
+                file.path().filename().string().starts_with(writer_path.stem().string()))
+            {
+                file_written = true;
+                break;
+            }
+        }
+
+        if (!file_written)
         {
-            fs::remove(file.path());
+            std::error_code file_error;
+            fs::remove(file.path(), file_error);
         }
     }
 }
 
 /**
- * @brief      Fills number with leading zeros for offset.
- *
- * @param[in]  input_num   Input number.
- * @param[in]  num_offset  Number of symbols to offset.
+ * @brief      Joins running writer of the log file or starts new one.
+ */
+void CGUIDebugHandler::open_log()
+{
+    if (log_writer == nullptr)
+    {
+        std::lock_guard writers_lock(log_writers_mutex);
+
+        std::weak_ptr<CGUILogWriter>& shared_writer = log_writers[debug_file_path];
+        log_writer = shared_writer.lock();
+
+        if (log_writer == nullptr)
+        {
+            log_writer = std::make_shared<CGUILogWriter>();
+            if (!log_writer->open(debug_file_path, __CGUI_OBF__("[LOADER DEBUG LOG]\n"), debug_file_path.extension() == __CGUI_OBF__(".cgl")))
+            {
+                std::cerr << __CGUI_OBF__("Unable to initialize debug handler with this name : ") << debug_file_path;
+                log_writer.reset();
+            }
+            shared_writer = log_writer;
+        }
+    }
+
+    debug_disabled = (log_writer == nullptr);
+}
+
+/**
+ * @brief      Prints structured error record to error stream.
  *
- * @return     Number filled with leading zeros.
+ * @param[in]  log_record  The record.
  */
-std::string CGUIDebugHandler::fill_zeros(int input_num, int num_offset)
+void CGUIDebugHandler::echo_record(const CGUILogRecord& log_record)
 {
-    std::stringstream converted_number;
-    converted_number << std::setw(num_offset) << std::setfill('0') << input_num;
-    return converted_number.str();
+    std::string message;
+    CGUILogWriter::render_message(log_record, message);
+    std::cerr << message << std::endl;
 }
 
 /**
- * @brief      Converts string to wstring.
+ * @brief      Converts wide string to UTF-8, it does not depend on locale.
  *
- * @param[in]  message  Initial message.
+ *             Wide strings are UTF-16 on Windows and UTF-32 elsewhere.
  *
- * @return     Converted message.
+ * @param[in]  message  Initial message.
+ * @param      output   Converted message is appended to it.
  */
-std::wstring CGUIDebugHandler::str_to_wstr(std::string message)
+void CGUIDebugHandler::wstr_to_str(std::wstring_view message, std::string& output)
 {
-    //std::wstring message_wstr(message.begin(), message.end());
-    std::wstring message_wstr;
-	message_wstr.resize(message.length());
-	std::mbstowcs(&message_wstr[0], message.c_str(), message.size());
+    output.reserve(output.size() + message.size());
+
+    for (std::size_t char_index = 0; char_index < message.size(); ++char_index)
+    {
+        uint32_t code_point = (uint32_t)message[char_index];
 
-	return message_wstr;
+        if constexpr (sizeof(wchar_t) == 2)
+        {
+            if (code_point >= 0xD800 && code_point <= 0xDBFF && char_index + 1 < message.size())
+            {
+                uint32_t low_surrogate = (uint32_t)message[char_index + 1];
+                if (low_surrogate >= 0xDC00 && low_surrogate <= 0xDFFF)
+                {
+                    code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low_surrogate - 0xDC00);
+                    ++char_index;
+                }
+            }
+        }
+
+        cgui_log_append_utf8(output, code_point);
+    }
 }
@@ -26,14 +26,9 @@
 #define CGUIDEBUGHANDLER_HPP
 
 /**
- * CGUI log prefix list
+ * CGUI log prefix list and structured messages.
  */
-#define DEBUG_MODE_ERROR            0 
-#define DEBUG_MODE_WARNING          1
-#define DEBUG_MODE_MESSAGE          2
-#define DEBUG_MODE_LOG              3
-#define DEBUG_MODE_GLFW_CALLBACK    4
-#define DEBUG_MODE_NONE             255
+#include "CGUILogFormat.hpp"
 
 /**
  * GLFW callback codes.
@@ -53,6 +48,7 @@
 
 // Headers for string alignment and stuff
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <iomanip>
 #include <iostream>
@@ -66,7 +62,14 @@
 // Headers for time 
 #include <ctime>
 
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <map>
+
 #include "../protection/CGUIProtection.hpp"
+#include "CGUILogWriter.hpp"
+#include "CGUIFlightRecorder.hpp"
 
 #ifdef __APPLE__
     //#include <CoreFoundation/CoreFoundation.h>
@@ -91,28 +94,201 @@ public:
     CGUIDebugHandler(const CGUIDebugHandler&);
     ~CGUIDebugHandler();
 
-    void post_log(std::string message, size_t mode = DEBUG_MODE_NONE);
-    void post_log(std::wstring message, size_t mode = DEBUG_MODE_NONE);
+    void post_log(std::string_view message, size_t mode = DEBUG_MODE_NONE);
+    void post_log(std::wstring_view message, size_t mode = DEBUG_MODE_NONE);
+    template <std::size_t mode, typename... Arguments>
+    void post_format(std::string_view format, const Arguments&... arguments);
+    template <CGUILogMessage message_id, typename... Arguments>
+    void post_record(const Arguments&... arguments);
+    void flush();
+    bool is_enabled(std::size_t mode) const;
+    bool is_recorded(std::size_t mode) const;
+    fs::path get_log_path() const;
+    static void set_log_level(std::size_t mode);
     static void glfw_error_callback(int error, const char* description);
 
     CGUIDebugHandler& operator=(CGUIDebugHandler&& debug_handler);
 
 private:
     void clear_log(fs::path log_file_directory = __CGUI_OBF__(""));
+    void open_log();
+    void echo_record(const CGUILogRecord& log_record);
 
-    std::string fill_zeros(int input_num, int num_offset);
-
-    std::wstring str_to_wstr(std::string message);
+    static void wstr_to_str(std::wstring_view message, std::string& output);
 
 private: 
     fs::path debug_file_path;
 
-    std::wofstream debug_file_out;
+    /**
+     * Writer is shared by every handler of the same file, the last one stops it.
+     */
+    std::shared_ptr<CGUILogWriter> log_writer;
 
     bool debug_disabled = true;
+
+    /**
+     * Runtime level is shared by all handlers, it can only narrow CGUI_LOG_LEVEL.
+     */
+    static inline std::atomic<std::size_t> log_level = CGUI_LOG_LEVEL;
+
+    /**
+     * Running writers by their file, so second handler of a file neither opens nor removes it.
+     */
+    static inline std::mutex log_writers_mutex;
+    static inline std::map<fs::path, std::weak_ptr<CGUILogWriter>> log_writers;
     
 };
 
 extern CGUIDebugHandler main_debug_handler;
 
+/**
+ * Level gated logging, arguments are only evaluated, if mode is compiled in and enabled,
+ * so filtered out logs cost nothing but a branch.
+ */
+#define CGUI_POST_LOG(handler, mode, ...) \
+    do \
+    { \
+        if constexpr (cgui_log_compiled(mode)) \
+        { \
+            if ((handler).is_enabled(mode) || (handler).is_recorded(mode)) \
+            { \
+                (handler).post_log(__VA_ARGS__, mode); \
+            } \
+        } \
+    } while (false)
+
+#define CGUI_POST_FORMAT(handler, mode, ...) \
+    do \
+    { \
+        if constexpr (cgui_log_compiled(mode)) \
+        { \
+            if ((handler).is_enabled(mode) || (handler).is_recorded(mode)) \
+            { \
+                (handler).post_format<mode>(__VA_ARGS__); \
+            } \
+        } \
+    } while (false)
+
+#define CGUI_POST_RECORD(handler, message_id, ...) \
+    do \
+    { \
+        if constexpr (cgui_log_compiled(cgui_log_message_mode(message_id))) \
+        { \
+            if ((handler).is_enabled(cgui_log_message_mode(message_id)) || (handler).is_recorded(cgui_log_message_mode(message_id))) \
+            { \
+                (handler).post_record<message_id>(__VA_ARGS__); \
+            } \
+        } \
+    } while (false)
+
+/**
+ * @brief      Checks, whether logs of the mode are going to be written.
+ *
+ *             It is cheap enough to be called before message is built.
+ *
+ * @param[in]  mode  The mode.
+ *
+ * @return     True if handler is open and mode passes compiled and runtime level.
+ */
+inline bool CGUIDebugHandler::is_enabled(std::size_t mode) const
+{
+    return !debug_disabled && cgui_log_compiled(mode) && (mode == DEBUG_MODE_NONE || mode <= log_level.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief      Checks, whether logs of the mode are kept by flight recorder.
+ *
+ *             Recorder keeps modes, that are compiled in, even if runtime level drops them.
+ *
+ * @param[in]  mode  The mode.
+ *
+ * @return     True if flight recorder is installed and mode is compiled in.
+ */
+inline bool CGUIDebugHandler::is_recorded(std::size_t mode) const
+{
+    return main_flight_recorder.is_recording(mode);
+}
+
+/**
+ * @brief      Posts structured record, arguments are copied as raw bytes and formatted by writer.
+ *
+ *             Amount of arguments is checked against format of the message by compiler.
+ *
+ * @param[in]  arguments  Arguments of the message, numbers, code points and strings.
+ *
+ * @tparam     message_id  Message from CGUI_LOG_MESSAGES.
+ */
+template <CGUILogMessage message_id, typename... Arguments>
+void CGUIDebugHandler::post_record(const Arguments&... arguments)
+{
+    static_assert(cgui_log_placeholder_count(cgui_log_message_format(message_id)) == sizeof...(Arguments), "Amount of arguments does not match format of the message");
+
+    if constexpr (!cgui_log_compiled(cgui_log_message_mode(message_id)))
+    {
+        return;
+    }
+
+    bool log_written = is_enabled(cgui_log_message_mode(message_id)) && log_writer != nullptr;
+    bool log_recorded = is_recorded(cgui_log_message_mode(message_id));
+    if (!log_written && !log_recorded)
+    {
+        return;
+    }
+
+    CGUILogRecord log_record;
+    log_record.post_time = CGUILogClock::now();
+    log_record.mode = cgui_log_message_mode(message_id);
+    log_record.message_id = message_id;
+    log_record.argument_count = (uint8_t)sizeof...(Arguments);
+    (cgui_log_encode(log_record.payload.data(), log_record.payload_size, CGUI_LOG_PAYLOAD_SIZE, arguments), ...);
+
+    if (log_recorded)
+    {
+        main_flight_recorder.record(log_record);
+    }
+
+    if (!log_written)
+    {
+        return;
+    }
+
+    if (log_record.mode == DEBUG_MODE_ERROR)
+    {
+        echo_record(log_record);
+    }
+
+    log_writer->post(std::move(log_record));
+}
+
+/**
+ * @brief      Posts UTF-8 message, that is formatted from arguments.
+ *
+ *             Message is formatted into buffer of the calling thread, so it is only
+ *             copied once into the ring and nothing is allocated for short messages.
+ *
+ * @param[in]  format     Format of the message, {} is replaced by next argument.
+ * @param[in]  arguments  Arguments of the message, numbers, code points and strings.
+ *
+ * @tparam     mode  Prefix that would be posted before message.
+ */
+template <std::size_t mode, typename... Arguments>
+void CGUIDebugHandler::post_format(std::string_view format, const Arguments&... arguments)
+{
+    if constexpr (!cgui_log_compiled(mode))
+    {
+        return;
+    }
+
+    if (!is_enabled(mode) && !is_recorded(mode))
+    {
+        return;
+    }
+
+    static thread_local std::string format_buffer;
+    format_buffer.clear();
+    cgui_log_format(format_buffer, format, arguments...);
+
+    post_log(std::string_view(format_buffer), mode);
+}
+
 #endif // CGUIDEBUGHANDLER_HPP
\ No newline at end of file
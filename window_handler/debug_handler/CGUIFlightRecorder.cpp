@@ -0,0 +1,409 @@
+/**
+ * @file       <CGUIFlightRecorder.cpp>
+ * @brief      This source file implements CGUIFlightRecorder class.
+ *
+ *             It is being used in order to keep recent log records of every thread
+ *             in memory and to dump them, once application crashes or it is asked to.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUIFlightRecorder.hpp"
+#include "../protection/CGUIProtection.hpp"
+
+#if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+    #include <signal.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cerrno>
+#else
+    #include <csignal>
+    #include <cstdio>
+#endif // POSIX
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+static_assert((CGUI_FLIGHT_RING_SIZE & (CGUI_FLIGHT_RING_SIZE - 1)) == 0, "Flight ring size has to be power of two");
+static_assert(CGUI_FLIGHT_PAYLOAD_SIZE >= CGUI_LOG_PAYLOAD_SIZE, "Flight record has to fit structured record");
+
+CGUIFlightRecorder main_flight_recorder;
+
+/**
+ * Hands ring back to recorder, once thread, that owns it, is finished.
+ */
+struct CGUIFlightRingOwner
+{
+    CGUIFlightRing* flight_ring = nullptr;
+
+    ~CGUIFlightRingOwner()
+    {
+        if (flight_ring != nullptr)
+        {
+            flight_ring->owned.store(false, std::memory_order_release);
+        }
+    }
+};
+
+#if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+    /**
+     * Overflow of the stack is reported as SIGSEGV, so handler needs its own stack.
+     */
+    static char signal_stack[65536];
+#endif // POSIX
+
+/**
+ * @brief      Constructs flight recorder, it does not record until it is installed.
+ */
+CGUIFlightRecorder::CGUIFlightRecorder()
+{
+}
+
+/**
+ * @brief      Destroys flight recorder.
+ *
+ *             Rings are left to the system, other threads might still record during exit.
+ */
+CGUIFlightRecorder::~CGUIFlightRecorder()
+{
+    recorder_installed.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * @brief      Starts recording and prepares dump.
+ *
+ * @param[in]  dump_directory  Directory of the dump, dump is flight_record_<pid>.cgl.
+ * @param[in]  catch_signals   Dump is written from SIGSEGV and SIGABRT handlers.
+ *
+ * @return     False if path of the dump is too long.
+ */
+bool CGUIFlightRecorder::install(const std::filesystem::path& dump_directory, bool catch_signals)
+{
+    std::error_code file_error;
+    std::filesystem::create_directories(dump_directory, file_error);
+
+    std::string dump_name = __CGUI_OBF__("flight_record");
+    #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+        dump_name += "_" + std::to_string(getpid());
+    #endif // POSIX
+    dump_name += __CGUI_OBF__(".cgl");
+
+    std::string dump_path_string = (dump_directory / dump_name).string();
+    if (dump_path_string.size() >= CGUI_FLIGHT_PATH_SIZE)
+    {
+        return false;
+    }
+
+    std::memcpy(dump_path, dump_path_string.c_str(), dump_path_string.size() + 1);
+
+    if (catch_signals)
+    {
+        #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+            stack_t alternate_stack = {};
+            alternate_stack.ss_sp = signal_stack;
+            alternate_stack.ss_size = sizeof(signal_stack);
+            sigaltstack(&alternate_stack, nullptr);
+
+            // Handler is reset before it is called, so raised signal ends the process
+            struct sigaction signal_action = {};
+            signal_action.sa_handler = signal_handler;
+            signal_action.sa_flags = SA_RESETHAND | SA_ONSTACK;
+            sigemptyset(&signal_action.sa_mask);
+
+            sigaction(SIGSEGV, &signal_action, nullptr);
+            sigaction(SIGABRT, &signal_action, nullptr);
+        #else
+            std::signal(SIGSEGV, signal_handler);
+            std::signal(SIGABRT, signal_handler);
+        #endif // POSIX
+    }
+
+    recorder_installed.store(true, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief      Keeps record in ring of calling thread, the oldest record is overwritten.
+ *
+ *             Text, that does not fit into flight record, is cut.
+ *
+ * @param[in]  log_record  The log record.
+ */
+void CGUIFlightRecorder::record(const CGUILogRecord& log_record)
+{
+    CGUIFlightRing* flight_ring = get_thread_ring();
+    if (flight_ring == nullptr)
+    {
+        return;
+    }
+
+    uint64_t record_index = flight_ring->position.load(std::memory_order_relaxed);
+    CGUIFlightRecord& flight_record = flight_ring->records[record_index & (CGUI_FLIGHT_RING_SIZE - 1)];
+
+    // Record is invalid, while it is being overwritten, dump skips it then
+    flight_record.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    flight_record.header.post_time = log_record.post_time;
+    flight_record.header.message_id = log_record.message_id;
+    flight_record.header.mode = (uint8_t)log_record.mode;
+
+    if (log_record.message_id == CGUI_LOG_TEXT && log_record.payload_size == 0)
+    {
+        uint32_t payload_size = 0;
+        cgui_log_encode(flight_record.payload.data(), payload_size, CGUI_FLIGHT_PAYLOAD_SIZE, std::string_view(log_record.message));
+        flight_record.header.payload_size = payload_size;
+        flight_record.header.argument_count = 1;
+    }
+    else
+    {
+        flight_record.header.payload_size = std::min<uint32_t>(log_record.payload_size, CGUI_FLIGHT_PAYLOAD_SIZE);
+        flight_record.header.argument_count = log_record.argument_count;
+        std::memcpy(flight_record.payload.data(), log_record.payload.data(), flight_record.header.payload_size);
+    }
+
+    flight_record.sequence.store(record_index + 1, std::memory_order_release);
+    flight_ring->position.store(record_index + 1, std::memory_order_release);
+}
+
+/**
+ * @brief      Writes records of every ring, merged by time, into binary log.
+ *
+ *             Dump does not allocate or lock, so it can be called from signal handler.
+ *             Records, that are overwritten during dump, are skipped.
+ *
+ * @return     False if recorder is not installed, dump is running or file can not be written.
+ */
+bool CGUIFlightRecorder::dump()
+{
+    if (!recorder_installed.load(std::memory_order_acquire) || dump_running.exchange(true, std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+        int dump_file = ::open(dump_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (dump_file == -1)
+        {
+            dump_running.store(false, std::memory_order_release);
+            return false;
+        }
+    #else
+        std::FILE* dump_file = std::fopen(dump_path, "wb");
+        if (dump_file == nullptr)
+        {
+            dump_running.store(false, std::memory_order_release);
+            return false;
+        }
+    #endif // POSIX
+
+    char write_buffer[8192];
+    std::size_t buffer_size = 0;
+    bool dump_written = true;
+
+    auto flush_buffer = [&]()
+    {
+        std::size_t written_size = 0;
+        while (dump_written && written_size < buffer_size)
+        {
+            #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+                ssize_t write_result = ::write(dump_file, write_buffer + written_size, buffer_size - written_size);
+                if (write_result < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+            #else
+                long long write_result = (long long)std::fwrite(write_buffer + written_size, 1, buffer_size - written_size, dump_file);
+            #endif // POSIX
+
+            if (write_result <= 0)
+            {
+                dump_written = false;
+                break;
+            }
+            written_size += (std::size_t)write_result;
+        }
+        buffer_size = 0;
+    };
+
+    auto append_buffer = [&](const void* data, std::size_t data_size)
+    {
+        if (buffer_size + data_size > sizeof(write_buffer))
+        {
+            flush_buffer();
+        }
+        std::memcpy(write_buffer + buffer_size, data, data_size);
+        buffer_size += data_size;
+    };
+
+    CGUILogFileHeader file_header;
+    append_buffer(&file_header, sizeof(file_header));
+
+    // Every ring is read from its oldest record, rings are merged by post time
+    CGUIFlightRing* dump_rings[CGUI_FLIGHT_THREAD_COUNT];
+    uint64_t read_index[CGUI_FLIGHT_THREAD_COUNT];
+    uint64_t end_index[CGUI_FLIGHT_THREAD_COUNT];
+    CGUILogRecordHeader next_header[CGUI_FLIGHT_THREAD_COUNT];
+    uint8_t next_payload[CGUI_FLIGHT_THREAD_COUNT][CGUI_FLIGHT_PAYLOAD_SIZE];
+    bool next_valid[CGUI_FLIGHT_THREAD_COUNT];
+
+    auto read_next = [&](std::size_t ring_index)
+    {
+        next_valid[ring_index] = false;
+        while (read_index[ring_index] < end_index[ring_index])
+        {
+            const CGUIFlightRecord& flight_record = dump_rings[ring_index]->records[read_index[ring_index] & (CGUI_FLIGHT_RING_SIZE - 1)];
+            uint64_t expected_sequence = ++read_index[ring_index];
+
+            if (flight_record.sequence.load(std::memory_order_acquire) != expected_sequence)
+            {
+                continue;
+            }
+
+            next_header[ring_index] = flight_record.header;
+            next_header[ring_index].payload_size = std::min<uint32_t>(next_header[ring_index].payload_size, CGUI_FLIGHT_PAYLOAD_SIZE);
+            std::memcpy(next_payload[ring_index], flight_record.payload.data(), next_header[ring_index].payload_size);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (flight_record.sequence.load(std::memory_order_relaxed) == expected_sequence)
+            {
+                next_valid[ring_index] = true;
+                return;
+            }
+        }
+    };
+
+    for (std::size_t ring_index = 0; ring_index < CGUI_FLIGHT_THREAD_COUNT; ++ring_index)
+    {
+        dump_rings[ring_index] = flight_rings[ring_index].load(std::memory_order_acquire);
+        end_index[ring_index] = (dump_rings[ring_index] != nullptr) ? dump_rings[ring_index]->position.load(std::memory_order_acquire) : 0;
+        read_index[ring_index] = (end_index[ring_index] > CGUI_FLIGHT_RING_SIZE) ? end_index[ring_index] - CGUI_FLIGHT_RING_SIZE : 0;
+        read_next(ring_index);
+    }
+
+    while (dump_written)
+    {
+        std::size_t oldest_ring = CGUI_FLIGHT_THREAD_COUNT;
+        for (std::size_t ring_index = 0; ring_index < CGUI_FLIGHT_THREAD_COUNT; ++ring_index)
+        {
+            if (next_valid[ring_index] && (oldest_ring == CGUI_FLIGHT_THREAD_COUNT || next_header[ring_index].post_time < next_header[oldest_ring].post_time))
+            {
+                oldest_ring = ring_index;
+            }
+        }
+
+        if (oldest_ring == CGUI_FLIGHT_THREAD_COUNT)
+        {
+            break;
+        }
+
+        append_buffer(&next_header[oldest_ring], sizeof(CGUILogRecordHeader));
+        append_buffer(next_payload[oldest_ring], next_header[oldest_ring].payload_size);
+        read_next(oldest_ring);
+    }
+
+    flush_buffer();
+
+    #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+        ::close(dump_file);
+    #else
+        std::fclose(dump_file);
+    #endif // POSIX
+
+    dump_running.store(false, std::memory_order_release);
+    return dump_written;
+}
+
+/**
+ * @brief      Gets path of the dump.
+ *
+ * @return     Path of the dump, empty until recorder is installed.
+ */
+const char* CGUIFlightRecorder::get_dump_path()
+{
+    return dump_path;
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Gets ring of calling thread, ring is claimed on first record.
+ *
+ *             Once every slot has a ring, threads reuse rings of finished threads.
+ *
+ * @return     Ring of the thread, nullptr if every ring is owned.
+ */
+CGUIFlightRing* CGUIFlightRecorder::get_thread_ring()
+{
+    static thread_local CGUIFlightRingOwner ring_owner;
+    if (ring_owner.flight_ring != nullptr)
+    {
+        return ring_owner.flight_ring;
+    }
+
+    // Free slot is taken first, so history of finished threads is kept as long as possible
+    for (std::atomic<CGUIFlightRing*>& ring_slot : flight_rings)
+    {
+        CGUIFlightRing* flight_ring = ring_slot.load(std::memory_order_acquire);
+        if (flight_ring != nullptr)
+        {
+            continue;
+        }
+
+        CGUIFlightRing* new_ring = new CGUIFlightRing();
+        new_ring->owned.store(true, std::memory_order_relaxed);
+        if (ring_slot.compare_exchange_strong(flight_ring, new_ring, std::memory_order_acq_rel))
+        {
+            ring_owner.flight_ring = new_ring;
+            return new_ring;
+        }
+        delete new_ring;
+    }
+
+    // Ring of finished thread keeps its records until they are overwritten
+    for (std::atomic<CGUIFlightRing*>& ring_slot : flight_rings)
+    {
+        CGUIFlightRing* flight_ring = ring_slot.load(std::memory_order_acquire);
+        bool ring_owned = false;
+        if (flight_ring->owned.compare_exchange_strong(ring_owned, true, std::memory_order_acq_rel))
+        {
+            ring_owner.flight_ring = flight_ring;
+            return flight_ring;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief      Dumps records and raises signal again, so default action ends the process.
+ *
+ * @param[in]  signal_number  The signal.
+ */
+void CGUIFlightRecorder::signal_handler(int signal_number)
+{
+    main_flight_recorder.dump();
+
+    #if !(defined(__unix__) || defined(__linux__) || defined(__APPLE__))
+        std::signal(signal_number, SIG_DFL);
+    #endif // POSIX
+
+    raise(signal_number);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file       <CGUIFlightRecorder.hpp>
+ * @brief      This header file implements CGUIFlightRecorder class.
+ *
+ *             It is being used in order to keep recent log records of every thread
+ *             in memory and to dump them, once application crashes or it is asked to.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUIFLIGHTRECORDER_HPP
+#define CGUIFLIGHTRECORDER_HPP
+
+#include <filesystem>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <array>
+
+#include "CGUILogFormat.hpp"
+#include "CGUILogWriter.hpp"
+
+/**
+ * Flight recorder settings, ring size has to be power of two.
+ */
+#define CGUI_FLIGHT_RING_SIZE       4096    // Records of one thread
+#define CGUI_FLIGHT_THREAD_COUNT    32      // Threads, that can record at once
+#define CGUI_FLIGHT_PAYLOAD_SIZE    104     // Record is 128 bytes with its header
+#define CGUI_FLIGHT_PATH_SIZE       512
+
+/**
+ * Recorded log record, sequence is index of record plus one, once it is complete.
+ */
+struct CGUIFlightRecord
+{
+    std::atomic<uint64_t>   sequence = 0;
+    CGUILogRecordHeader     header;
+    std::array<uint8_t, CGUI_FLIGHT_PAYLOAD_SIZE> payload;
+};
+
+/**
+ * Ring of one thread, it is only written by thread, that owns it.
+ */
+struct CGUIFlightRing
+{
+    std::atomic<uint64_t>   position    = 0;
+    std::atomic<bool>       owned       = false;
+    CGUIFlightRecord        records[CGUI_FLIGHT_RING_SIZE];
+};
+
+/**
+ * @brief      This class implements flight recorder of the log.
+ *
+ *             Every thread records into its own ring, so recording is a copy of the record
+ *             and one release store, nothing is written to disk. Rings are never freed, once
+ *             every slot is taken, ring of finished thread is handed to new thread. Dump merges rings by time into
+ *             binary log, that is read by cgui_logdump, it only uses calls, that are safe in
+ *             signal handler, so it is done right from SIGSEGV and SIGABRT handlers.
+ */
+class CGUIFlightRecorder
+{
+public:
+    CGUIFlightRecorder();
+    ~CGUIFlightRecorder();
+
+    bool install(const std::filesystem::path& dump_directory, bool catch_signals = true);
+    bool is_recording(std::size_t mode) const;
+
+    void record(const CGUILogRecord& log_record);
+    bool dump();
+    const char* get_dump_path();
+
+private:
+    CGUIFlightRing* get_thread_ring();
+    static void signal_handler(int signal_number);
+
+private:
+    std::array<std::atomic<CGUIFlightRing*>, CGUI_FLIGHT_THREAD_COUNT> flight_rings = {};
+
+    std::atomic<bool>   recorder_installed  = false;
+    std::atomic<bool>   dump_running        = false;
+
+    /**
+     * Path is built once, dump can not allocate in signal handler.
+     */
+    char dump_path[CGUI_FLIGHT_PATH_SIZE] = {};
+};
+
+extern CGUIFlightRecorder main_flight_recorder;
+
+/**
+ * @brief      Checks, whether records of the mode are kept.
+ *
+ * @param[in]  mode  The mode.
+ *
+ * @return     True if recorder is installed and mode is compiled in.
+ */
+inline bool CGUIFlightRecorder::is_recording(std::size_t mode) const
+{
+    return cgui_log_compiled(mode) && recorder_installed.load(std::memory_order_relaxed);
+}
+
+#endif // CGUIFLIGHTRECORDER_HPP
@@ -0,0 +1,105 @@
+/**
+ * @file       <CGUILogClock.cpp>
+ * @brief      This source file implements CGUILogClock class.
+ *
+ *             It is being used in order to stamp log records and to format
+ *             stamps without touching C time library on every record.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUILogClock.hpp"
+
+/**
+ * @brief      Gets stamp of current moment.
+ *
+ *             Wall clock is only read once, later stamps are offsets of steady clock,
+ *             so adjustments of system time do not reorder records.
+ *
+ * @return     Microseconds since epoch.
+ */
+uint64_t CGUILogClock::now()
+{
+    static const std::chrono::system_clock::time_point wall_anchor = std::chrono::system_clock::now();
+    static const std::chrono::steady_clock::time_point steady_anchor = std::chrono::steady_clock::now();
+
+    uint64_t wall_time = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(wall_anchor.time_since_epoch()).count();
+    return wall_time + (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - steady_anchor).count();
+}
+
+/**
+ * @brief      Appends formatted stamp to output.
+ *
+ *             Local time is only converted, once second changes.
+ *
+ * @param[in]  stamp   Microseconds since epoch.
+ * @param      output  The output.
+ */
+void CGUILogClock::format(uint64_t stamp, std::string& output)
+{
+    int64_t stamp_second = (int64_t)(stamp / 1000000);
+    if (stamp_second != cached_second)
+    {
+        std::time_t post_time = (std::time_t)stamp_second;
+        std::tm time_struct = {};
+        #if defined(_WIN32) || defined(WIN32) || defined(__CYGWIN__) || defined(__MINGW32__) || defined(__BORLANDC__)
+            localtime_s(&time_struct, &post_time);
+        #else
+            localtime_r(&post_time, &time_struct);
+        #endif // Windows
+
+        cached_stamp[0] = '[';
+        write_digits(cached_stamp + 1, (uint64_t)(time_struct.tm_year + 1900), 4);
+        cached_stamp[5] = '-';
+        write_digits(cached_stamp + 6, (uint64_t)(time_struct.tm_mon + 1), 2);
+        cached_stamp[8] = '-';
+        write_digits(cached_stamp + 9, (uint64_t)time_struct.tm_mday, 2);
+        cached_stamp[11] = '-';
+        write_digits(cached_stamp + 12, (uint64_t)time_struct.tm_hour, 2);
+        cached_stamp[14] = '-';
+        write_digits(cached_stamp + 15, (uint64_t)time_struct.tm_min, 2);
+        cached_stamp[17] = '-';
+        write_digits(cached_stamp + 18, (uint64_t)time_struct.tm_sec, 2);
+        cached_stamp[CGUI_LOG_SECOND_SIZE] = '.';
+        cached_stamp[CGUI_LOG_STAMP_SIZE - 1] = ']';
+
+        cached_second = stamp_second;
+    }
+
+    write_digits(cached_stamp + CGUI_LOG_SECOND_SIZE + 1, stamp % 1000000, 6);
+    output.append(cached_stamp, CGUI_LOG_STAMP_SIZE);
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Writes zero padded decimal digits.
+ *
+ * @param      output       The output, it has to fit digit count.
+ * @param[in]  value        The value, higher digits are cut.
+ * @param[in]  digit_count  The digit count.
+ */
+void CGUILogClock::write_digits(char* output, uint64_t value, std::size_t digit_count)
+{
+    for (std::size_t digit_index = digit_count; digit_index > 0; --digit_index)
+    {
+        output[digit_index - 1] = (char)('0' + value % 10);
+        value /= 10;
+    }
+}
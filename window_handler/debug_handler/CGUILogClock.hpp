@@ -0,0 +1,66 @@
+/**
+ * @file       <CGUILogClock.hpp>
+ * @brief      This header file implements CGUILogClock class.
+ *
+ *             It is being used in order to stamp log records and to format
+ *             stamps without touching C time library on every record.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUILOGCLOCK_HPP
+#define CGUILOGCLOCK_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <chrono>
+#include <ctime>
+
+/**
+ * Formatted stamp is "[YYYY-MM-DD-HH-MM-SS.uuuuuu]".
+ */
+#define CGUI_LOG_STAMP_SIZE         28
+#define CGUI_LOG_SECOND_SIZE        20  // Stamp without microseconds and closing bracket
+
+/**
+ * @brief      This class implements time service of the log.
+ *
+ *             Stamps are microseconds since epoch, they are taken from monotonic clock,
+ *             that is anchored to wall clock once, so records are never stamped backwards.
+ *             Formatter caches date and time of the current second and only appends
+ *             microseconds to it, so formatting does not allocate.
+ */
+class CGUILogClock
+{
+public:
+    static uint64_t now();
+
+    void format(uint64_t stamp, std::string& output);
+
+private:
+    static void write_digits(char* output, uint64_t value, std::size_t digit_count);
+
+private:
+    /**
+     * Cache is only used by one thread, that formats records.
+     */
+    int64_t     cached_second = -1;
+    char        cached_stamp[CGUI_LOG_STAMP_SIZE];
+};
+
+#endif // CGUILOGCLOCK_HPP
@@ -0,0 +1,467 @@
+/**
+ * @file       <CGUILogFormat.hpp>
+ * @brief      This header file implements CGUILogFormat structures.
+ *
+ *             It is being used in order to share binary layout of structured logs
+ *             between log writer and decoder.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUILOGFORMAT_HPP
+#define CGUILOGFORMAT_HPP
+
+#include <string_view>
+#include <type_traits>
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+/**
+ * CGUI log prefix list, modes are stored in binary logs.
+ */
+#define DEBUG_MODE_ERROR            0 
+#define DEBUG_MODE_WARNING          1
+#define DEBUG_MODE_MESSAGE          2
+#define DEBUG_MODE_LOG              3
+#define DEBUG_MODE_GLFW_CALLBACK    4
+#define DEBUG_MODE_NONE             255
+
+/**
+ * Most verbose mode, that is compiled in, logs above it are removed with their arguments.
+ * Unprefixed DEBUG_MODE_NONE lines are never removed.
+ */
+#ifndef CGUI_LOG_LEVEL
+    #define CGUI_LOG_LEVEL          DEBUG_MODE_GLFW_CALLBACK
+#endif // CGUI_LOG_LEVEL
+
+/**
+ * Binary log file header values.
+ */
+#define CGUI_LOG_MAGIC              0x424C4743u     // "CGLB"
+#define CGUI_LOG_VERSION            1
+#define CGUI_LOG_PAYLOAD_SIZE       96              // Arguments of one structured record in the ring
+
+/**
+ * Messages of structured records.
+ *
+ * Every entry is X(name, mode, format), {} in format is replaced by next argument.
+ * Identifiers are stored in log files, so entries are only appended, never reordered.
+ */
+#define CGUI_LOG_MESSAGES(X) \
+    X(TEXT,                     DEBUG_MODE_NONE,    "{}") \
+    X(CHARACTER,                DEBUG_MODE_LOG,     "Character: {}") \
+    X(CURSOR_ENTER,             DEBUG_MODE_LOG,     "Cursor enteren main window: {}") \
+    X(LEFT_BUTTON_PRESS,        DEBUG_MODE_LOG,     "Left button has been pressed.") \
+    X(LEFT_BUTTON_RELEASE,      DEBUG_MODE_LOG,     "The left button was released, it was held: {}ms") \
+    X(MOUSE_ACTION_INVALID,     DEBUG_MODE_ERROR,   "Invalid key callback action: {}") \
+    X(SCROLL,                   DEBUG_MODE_LOG,     "Scroll event main window: {} {}") \
+    X(SHADER_RELOAD,            DEBUG_MODE_MESSAGE, "Shader has been reloaded: {}") \
+    X(CAPTURE_REQUEST,          DEBUG_MODE_MESSAGE, "Frame capture of {} frames has been requested.") \
+    X(FLIGHT_RECORD_DUMP,       DEBUG_MODE_MESSAGE, "Flight record has been dumped: {}")
+
+/**
+ * Identifiers of structured messages.
+ */
+enum CGUILogMessage : uint16_t
+{
+    #define CGUI_LOG_MESSAGE_ENUM(name, ...) CGUI_LOG_##name,
+    CGUI_LOG_MESSAGES(CGUI_LOG_MESSAGE_ENUM)
+    #undef CGUI_LOG_MESSAGE_ENUM
+
+    CGUI_LOG_MESSAGE_COUNT
+};
+
+/**
+ * Kinds of arguments, every argument is stored as kind and raw bytes.
+ */
+enum CGUILogArgument : uint8_t
+{
+    CGUI_LOG_ARGUMENT_INT32 = 0,
+    CGUI_LOG_ARGUMENT_INT64,
+    CGUI_LOG_ARGUMENT_UINT32,
+    CGUI_LOG_ARGUMENT_UINT64,
+    CGUI_LOG_ARGUMENT_FLOAT,
+    CGUI_LOG_ARGUMENT_DOUBLE,
+    CGUI_LOG_ARGUMENT_CHAR32,       // Code point, rendered as UTF-8
+    CGUI_LOG_ARGUMENT_STRING        // Length as uint32_t, bytes follow it
+};
+
+/**
+ * Binary log file header.
+ */
+struct CGUILogFileHeader
+{
+    uint32_t    magic           = CGUI_LOG_MAGIC;
+    uint32_t    version         = CGUI_LOG_VERSION;
+    uint32_t    message_count   = CGUI_LOG_MESSAGE_COUNT;
+    uint32_t    reserved        = 0;
+};
+
+/**
+ * Header of every record, argument payload follows it.
+ */
+struct CGUILogRecordHeader
+{
+    uint64_t    post_time       = 0;            // Microseconds since epoch
+    uint32_t    payload_size    = 0;
+    uint16_t    message_id      = CGUI_LOG_TEXT;
+    uint8_t     mode            = 0;
+    uint8_t     argument_count  = 0;
+};
+
+static_assert(sizeof(CGUILogRecordHeader) == 16, "Log record header has to be packed");
+
+/**
+ * @brief      Gets mode of structured message.
+ *
+ * @param[in]  message_id  The message.
+ *
+ * @return     Mode, one of DEBUG_MODE_*.
+ */
+constexpr uint8_t cgui_log_message_mode(uint16_t message_id)
+{
+    switch (message_id)
+    {
+        #define CGUI_LOG_MESSAGE_MODE(name, mode, ...) case CGUI_LOG_##name: return mode;
+        CGUI_LOG_MESSAGES(CGUI_LOG_MESSAGE_MODE)
+        #undef CGUI_LOG_MESSAGE_MODE
+
+        default:
+            return DEBUG_MODE_NONE;
+    }
+}
+
+/**
+ * @brief      Checks, whether logs of the mode are compiled in.
+ *
+ * @param[in]  mode  The mode.
+ *
+ * @return     True if mode is not above CGUI_LOG_LEVEL.
+ */
+constexpr bool cgui_log_compiled(std::size_t mode)
+{
+    return mode == DEBUG_MODE_NONE || mode <= CGUI_LOG_LEVEL;
+}
+
+/**
+ * @brief      Gets format of structured message.
+ *
+ * @param[in]  message_id  The message.
+ *
+ * @return     Format of the message, nullptr for unknown one.
+ */
+constexpr const char* cgui_log_message_format(uint16_t message_id)
+{
+    switch (message_id)
+    {
+        #define CGUI_LOG_MESSAGE_FORMAT(name, mode, format) case CGUI_LOG_##name: return format;
+        CGUI_LOG_MESSAGES(CGUI_LOG_MESSAGE_FORMAT)
+        #undef CGUI_LOG_MESSAGE_FORMAT
+
+        default:
+            return nullptr;
+    }
+}
+
+/**
+ * @brief      Counts placeholders in format, so arguments can be checked by compiler.
+ *
+ * @param[in]  format  The format.
+ *
+ * @return     Amount of {} in format.
+ */
+constexpr std::size_t cgui_log_placeholder_count(std::string_view format)
+{
+    std::size_t placeholder_count = 0;
+    for (std::size_t char_index = 0; char_index + 1 < format.size(); ++char_index)
+    {
+        if (format[char_index] == '{' && format[char_index + 1] == '}')
+        {
+            ++placeholder_count;
+            ++char_index;
+        }
+    }
+
+    return placeholder_count;
+}
+
+/**
+ * @brief      Appends argument to payload of structured record.
+ *
+ *             Strings, that do not fit, are truncated, other arguments are dropped.
+ *
+ * @param      payload           Payload of the record.
+ * @param      payload_size      Used part of payload.
+ * @param[in]  payload_capacity  Size of payload.
+ * @param[in]  argument          The argument.
+ *
+ * @return     False if argument was dropped.
+ */
+template <typename Argument>
+inline bool cgui_log_encode(uint8_t* payload, uint32_t& payload_size, uint32_t payload_capacity, const Argument& argument)
+{
+    using ArgumentType = std::decay_t<Argument>;
+
+    auto encode_value = [&](CGUILogArgument argument_kind, auto value)
+    {
+        if (payload_size + 1 + sizeof(value) > payload_capacity)
+        {
+            return false;
+        }
+
+        payload[payload_size] = argument_kind;
+        std::memcpy(payload + payload_size + 1, &value, sizeof(value));
+        payload_size += 1 + (uint32_t)sizeof(value);
+        return true;
+    };
+
+    if constexpr (std::is_same_v<ArgumentType, char32_t>)
+    {
+        return encode_value(CGUI_LOG_ARGUMENT_CHAR32, (uint32_t)argument);
+    }
+    else if constexpr (std::is_same_v<ArgumentType, bool>)
+    {
+        return encode_value(CGUI_LOG_ARGUMENT_UINT32, (uint32_t)argument);
+    }
+    else if constexpr (std::is_integral_v<ArgumentType> && std::is_signed_v<ArgumentType>)
+    {
+        return (sizeof(ArgumentType) <= 4) ? encode_value(CGUI_LOG_ARGUMENT_INT32, (int32_t)argument) : encode_value(CGUI_LOG_ARGUMENT_INT64, (int64_t)argument);
+    }
+    else if constexpr (std::is_integral_v<ArgumentType> || std::is_enum_v<ArgumentType>)
+    {
+        return (sizeof(ArgumentType) <= 4) ? encode_value(CGUI_LOG_ARGUMENT_UINT32, (uint32_t)argument) : encode_value(CGUI_LOG_ARGUMENT_UINT64, (uint64_t)argument);
+    }
+    else if constexpr (std::is_same_v<ArgumentType, float>)
+    {
+        return encode_value(CGUI_LOG_ARGUMENT_FLOAT, argument);
+    }
+    else if constexpr (std::is_floating_point_v<ArgumentType>)
+    {
+        return encode_value(CGUI_LOG_ARGUMENT_DOUBLE, (double)argument);
+    }
+    else
+    {
+        static_assert(std::is_convertible_v<const Argument&, std::string_view>, "Unsupported structured log argument");
+
+        std::string_view string_argument = argument;
+        if (payload_size + 1 + sizeof(uint32_t) > payload_capacity)
+        {
+            return false;
+        }
+
+        uint32_t string_length = (uint32_t)std::min<std::size_t>(string_argument.size(), payload_capacity - payload_size - 1 - sizeof(uint32_t));
+        payload[payload_size] = CGUI_LOG_ARGUMENT_STRING;
+        std::memcpy(payload + payload_size + 1, &string_length, sizeof(string_length));
+        std::memcpy(payload + payload_size + 1 + sizeof(string_length), string_argument.data(), string_length);
+        payload_size += 1 + (uint32_t)sizeof(string_length) + string_length;
+        return true;
+    }
+}
+
+/**
+ * @brief      Appends code point as UTF-8, so log text does not depend on locale.
+ *
+ * @param      output      The output.
+ * @param[in]  code_point  The code point, invalid ones are replaced with U+FFFD.
+ */
+inline void cgui_log_append_utf8(std::string& output, uint32_t code_point)
+{
+    if (code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF))
+    {
+        code_point = 0xFFFD;
+    }
+
+    if (code_point < 0x80)
+    {
+        output += (char)code_point;
+    }
+    else if (code_point < 0x800)
+    {
+        output += (char)(0xC0 | (code_point >> 6));
+        output += (char)(0x80 | (code_point & 0x3F));
+    }
+    else if (code_point < 0x10000)
+    {
+        output += (char)(0xE0 | (code_point >> 12));
+        output += (char)(0x80 | ((code_point >> 6) & 0x3F));
+        output += (char)(0x80 | (code_point & 0x3F));
+    }
+    else
+    {
+        output += (char)(0xF0 | (code_point >> 18));
+        output += (char)(0x80 | ((code_point >> 12) & 0x3F));
+        output += (char)(0x80 | ((code_point >> 6) & 0x3F));
+        output += (char)(0x80 | (code_point & 0x3F));
+    }
+}
+
+/**
+ * @brief      Renders structured record into text.
+ *
+ * @param[in]  format          Format of the message.
+ * @param[in]  payload         Arguments of the record.
+ * @param[in]  payload_size    Size of arguments.
+ * @param      output          Text is appended to it.
+ *
+ * @return     False if payload is damaged, text is rendered up to the damaged argument.
+ */
+inline bool cgui_log_render(std::string_view format, const uint8_t* payload, std::size_t payload_size, std::string& output)
+{
+    std::size_t payload_offset = 0;
+    std::size_t format_offset = 0;
+
+    while (format_offset < format.size())
+    {
+        std::size_t placeholder_offset = format.find("{}", format_offset);
+        output.append(format.substr(format_offset, placeholder_offset - format_offset));
+        if (placeholder_offset == std::string_view::npos)
+        {
+            break;
+        }
+        format_offset = placeholder_offset + 2;
+
+        if (payload_offset >= payload_size)
+        {
+            output += "{}";
+            continue;
+        }
+
+        uint8_t argument_kind = payload[payload_offset++];
+        const std::size_t value_sizes[] = {4, 8, 4, 8, 4, 8, 4, 4};
+        if (argument_kind > CGUI_LOG_ARGUMENT_STRING || payload_offset + value_sizes[argument_kind] > payload_size)
+        {
+            return false;
+        }
+
+        char number_buffer[32];
+        std::to_chars_result number_result = {number_buffer, std::errc()};
+        const uint8_t* value = payload + payload_offset;
+        payload_offset += value_sizes[argument_kind];
+
+        switch (argument_kind)
+        {
+            case CGUI_LOG_ARGUMENT_INT32:   { int32_t number;  std::memcpy(&number, value, 4); number_result = std::to_chars(number_buffer, number_buffer + 32, number); } break;
+            case CGUI_LOG_ARGUMENT_INT64:   { int64_t number;  std::memcpy(&number, value, 8); number_result = std::to_chars(number_buffer, number_buffer + 32, number); } break;
+            case CGUI_LOG_ARGUMENT_UINT32:  { uint32_t number; std::memcpy(&number, value, 4); number_result = std::to_chars(number_buffer, number_buffer + 32, number); } break;
+            case CGUI_LOG_ARGUMENT_UINT64:  { uint64_t number; std::memcpy(&number, value, 8); number_result = std::to_chars(number_buffer, number_buffer + 32, number); } break;
+            case CGUI_LOG_ARGUMENT_FLOAT:   { float number;    std::memcpy(&number, value, 4); number_result = std::to_chars(number_buffer, number_buffer + 32, number); } break;
+            case CGUI_LOG_ARGUMENT_DOUBLE:  { double number;   std::memcpy(&number, value, 8); number_result = std::to_chars(number_buffer, number_buffer + 32, number); } break;
+
+            case CGUI_LOG_ARGUMENT_CHAR32:
+            {
+                uint32_t code_point;
+                std::memcpy(&code_point, value, 4);
+                cgui_log_append_utf8(output, code_point);
+            }
+            break;
+
+            case CGUI_LOG_ARGUMENT_STRING:
+            {
+                uint32_t string_length;
+                std::memcpy(&string_length, value, 4);
+                if (payload_offset + string_length > payload_size)
+                {
+                    return false;
+                }
+
+                output.append(reinterpret_cast<const char*>(payload + payload_offset), string_length);
+                payload_offset += string_length;
+            }
+            break;
+
+            default:
+            {
+                return false;
+            }
+        }
+
+        output.append(number_buffer, (std::size_t)(number_result.ptr - number_buffer));
+    }
+
+    return true;
+}
+
+/**
+ * @brief      Appends text of argument, arguments are same as structured records take.
+ *
+ * @param      output    The output.
+ * @param[in]  argument  The argument.
+ */
+template <typename Argument>
+inline void cgui_log_append(std::string& output, const Argument& argument)
+{
+    using ArgumentType = std::decay_t<Argument>;
+
+    if constexpr (std::is_same_v<ArgumentType, char32_t>)
+    {
+        cgui_log_append_utf8(output, (uint32_t)argument);
+    }
+    else if constexpr (std::is_same_v<ArgumentType, bool>)
+    {
+        output += argument ? '1' : '0';
+    }
+    else if constexpr (std::is_enum_v<ArgumentType>)
+    {
+        cgui_log_append(output, (std::underlying_type_t<ArgumentType>)argument);
+    }
+    else if constexpr (std::is_arithmetic_v<ArgumentType>)
+    {
+        char number_buffer[32];
+        std::to_chars_result number_result = std::to_chars(number_buffer, number_buffer + 32, argument);
+        output.append(number_buffer, (std::size_t)(number_result.ptr - number_buffer));
+    }
+    else
+    {
+        static_assert(std::is_convertible_v<const Argument&, std::string_view>, "Unsupported log argument");
+        output.append(std::string_view(argument));
+    }
+}
+
+/**
+ * @brief      Formats message, every {} in format is replaced by next argument.
+ *
+ *             Arguments without placeholder are skipped, placeholders without argument are kept.
+ *
+ * @param      output     Text is appended to it.
+ * @param[in]  format     The format.
+ * @param[in]  arguments  The arguments.
+ */
+template <typename... Arguments>
+inline void cgui_log_format(std::string& output, std::string_view format, const Arguments&... arguments)
+{
+    auto append_argument = [&](const auto& argument)
+    {
+        std::size_t placeholder_offset = format.find("{}");
+        if (placeholder_offset == std::string_view::npos)
+        {
+            return;
+        }
+
+        output.append(format.substr(0, placeholder_offset));
+        cgui_log_append(output, argument);
+        format.remove_prefix(placeholder_offset + 2);
+    };
+
+    (append_argument(arguments), ...);
+    output.append(format);
+}
+
+#endif // CGUILOGFORMAT_HPP
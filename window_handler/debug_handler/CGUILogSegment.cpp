@@ -0,0 +1,200 @@
+/**
+ * @file       <CGUILogSegment.cpp>
+ * @brief      This source file implements CGUILogSegment class.
+ *
+ *             It is being used in order to append log batches to active segment
+ *             of the log, that is mapped into memory.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUILogSegment.hpp"
+
+#if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif // POSIX
+
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief      Constructs closed segment.
+ */
+CGUILogSegment::CGUILogSegment()
+{
+}
+
+/**
+ * @brief      Closes segment, file is cut to written size.
+ */
+CGUILogSegment::~CGUILogSegment()
+{
+    close();
+}
+
+/**
+ * @brief      Creates empty segment, existing file is replaced.
+ *
+ * @param[in]  segment_path  Path of the segment.
+ * @param[in]  capacity      Size, segment is allocated to.
+ *
+ * @return     False if file can not be created, allocated or mapped.
+ */
+bool CGUILogSegment::open(const std::filesystem::path& segment_path, std::size_t capacity)
+{
+    close();
+
+    #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+        file_descriptor = ::open(segment_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (file_descriptor == -1)
+        {
+            return false;
+        }
+
+        // Blocks are reserved up front, so full disk fails here instead of faulting on write
+        #if defined(__linux__)
+            bool allocated = posix_fallocate(file_descriptor, 0, (off_t)capacity) == 0;
+        #else
+            bool allocated = ftruncate(file_descriptor, (off_t)capacity) == 0;
+        #endif // Linux
+
+        void* mapped_data = allocated ? mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0) : MAP_FAILED;
+        if (mapped_data == MAP_FAILED)
+        {
+            ::close(file_descriptor);
+            file_descriptor = -1;
+
+            std::error_code file_error;
+            std::filesystem::remove(segment_path, file_error);
+            return false;
+        }
+
+        madvise(mapped_data, capacity, MADV_SEQUENTIAL);
+        segment_data = static_cast<char*>(mapped_data);
+    #else
+        segment_file = std::fopen(segment_path.string().c_str(), "wb");
+        if (segment_file == nullptr)
+        {
+            return false;
+        }
+
+        // Writer does its own batching
+        std::setvbuf(segment_file, nullptr, _IONBF, 0);
+    #endif // POSIX
+
+    segment_size = 0;
+    segment_capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief      Closes segment, unused part of mapped file is cut off.
+ */
+void CGUILogSegment::close()
+{
+    #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+        if (segment_data != nullptr)
+        {
+            munmap(segment_data, segment_capacity);
+            segment_data = nullptr;
+        }
+
+        if (file_descriptor != -1)
+        {
+            if (ftruncate(file_descriptor, (off_t)segment_size) != 0)
+            {
+                // File keeps zero tail, readers stop at it
+            }
+            ::close(file_descriptor);
+            file_descriptor = -1;
+        }
+    #else
+        if (segment_file != nullptr)
+        {
+            std::fclose(segment_file);
+            segment_file = nullptr;
+        }
+    #endif // POSIX
+
+    segment_size = 0;
+    segment_capacity = 0;
+}
+
+/**
+ * @brief      Checks whether segment is open.
+ *
+ * @return     True if segment is open.
+ */
+bool CGUILogSegment::is_open() const
+{
+    #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+        return segment_data != nullptr;
+    #else
+        return segment_file != nullptr;
+    #endif // POSIX
+}
+
+/**
+ * @brief      Appends data, that fits into segment.
+ *
+ *             Mapped pages are written back by system, so data survives crash of the process.
+ *
+ * @param[in]  data       The data.
+ * @param[in]  data_size  Size of the data.
+ *
+ * @return     Amount of bytes, that were written.
+ */
+std::size_t CGUILogSegment::write(const char* data, std::size_t data_size)
+{
+    if (!is_open())
+    {
+        return 0;
+    }
+
+    std::size_t write_size = std::min(data_size, get_free_size());
+
+    #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+        std::memcpy(segment_data + segment_size, data, write_size);
+    #else
+        write_size = std::fwrite(data, 1, write_size, segment_file);
+    #endif // POSIX
+
+    segment_size += write_size;
+    return write_size;
+}
+
+/**
+ * @brief      Gets written size of the segment.
+ *
+ * @return     Size in bytes.
+ */
+std::size_t CGUILogSegment::get_size() const
+{
+    return segment_size;
+}
+
+/**
+ * @brief      Gets size, that can still be written.
+ *
+ * @return     Size in bytes.
+ */
+std::size_t CGUILogSegment::get_free_size() const
+{
+    return segment_capacity - segment_size;
+}
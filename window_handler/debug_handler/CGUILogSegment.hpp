@@ -0,0 +1,67 @@
+/**
+ * @file       <CGUILogSegment.hpp>
+ * @brief      This header file implements CGUILogSegment class.
+ *
+ *             It is being used in order to append log batches to active segment
+ *             of the log, that is mapped into memory.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUILOGSEGMENT_HPP
+#define CGUILOGSEGMENT_HPP
+
+#include <filesystem>
+#include <cstddef>
+#include <cstdio>
+
+/**
+ * @brief      This class owns active segment of the log.
+ *
+ *             On POSIX systems segment is allocated to its full capacity and mapped,
+ *             so appending is a memory copy, file is cut to written size, once it
+ *             is closed. Other systems append through unbuffered stdio file.
+ */
+class CGUILogSegment
+{
+public:
+    CGUILogSegment();
+    CGUILogSegment(const CGUILogSegment&) = delete;
+    ~CGUILogSegment();
+
+    bool open(const std::filesystem::path& segment_path, std::size_t capacity);
+    void close();
+    bool is_open() const;
+
+    std::size_t write(const char* data, std::size_t data_size);
+
+    std::size_t get_size() const;
+    std::size_t get_free_size() const;
+
+private:
+    #if defined(__unix__) || defined(__linux__) || defined(__APPLE__)
+        int         file_descriptor = -1;
+        char*       segment_data    = nullptr;
+    #else
+        std::FILE*  segment_file    = nullptr;
+    #endif // POSIX
+
+    std::size_t segment_size        = 0;
+    std::size_t segment_capacity    = 0;
+};
+
+#endif // CGUILOGSEGMENT_HPP
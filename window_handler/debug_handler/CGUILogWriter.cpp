@@ -0,0 +1,601 @@
+/**
+ * @file       <CGUILogWriter.cpp>
+ * @brief      This source file implements CGUILogWriter class.
+ *
+ *             It is being used in order to write log records on background thread,
+ *             so threads, that post logs, never wait for the disk.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUILogWriter.hpp"
+#include "CGUIDebugHandler.hpp"
+
+#ifdef CGUI_LOG_COMPRESS
+    #include <zlib.h>
+#endif // CGUI_LOG_COMPRESS
+
+static_assert((CGUI_LOG_RING_SIZE & (CGUI_LOG_RING_SIZE - 1)) == 0, "Log ring size has to be power of two");
+
+/**
+ * @brief      Constructs log writer, file is opened separately.
+ */
+CGUILogWriter::CGUILogWriter()
+{
+    log_slots = std::make_unique<CGUILogSlot[]>(CGUI_LOG_RING_SIZE);
+    for (std::size_t slot_index = 0; slot_index < CGUI_LOG_RING_SIZE; ++slot_index)
+    {
+        log_slots[slot_index].sequence.store(slot_index, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief      Stops writer thread, every posted record is written before file is closed.
+ */
+CGUILogWriter::~CGUILogWriter()
+{
+    {
+        std::lock_guard writers_lock(writers_mutex);
+        open_writers.erase(std::remove(open_writers.begin(), open_writers.end(), this), open_writers.end());
+    }
+
+    stop();
+}
+
+/**
+ * @brief      Opens active segment of the log and starts writer thread.
+ *
+ *             Existing log is rotated, so it is never overwritten.
+ *
+ * @param[in]  log_file_path   Path of the log file.
+ * @param[in]  log_header      Line, that starts every segment, empty for none, ignored by binary log.
+ * @param[in]  binary_log_arg  Records are written in binary layout, text is rendered by cgui_logdump.
+ *
+ * @return     False if file can not be opened.
+ */
+bool CGUILogWriter::open(const std::filesystem::path& log_file_path, const std::string& log_header_arg, bool binary_log_arg)
+{
+    if (log_opened.load(std::memory_order_acquire))
+    {
+        return true;
+    }
+
+    log_path = log_file_path;
+    log_header = log_header_arg;
+    binary_log = binary_log_arg;
+
+    std::error_code file_error;
+    bool opened = (std::filesystem::file_size(log_path, file_error) > 0 && !file_error) ? rotate_segments() : open_segment();
+    if (!opened)
+    {
+        return false;
+    }
+
+    log_opened.store(true, std::memory_order_release);
+    writer_thread = std::thread(&CGUILogWriter::write_thread, this);
+
+    {
+        std::lock_guard writers_lock(writers_mutex);
+        open_writers.push_back(this);
+    }
+
+    // exit() skips destructors of handlers, that are still alive, so their records are written here
+    static const int exit_registered = std::atexit(&CGUILogWriter::stop_all);
+    (void)exit_registered;
+    return true;
+}
+
+/**
+ * @brief      Checks whether records are being written.
+ *
+ * @return     True if file is open.
+ */
+bool CGUILogWriter::is_open()
+{
+    return log_opened.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief      Posts record without waiting, can be called from any thread.
+ *
+ * @param      log_record  Record, its message is moved into the ring.
+ *
+ * @return     False if ring is full, record is dropped and counted then.
+ */
+bool CGUILogWriter::post(CGUILogRecord&& log_record)
+{
+    std::size_t position = enqueue_position.load(std::memory_order_relaxed);
+    CGUILogSlot* log_slot = nullptr;
+
+    while (true)
+    {
+        log_slot = &log_slots[position & (CGUI_LOG_RING_SIZE - 1)];
+        std::size_t sequence = log_slot->sequence.load(std::memory_order_acquire);
+        std::intptr_t sequence_difference = (std::intptr_t)sequence - (std::intptr_t)position;
+
+        if (sequence_difference == 0)
+        {
+            if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (sequence_difference < 0)
+        {
+            dropped_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            position = enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+
+    bool urgent_record = (log_record.mode == DEBUG_MODE_ERROR);
+
+    log_slot->record = std::move(log_record);
+    log_slot->sequence.store(position + 1, std::memory_order_release);
+
+    // Writer is only woken up early for errors and every half of the ring, otherwise it wakes up on its own
+    if ((urgent_record || (position & (CGUI_LOG_RING_SIZE / 2 - 1)) == 0) && writer_sleeping.load(std::memory_order_relaxed))
+    {
+        writer_condition.notify_one();
+    }
+
+    return true;
+}
+
+/**
+ * @brief      Waits until every record, posted before the call, is written to disk.
+ */
+void CGUILogWriter::flush()
+{
+    if (!writer_thread.joinable())
+    {
+        return;
+    }
+
+    std::unique_lock writer_lock(writer_mutex);
+    std::size_t target_position = enqueue_position.load(std::memory_order_acquire);
+    flush_target = std::max(flush_target, target_position);
+    writer_condition.notify_one();
+
+    flushed_condition.wait(writer_lock, [&]() { return flushed_position >= target_position || stop_requested; });
+}
+
+/**
+ * @brief      Writes every posted record, stops writer thread and cuts segment to written size.
+ *
+ *             Records, that are posted later, are not written.
+ */
+void CGUILogWriter::stop()
+{
+    if (writer_thread.joinable())
+    {
+        {
+            std::lock_guard writer_lock(writer_mutex);
+            stop_requested = true;
+        }
+        writer_condition.notify_one();
+        writer_thread.join();
+    }
+
+    if (compress_thread.joinable())
+    {
+        compress_thread.join();
+    }
+
+    log_segment.close();
+}
+
+/**
+ * @brief      Stops every open writer, has to be called before process exits.
+ */
+void CGUILogWriter::stop_all()
+{
+    std::lock_guard writers_lock(writers_mutex);
+    for (CGUILogWriter* log_writer : open_writers)
+    {
+        log_writer->stop();
+    }
+}
+
+/**
+ * @brief      Renders message of the record into text, can be called from any thread.
+ *
+ * @param[in]  log_record  The record.
+ * @param      output      Text is appended to it.
+ */
+void CGUILogWriter::render_message(const CGUILogRecord& log_record, std::string& output)
+{
+    if (log_record.message_id == CGUI_LOG_TEXT && log_record.payload_size == 0)
+    {
+        output += log_record.message;
+        return;
+    }
+
+    // Formats are only decrypted once by every thread, that renders them
+    static thread_local const std::string message_formats[] =
+    {
+        #define CGUI_LOG_MESSAGE_DECRYPT(name, mode, format) __CGUI_OBF__(format),
+        CGUI_LOG_MESSAGES(CGUI_LOG_MESSAGE_DECRYPT)
+        #undef CGUI_LOG_MESSAGE_DECRYPT
+    };
+
+    if (log_record.message_id >= CGUI_LOG_MESSAGE_COUNT)
+    {
+        output += __CGUI_OBF__("[UNKNOWN MESSAGE] ") + std::to_string((unsigned int)log_record.message_id);
+        return;
+    }
+
+    cgui_log_render(message_formats[log_record.message_id], log_record.payload.data(), log_record.payload_size, output);
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Drains the ring and writes records in batches until writer is stopped.
+ */
+void CGUILogWriter::write_thread()
+{
+    std::string write_buffer;
+    write_buffer.reserve(CGUI_LOG_FLUSH_SIZE * 2);
+
+    std::chrono::steady_clock::time_point last_flush = std::chrono::steady_clock::now();
+    CGUILogRecord log_record;
+
+    while (true)
+    {
+        std::size_t target_position = 0;
+        bool stopping = false;
+        {
+            std::lock_guard writer_lock(writer_mutex);
+            target_position = flush_target;
+            stopping = stop_requested;
+        }
+
+        while (try_dequeue(log_record))
+        {
+            format_record(log_record, write_buffer);
+            if (write_buffer.size() >= CGUI_LOG_FLUSH_SIZE)
+            {
+                write_batch(write_buffer);
+                last_flush = std::chrono::steady_clock::now();
+            }
+        }
+
+        std::size_t dropped_records = dropped_count.exchange(0, std::memory_order_relaxed);
+        if (dropped_records != 0)
+        {
+            write_buffer += __CGUI_OBF__("[LOG RING FULL] ") + std::to_string(dropped_records) + __CGUI_OBF__(" records were dropped\n");
+        }
+
+        bool flush_due = std::chrono::steady_clock::now() - last_flush >= std::chrono::milliseconds(CGUI_LOG_FLUSH_INTERVAL);
+        if (!write_buffer.empty() && (flush_due || stopping || target_position > flushed_position))
+        {
+            write_batch(write_buffer);
+            last_flush = std::chrono::steady_clock::now();
+        }
+
+        // Records, that are still in buffer, are not flushed yet
+        if (write_buffer.empty())
+        {
+            std::lock_guard writer_lock(writer_mutex);
+            flushed_position = dequeue_position;
+        }
+        flushed_condition.notify_all();
+
+        if (stopping)
+        {
+            break;
+        }
+
+        std::unique_lock writer_lock(writer_mutex);
+        writer_sleeping.store(true, std::memory_order_relaxed);
+
+        // Flush, that waits for record, that is not published yet, is retried soon.
+        // Producers notify without the lock, so missed wake up only delays records until timeout
+        std::chrono::milliseconds sleep_time = (flush_target > flushed_position) ? std::chrono::milliseconds(1) : std::chrono::milliseconds(CGUI_LOG_FLUSH_INTERVAL);
+        writer_condition.wait_for(writer_lock, sleep_time, [&]() { return stop_requested || flush_target > target_position || !is_empty(); });
+        writer_sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief      Takes the oldest record out of the ring, only writer thread calls it.
+ *
+ * @param      log_record  The record.
+ *
+ * @return     False if ring is empty, or the oldest record is not published yet.
+ */
+bool CGUILogWriter::try_dequeue(CGUILogRecord& log_record)
+{
+    CGUILogSlot& log_slot = log_slots[dequeue_position & (CGUI_LOG_RING_SIZE - 1)];
+    if (log_slot.sequence.load(std::memory_order_acquire) != dequeue_position + 1)
+    {
+        return false;
+    }
+
+    log_record = std::move(log_slot.record);
+    log_slot.sequence.store(dequeue_position + CGUI_LOG_RING_SIZE, std::memory_order_release);
+    ++dequeue_position;
+
+    return true;
+}
+
+/**
+ * @brief      Checks whether the oldest record can be taken.
+ *
+ * @return     True if there is nothing to write.
+ */
+bool CGUILogWriter::is_empty()
+{
+    return log_slots[dequeue_position & (CGUI_LOG_RING_SIZE - 1)].sequence.load(std::memory_order_acquire) != dequeue_position + 1;
+}
+
+/**
+ * @brief      Appends formatted record to write buffer.
+ *
+ * @param[in]  log_record    The record.
+ * @param      write_buffer  Buffer of the batch.
+ */
+void CGUILogWriter::format_record(const CGUILogRecord& log_record, std::string& write_buffer)
+{
+    if (binary_log)
+    {
+        encode_record(log_record, write_buffer);
+        return;
+    }
+
+    // Tags are only decrypted once by writer thread
+    static thread_local const std::string error_tags[] = {__CGUI_OBF__("[ERROR]"), __CGUI_OBF__("[WARNING]"), __CGUI_OBF__("[MESSAGE]"),
+                                                          __CGUI_OBF__("[LOG]"), __CGUI_OBF__("[GLFW]"), __CGUI_OBF__("[UNDEFINED]")};
+    static thread_local const std::string no_tag;
+
+    const std::string* error_tag = &error_tags[5];
+    if (log_record.mode <= DEBUG_MODE_GLFW_CALLBACK)
+    {
+        error_tag = &error_tags[log_record.mode];
+    }
+    else if (log_record.mode == DEBUG_MODE_NONE)
+    {
+        error_tag = &no_tag;
+    }
+
+    // Prefix is "[stamp]   [TAG]          ", stamp is taken from cached second
+    log_clock.format(log_record.post_time, write_buffer);
+    write_buffer.append(3, ' ');
+    write_buffer += *error_tag;
+    write_buffer.append((error_tag->size() < 14) ? 15 - error_tag->size() : 1, ' ');
+
+    render_message(log_record, write_buffer);
+    write_buffer += '\n';
+}
+
+/**
+ * @brief      Appends record to write buffer in binary layout of CGUILogFormat.
+ *
+ *             Text record is stored as CGUI_LOG_TEXT with single string argument.
+ *
+ * @param[in]  log_record    The record.
+ * @param      write_buffer  Buffer of the batch.
+ */
+void CGUILogWriter::encode_record(const CGUILogRecord& log_record, std::string& write_buffer)
+{
+    CGUILogRecordHeader record_header;
+    record_header.post_time = log_record.post_time;
+    record_header.message_id = log_record.message_id;
+    record_header.mode = (uint8_t)log_record.mode;
+    record_header.argument_count = log_record.argument_count;
+
+    // Short text is already kept as structured record with one string argument
+    if (log_record.message_id != CGUI_LOG_TEXT || log_record.payload_size != 0)
+    {
+        record_header.payload_size = log_record.payload_size;
+        write_buffer.append(reinterpret_cast<const char*>(&record_header), sizeof(record_header));
+        write_buffer.append(reinterpret_cast<const char*>(log_record.payload.data()), log_record.payload_size);
+        return;
+    }
+
+    uint32_t message_length = (uint32_t)log_record.message.size();
+    record_header.argument_count = 1;
+    record_header.payload_size = 1 + (uint32_t)sizeof(message_length) + message_length;
+
+    write_buffer.append(reinterpret_cast<const char*>(&record_header), sizeof(record_header));
+    write_buffer += (char)CGUI_LOG_ARGUMENT_STRING;
+    write_buffer.append(reinterpret_cast<const char*>(&message_length), sizeof(message_length));
+    write_buffer += log_record.message;
+}
+
+/**
+ * @brief      Writes the batch to active segment and clears it.
+ *
+ *             Segment is rotated, once batch does not fit into it.
+ *
+ * @param      write_buffer  Buffer of the batch.
+ */
+void CGUILogWriter::write_batch(std::string& write_buffer)
+{
+    // Batch is kept whole, unless it does not fit into empty segment either
+    std::size_t header_size = binary_log ? sizeof(CGUILogFileHeader) : log_header.size();
+    if (write_buffer.size() > log_segment.get_free_size() && log_segment.get_size() > header_size)
+    {
+        rotate_segments();
+    }
+
+    std::size_t written_size = 0;
+    while (log_segment.is_open() && written_size < write_buffer.size())
+    {
+        written_size += log_segment.write(write_buffer.data() + written_size, write_buffer.size() - written_size);
+        if (written_size < write_buffer.size() && !rotate_segments())
+        {
+            break;
+        }
+    }
+
+    write_buffer.clear();
+}
+
+/**
+ * @brief      Creates active segment and writes its header.
+ *
+ *             Every segment starts with header, so it can be read alone.
+ *
+ * @return     False if segment can not be created.
+ */
+bool CGUILogWriter::open_segment()
+{
+    if (!log_segment.open(log_path, CGUI_LOG_SEGMENT_SIZE))
+    {
+        return false;
+    }
+
+    if (binary_log)
+    {
+        CGUILogFileHeader file_header;
+        log_segment.write(reinterpret_cast<const char*>(&file_header), sizeof(file_header));
+    }
+    else
+    {
+        log_segment.write(log_header.data(), log_header.size());
+    }
+
+    return true;
+}
+
+/**
+ * @brief      Moves active segment to the first rotated one and opens new active segment.
+ *
+ *             The oldest segment is removed, rotated segment is compressed by its own
+ *             thread, so writer gets back to the ring, once new segment is open.
+ *
+ * @return     False if new active segment can not be created.
+ */
+bool CGUILogWriter::rotate_segments()
+{
+    log_segment.close();
+
+    // Segments are only shifted, once previous one is compressed, it is done long before next rotation
+    if (compress_thread.joinable())
+    {
+        compress_thread.join();
+    }
+
+    std::error_code file_error;
+    for (std::size_t segment_index = CGUI_LOG_SEGMENT_COUNT - 1; segment_index > 0; --segment_index)
+    {
+        for (bool compressed : {false, true})
+        {
+            std::filesystem::path segment_path = get_segment_path(segment_index, compressed);
+            if (segment_index == CGUI_LOG_SEGMENT_COUNT - 1)
+            {
+                std::filesystem::remove(segment_path, file_error);
+            }
+            else if (std::filesystem::exists(segment_path, file_error))
+            {
+                std::filesystem::rename(segment_path, get_segment_path(segment_index + 1, compressed), file_error);
+            }
+        }
+    }
+
+    std::filesystem::rename(log_path, get_segment_path(1, false), file_error);
+
+    bool opened = open_segment();
+
+    #ifdef CGUI_LOG_COMPRESS
+        compress_thread = std::thread(&CGUILogWriter::compress_segment, this, get_segment_path(1, false));
+    #endif // CGUI_LOG_COMPRESS
+
+    return opened;
+}
+
+/**
+ * @brief      Gets path of the segment.
+ *
+ * @param[in]  segment_index  Index of the segment, 0 is active one.
+ * @param[in]  compressed     Path of compressed segment.
+ *
+ * @return     Path of the segment, <name>.<index><ext>[.gz].
+ */
+std::filesystem::path CGUILogWriter::get_segment_path(std::size_t segment_index, bool compressed)
+{
+    std::filesystem::path segment_path = log_path;
+    if (segment_index != 0)
+    {
+        segment_path.replace_filename(log_path.stem().string() + "." + std::to_string(segment_index) + log_path.extension().string());
+    }
+
+    if (compressed)
+    {
+        segment_path += ".gz";
+    }
+
+    return segment_path;
+}
+
+/**
+ * @brief      Compresses rotated segment into gzip file, source is removed.
+ *
+ * @param[in]  segment_path  Path of the segment.
+ *
+ * @return     False if segment is kept uncompressed.
+ */
+bool CGUILogWriter::compress_segment(const std::filesystem::path& segment_path)
+{
+    #ifdef CGUI_LOG_COMPRESS
+        std::FILE* segment_file = std::fopen(segment_path.string().c_str(), "rb");
+        if (segment_file == nullptr)
+        {
+            return false;
+        }
+
+        std::filesystem::path compressed_path = segment_path;
+        compressed_path += ".gz";
+
+        // Fast level, segment has to be compressed before next rotation
+        gzFile compressed_file = gzopen(compressed_path.string().c_str(), "wb1");
+        if (compressed_file == nullptr)
+        {
+            std::fclose(segment_file);
+            return false;
+        }
+
+        char read_buffer[65536];
+        bool compressed = true;
+        std::size_t read_size = 0;
+        while ((read_size = std::fread(read_buffer, 1, sizeof(read_buffer), segment_file)) > 0)
+        {
+            if (gzwrite(compressed_file, read_buffer, (unsigned int)read_size) != (int)read_size)
+            {
+                compressed = false;
+                break;
+            }
+        }
+
+        compressed = (gzclose(compressed_file) == Z_OK) && compressed;
+        std::fclose(segment_file);
+
+        std::error_code file_error;
+        std::filesystem::remove(compressed ? segment_path : compressed_path, file_error);
+        return compressed;
+    #else
+        (void)segment_path; // Workaround in order to fix [-Wunused-parameter]
+        return false;
+    #endif // CGUI_LOG_COMPRESS
+}
@@ -0,0 +1,177 @@
+/**
+ * @file       <CGUILogWriter.hpp>
+ * @brief      This header file implements CGUILogWriter class.
+ *
+ *             It is being used in order to write log records on background thread,
+ *             so threads, that post logs, never wait for the disk.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUILOGWRITER_HPP
+#define CGUILOGWRITER_HPP
+
+#include <condition_variable>
+#include <filesystem>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <array>
+#include <mutex>
+#include <ctime>
+
+#include "CGUILogFormat.hpp"
+#include "CGUILogClock.hpp"
+#include "CGUILogSegment.hpp"
+
+/**
+ * Log ring and batching settings, ring size has to be power of two.
+ */
+#define CGUI_LOG_RING_SIZE          4096
+#define CGUI_LOG_FLUSH_SIZE         65536   // Bytes
+#define CGUI_LOG_FLUSH_INTERVAL     200     // Milliseconds
+
+/**
+ * Log rotation settings, count includes active segment, both can be set by build.
+ */
+#ifndef CGUI_LOG_SEGMENT_SIZE
+    #define CGUI_LOG_SEGMENT_SIZE   8388608 // Bytes, active segment is allocated to it
+#endif // CGUI_LOG_SEGMENT_SIZE
+#ifndef CGUI_LOG_SEGMENT_COUNT
+    #define CGUI_LOG_SEGMENT_COUNT  8
+#endif // CGUI_LOG_SEGMENT_COUNT
+
+/**
+ * Record, that is posted by producer, it is formatted by writer thread.
+ *
+ * Long text records carry message, short text and structured records carry identifier and raw arguments.
+ */
+struct CGUILogRecord
+{
+    std::string     message;
+    uint64_t        post_time       = 0;            // CGUILogClock stamp, microseconds since epoch
+    std::size_t     mode            = 0;
+
+    uint16_t        message_id      = CGUI_LOG_TEXT;
+    uint8_t         argument_count  = 0;
+    uint32_t        payload_size    = 0;
+    std::array<uint8_t, CGUI_LOG_PAYLOAD_SIZE> payload;
+};
+
+/**
+ * Slot of log ring, sequence tells, whether slot is free for producer or full for writer.
+ */
+struct CGUILogSlot
+{
+    std::atomic<std::size_t>    sequence    = 0;
+    CGUILogRecord               record;
+};
+
+/**
+ * @brief      This class owns log file and background thread, that writes it.
+ *
+ *             Records are passed through bounded lock-free multi-producer ring, so posting
+ *             a record is a single compare and swap and a move of the message. Writer
+ *             keeps file open and writes records in batches, batch is flushed, once it is
+ *             big enough or old enough. Records, that do not fit into full ring, are
+ *             counted and reported instead of blocking producer.
+ *
+ *             File is written in segments of fixed size, full segment is renamed to
+ *             <name>.1<ext>, older ones are shifted and the oldest one is removed,
+ *             rotated segments are compressed by separate thread, if zlib is available.
+ */
+class CGUILogWriter
+{
+public:
+    CGUILogWriter();
+    CGUILogWriter(const CGUILogWriter&) = delete;
+    ~CGUILogWriter();
+
+    bool open(const std::filesystem::path& log_file_path, const std::string& log_header_arg, bool binary_log_arg = false);
+    bool is_open();
+
+    bool post(CGUILogRecord&& log_record);
+    void flush();
+    void stop();
+
+    static void stop_all();
+
+    static void render_message(const CGUILogRecord& log_record, std::string& output);
+
+private:
+    void write_thread();
+    bool try_dequeue(CGUILogRecord& log_record);
+    bool is_empty();
+
+    void format_record(const CGUILogRecord& log_record, std::string& write_buffer);
+    void encode_record(const CGUILogRecord& log_record, std::string& write_buffer);
+    void write_batch(std::string& write_buffer);
+
+    bool open_segment();
+    bool rotate_segments();
+    std::filesystem::path get_segment_path(std::size_t segment_index, bool compressed);
+    bool compress_segment(const std::filesystem::path& segment_path);
+
+private:
+    std::unique_ptr<CGUILogSlot[]>  log_slots;
+
+    /**
+     * Producers only touch enqueue position, writer only touches dequeue position.
+     */
+    alignas(64) std::atomic<std::size_t>    enqueue_position = 0;
+    alignas(64) std::size_t                 dequeue_position = 0;
+    alignas(64) std::atomic<std::size_t>    dropped_count    = 0;
+
+    /**
+     * Segments are only touched by writer thread, once it is started.
+     */
+    CGUILogSegment          log_segment;
+    std::filesystem::path   log_path;
+    std::string             log_header;
+    bool                    binary_log  = false;    // Records are written as CGUILogFormat records
+    std::atomic<bool>       log_opened  = false;
+
+    std::thread             writer_thread;
+    std::thread             compress_thread;        // Compresses rotated segment
+    CGUILogClock            log_clock;              // Only used by writer thread
+
+    /**
+     * Writer sleeps between batches, it is woken up by stop, flush or urgent record.
+     */
+    std::mutex                  writer_mutex;
+    std::condition_variable     writer_condition;
+    std::condition_variable     flushed_condition;
+    std::atomic<bool>           writer_sleeping     = false;
+    bool                        stop_requested      = false;
+    std::size_t                 flush_target        = 0;
+    std::size_t                 flushed_position    = 0;
+
+    /**
+     * Open writers, process exit does not wait for handlers, that still own them.
+     */
+    static inline std::mutex                    writers_mutex;
+    static inline std::vector<CGUILogWriter*>   open_writers;
+};
+
+#endif // CGUILOGWRITER_HPP
@@ -0,0 +1,169 @@
+#include "CGUILogFormat.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+/**
+ * @brief      Gets tag of the mode, same as text log uses.
+ *
+ * @param[in]  mode  The mode.
+ *
+ * @return     Tag of the mode.
+ */
+static const char* get_mode_tag(uint8_t mode)
+{
+	switch (mode)
+	{
+		case DEBUG_MODE_ERROR:          return "[ERROR]";
+		case DEBUG_MODE_WARNING:        return "[WARNING]";
+		case DEBUG_MODE_MESSAGE:        return "[MESSAGE]";
+		case DEBUG_MODE_LOG:            return "[LOG]";
+		case DEBUG_MODE_GLFW_CALLBACK:  return "[GLFW]";
+		case DEBUG_MODE_NONE:           return "";
+		default:                        return "[UNDEFINED]";
+	}
+}
+
+/**
+ * Usage: cgui_logdump <log.cgl> [max mode]
+ *
+ * Renders binary log to text, records with mode above max mode are skipped,
+ * so 1 prints only errors and warnings. Log is read from stdin for "-", so
+ * rotated segments are rendered with "zcat debug_log_default.1.cgl.gz | cgui_logdump -".
+ */
+int main(int argc, char const *argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: cgui_logdump <log.cgl> [max mode]\n";
+		return 1;
+	}
+
+	int max_mode = (argc > 2) ? std::atoi(argv[2]) : DEBUG_MODE_NONE;
+
+	std::vector<uint8_t> log_data;
+	if (std::string(argv[1]) == "-")
+	{
+		log_data.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+	}
+	else
+	{
+		std::ifstream log_file(argv[1], std::ios::in | std::ios::binary);
+		if (!log_file.is_open())
+		{
+			std::cerr << "Unable to open log: " << argv[1] << "\n";
+			return 1;
+		}
+
+		log_data.assign(std::istreambuf_iterator<char>(log_file), std::istreambuf_iterator<char>());
+	}
+
+	std::string output;
+	std::size_t record_count = 0;
+	std::size_t data_offset = 0;
+
+	while (data_offset < log_data.size())
+	{
+		// Every session, that appended to the file, starts with header
+		uint32_t record_magic = 0;
+		if (data_offset + sizeof(CGUILogFileHeader) <= log_data.size())
+		{
+			std::memcpy(&record_magic, log_data.data() + data_offset, sizeof(record_magic));
+		}
+
+		if (record_magic == CGUI_LOG_MAGIC)
+		{
+			CGUILogFileHeader file_header;
+			std::memcpy(&file_header, log_data.data() + data_offset, sizeof(file_header));
+			if (file_header.version != CGUI_LOG_VERSION)
+			{
+				std::cerr << "Unsupported log version: " << file_header.version << "\n";
+				return 1;
+			}
+
+			if (file_header.message_count > CGUI_LOG_MESSAGE_COUNT)
+			{
+				std::cerr << "Log has messages, that are newer than this decoder.\n";
+			}
+
+			data_offset += sizeof(file_header);
+			continue;
+		}
+
+		if (record_count == 0 && data_offset == 0)
+		{
+			std::cerr << "File is not a binary log: " << argv[1] << "\n";
+			return 1;
+		}
+
+		CGUILogRecordHeader record_header;
+		if (data_offset + sizeof(record_header) > log_data.size())
+		{
+			std::cerr << "Log is truncated at offset " << data_offset << "\n";
+			break;
+		}
+
+		std::memcpy(&record_header, log_data.data() + data_offset, sizeof(record_header));
+		data_offset += sizeof(record_header);
+
+		// Segment, that was not closed, keeps zero tail of its allocation
+		if (record_header.post_time == 0 && record_header.payload_size == 0)
+		{
+			break;
+		}
+
+		if (data_offset + record_header.payload_size > log_data.size())
+		{
+			std::cerr << "Log is truncated at offset " << data_offset << "\n";
+			break;
+		}
+
+		const uint8_t* payload = log_data.data() + data_offset;
+		data_offset += record_header.payload_size;
+		++record_count;
+
+		if (record_header.mode > max_mode && record_header.mode != DEBUG_MODE_NONE)
+		{
+			continue;
+		}
+
+		std::time_t post_time = (std::time_t)(record_header.post_time / 1000000);
+		std::tm time_struct = {};
+		#if defined(_WIN32) || defined(WIN32) || defined(__CYGWIN__) || defined(__MINGW32__) || defined(__BORLANDC__)
+			localtime_s(&time_struct, &post_time);
+		#else
+			localtime_r(&post_time, &time_struct);
+		#endif // Windows
+
+		char time_string[80];
+		char record_prefix[128];
+		std::snprintf(time_string, sizeof(time_string), "[%04d-%02d-%02d-%02d-%02d-%02d.%06u]", time_struct.tm_year + 1900, time_struct.tm_mon + 1,
+			time_struct.tm_mday, time_struct.tm_hour, time_struct.tm_min, time_struct.tm_sec, (unsigned int)(record_header.post_time % 1000000));
+		std::snprintf(record_prefix, sizeof(record_prefix), "%-31s%-14s ", time_string, get_mode_tag(record_header.mode));
+
+		output = record_prefix;
+
+		const char* message_format = cgui_log_message_format(record_header.message_id);
+		if (message_format == nullptr)
+		{
+			output += "[UNKNOWN MESSAGE " + std::to_string((unsigned int)record_header.message_id) + "]";
+		}
+		else if (!cgui_log_render(message_format, payload, record_header.payload_size, output))
+		{
+			output += " [DAMAGED ARGUMENTS]";
+		}
+
+		output += '\n';
+		std::fwrite(output.data(), 1, output.size(), stdout);
+	}
+
+	std::cerr << record_count << " records, " << log_data.size() << " bytes\n";
+	return 0;
+}
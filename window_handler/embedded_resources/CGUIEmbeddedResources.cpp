@@ -0,0 +1,68 @@
+/**
+ * @file       <CGUIEmbeddedResources.cpp>
+ * @brief      This source file implements CGUIEmbeddedResources class.
+ *
+ *             It is being used in order to get resources, that were embedded
+ *             into binary at build time, without any file I/O.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUIEmbeddedResources.hpp"
+
+/**
+ * @brief      Finds embedded resource.
+ *
+ * @param[in]  resource_name  File name of the resource.
+ *
+ * @return     The resource, nullptr if it was not embedded.
+ */
+const CGUIEmbeddedResource* CGUIEmbeddedResources::find(std::string_view resource_name)
+{
+    for (const CGUIEmbeddedResource& embedded_resource : get_resources())
+    {
+        if (embedded_resource.name == resource_name)
+        {
+            return &embedded_resource;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief      Gets data of embedded resource.
+ *
+ * @param[in]  resource_name  File name of the resource.
+ *
+ * @return     Data of the resource, empty if it was not embedded.
+ */
+std::string_view CGUIEmbeddedResources::get_data(std::string_view resource_name)
+{
+    const CGUIEmbeddedResource* embedded_resource = find(resource_name);
+    return (embedded_resource != nullptr) ? embedded_resource->data : std::string_view();
+}
+
+/**
+ * @brief      Gets every embedded resource.
+ *
+ * @return     Resources in order of their file names.
+ */
+std::span<const CGUIEmbeddedResource> CGUIEmbeddedResources::get_resources()
+{
+    return std::span<const CGUIEmbeddedResource>(cgui_embedded_resource_table, cgui_embedded_resource_count);
+}
@@ -0,0 +1,61 @@
+/**
+ * @file       <CGUIEmbeddedResources.hpp>
+ * @brief      This header file implements CGUIEmbeddedResources class.
+ *
+ *             It is being used in order to get resources, that were embedded
+ *             into binary at build time, without any file I/O.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUIEMBEDDEDRESOURCES_HPP
+#define CGUIEMBEDDEDRESOURCES_HPP
+
+#include <string_view>
+#include <cstddef>
+#include <span>
+
+/**
+ * Resource, embedded by cgui_embed_resources.cmake, data is followed by terminating zero.
+ */
+struct CGUIEmbeddedResource
+{
+    std::string_view    name;   // File name inside resources directory
+    std::string_view    data;
+};
+
+/**
+ * Table of resources, it is defined by generated source.
+ */
+extern const CGUIEmbeddedResource   cgui_embedded_resource_table[];
+extern const std::size_t            cgui_embedded_resource_count;
+
+/**
+ * @brief      This class implements lookup of embedded resources.
+ *
+ *             Resources are constexpr byte arrays in read-only data of the binary,
+ *             so they are never copied, allocated or read from disk.
+ */
+class CGUIEmbeddedResources
+{
+public:
+    static const CGUIEmbeddedResource* find(std::string_view resource_name);
+    static std::string_view get_data(std::string_view resource_name);
+    static std::span<const CGUIEmbeddedResource> get_resources();
+};
+
+#endif // CGUIEMBEDDEDRESOURCES_HPP
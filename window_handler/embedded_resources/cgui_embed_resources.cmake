@@ -0,0 +1,42 @@
+# Turns resource files into constexpr byte arrays, runs in script mode:
+#   cmake -DOUTPUT_FILE=<source> -DRESOURCE_DIRECTORY=<directory> -DRESOURCE_PATTERNS=<pattern|pattern> -P cgui_embed_resources.cmake
+
+string(REPLACE "|" ";" RESOURCE_PATTERNS "${RESOURCE_PATTERNS}")
+
+set(RESOURCE_GLOBS "")
+foreach(RESOURCE_PATTERN ${RESOURCE_PATTERNS})
+	list(APPEND RESOURCE_GLOBS ${RESOURCE_DIRECTORY}/${RESOURCE_PATTERN})
+endforeach()
+
+file(GLOB RESOURCE_FILES ${RESOURCE_GLOBS})
+list(SORT RESOURCE_FILES)
+
+set(GENERATED_ARRAYS "")
+set(GENERATED_TABLE "")
+set(RESOURCE_INDEX 0)
+
+# CMake regex has no counted repetition, so line of 16 bytes is spelled out
+string(REPEAT "0x[0-9a-f][0-9a-f]," 16 RESOURCE_LINE_PATTERN)
+
+foreach(RESOURCE_FILE ${RESOURCE_FILES})
+	get_filename_component(RESOURCE_NAME ${RESOURCE_FILE} NAME)
+	file(READ ${RESOURCE_FILE} RESOURCE_HEX HEX)
+
+	# Every byte becomes 0xNN, terminating zero lets data be used as C string
+	string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," RESOURCE_BYTES "${RESOURCE_HEX}")
+	string(REGEX REPLACE "(${RESOURCE_LINE_PATTERN})" "\\1\n    " RESOURCE_BYTES "${RESOURCE_BYTES}")
+
+	string(APPEND GENERATED_ARRAYS "// ${RESOURCE_NAME}\nstatic constexpr unsigned char cgui_resource_${RESOURCE_INDEX}[] =\n{\n    ${RESOURCE_BYTES}0x00\n};\n\n")
+	string(APPEND GENERATED_TABLE "    {\"${RESOURCE_NAME}\", std::string_view(reinterpret_cast<const char*>(cgui_resource_${RESOURCE_INDEX}), sizeof(cgui_resource_${RESOURCE_INDEX}) - 1)},\n")
+
+	math(EXPR RESOURCE_INDEX "${RESOURCE_INDEX} + 1")
+endforeach()
+
+if(RESOURCE_INDEX EQUAL 0)
+	message(FATAL_ERROR "No resources found in ${RESOURCE_DIRECTORY}")
+endif()
+
+set(GENERATED_SOURCE "// Generated by cgui_embed_resources.cmake from ${RESOURCE_DIRECTORY}, do not edit.\n#include \"CGUIEmbeddedResources.hpp\"\n\n${GENERATED_ARRAYS}const CGUIEmbeddedResource cgui_embedded_resource_table[] =\n{\n${GENERATED_TABLE}};\n\nconst std::size_t cgui_embedded_resource_count = ${RESOURCE_INDEX};\n")
+
+# Unchanged source is not rewritten, so nothing is rebuilt
+file(CONFIGURE OUTPUT ${OUTPUT_FILE} CONTENT "${GENERATED_SOURCE}" @ONLY)
@@ -0,0 +1,226 @@
+/**
+ * @file       <CGUIFileWatcher.cpp>
+ * @brief      This source file implements CGUIFileWatcher class.
+ *
+ *             It is being used in order to notice changes of resource files,
+ *             so they could be reloaded without restart.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUIFileWatcher.hpp"
+
+#include <algorithm>
+
+#if defined(__linux__)
+    #include <sys/inotify.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif // Linux
+
+/**
+ * @brief      Constructs a new file watcher.
+ */
+CGUIFileWatcher::CGUIFileWatcher()
+{
+    debug_handler = CGUIDebugHandler(main_debug_handler);
+}
+
+/**
+ * @brief      Destroys file watcher, watches are removed with descriptor.
+ */
+CGUIFileWatcher::~CGUIFileWatcher()
+{
+    #if defined(__linux__)
+        if (watch_descriptor != -1)
+        {
+            close(watch_descriptor);
+        }
+    #endif // Linux
+
+    watched_directories.clear();
+    watched_files.clear();
+}
+
+/**
+ * @brief      Starts watching file.
+ *
+ * @param[in]  file_path  Path of the file.
+ *
+ * @return     Status of the watch.
+ */
+bool CGUIFileWatcher::watch(const fs::path& file_path)
+{
+    std::lock_guard watch_lock(watch_mutex);
+
+    std::error_code path_error;
+    return add_watch(fs::absolute(file_path, path_error).lexically_normal());
+}
+
+/**
+ * @brief      Replaces watched files, files, that are already watched, keep their watches.
+ *
+ *             Directories, that no longer contain watched files, stop being watched.
+ *
+ * @param[in]  file_paths  Paths of the files.
+ *
+ * @return     True if every file is watched.
+ */
+bool CGUIFileWatcher::watch_files(const std::vector<fs::path>& file_paths)
+{
+    std::lock_guard watch_lock(watch_mutex);
+
+    std::unordered_set<std::string> new_files;
+    bool is_watched = true;
+
+    for (const fs::path& file_path : file_paths)
+    {
+        std::error_code path_error;
+        fs::path absolute_path = fs::absolute(file_path, path_error).lexically_normal();
+
+        if (watched_files.find(absolute_path.string()) == watched_files.end() && !add_watch(absolute_path))
+        {
+            is_watched = false;
+            continue;
+        }
+        new_files.insert(absolute_path.string());
+    }
+
+    #if defined(__linux__)
+        for (auto directory_iterator = watched_directories.begin(); directory_iterator != watched_directories.end();)
+        {
+            bool is_used = std::any_of(new_files.begin(), new_files.end(), [&directory_iterator](const std::string& file_path){ return fs::path(file_path).parent_path() == directory_iterator->second; });
+            if (is_used)
+            {
+                ++directory_iterator;
+                continue;
+            }
+
+            inotify_rm_watch(watch_descriptor, directory_iterator->first);
+            directory_iterator = watched_directories.erase(directory_iterator);
+        }
+    #endif // Linux
+
+    watched_files.swap(new_files);
+    return is_watched;
+}
+
+/**
+ * @brief      Reads pending changes without waiting.
+ *
+ * @return     Watched files, that have changed since the last poll, every file once.
+ */
+std::vector<fs::path> CGUIFileWatcher::poll()
+{
+    std::lock_guard watch_lock(watch_mutex);
+    std::vector<fs::path> changed_files;
+
+    #if defined(__linux__)
+        if (watch_descriptor == -1)
+        {
+            return changed_files;
+        }
+
+        std::unordered_set<std::string> reported_files;
+        alignas(struct inotify_event) char event_buffer[4096];
+
+        while (true)
+        {
+            ssize_t read_size = read(watch_descriptor, event_buffer, sizeof(event_buffer));
+            if (read_size <= 0)
+            {
+                break;
+            }
+
+            for (ssize_t event_offset = 0; event_offset < read_size;)
+            {
+                const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(event_buffer + event_offset);
+                event_offset += (ssize_t)(sizeof(struct inotify_event) + event->len);
+
+                auto directory_iterator = watched_directories.find(event->wd);
+                if (event->len == 0 || directory_iterator == watched_directories.end())
+                {
+                    continue;
+                }
+
+                std::string file_path = (directory_iterator->second / event->name).string();
+                if (watched_files.find(file_path) != watched_files.end() && reported_files.insert(file_path).second)
+                {
+                    changed_files.emplace_back(file_path);
+                }
+            }
+        }
+    #endif // Linux
+
+    return changed_files;
+}
+
+/**
+ * @brief      Checks whether any file is watched.
+ *
+ * @return     True if poll can report changes.
+ */
+bool CGUIFileWatcher::is_active()
+{
+    std::lock_guard watch_lock(watch_mutex);
+    return !watched_files.empty();
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Starts watching file, watch mutex has to be locked.
+ *
+ * @param[in]  absolute_path  Normalized absolute path of the file.
+ *
+ * @return     Status of the watch.
+ */
+bool CGUIFileWatcher::add_watch(const fs::path& absolute_path)
+{
+    #if defined(__linux__)
+        if (watch_descriptor == -1)
+        {
+            watch_descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (watch_descriptor == -1)
+            {
+                debug_handler.post_log(std::string("Unable to initialize inotify, error: ") + std::to_string(errno), DEBUG_MODE_ERROR);
+                return false;
+            }
+        }
+
+        fs::path directory_path = absolute_path.parent_path();
+
+        int directory_watch = inotify_add_watch(watch_descriptor, directory_path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (directory_watch == -1)
+        {
+            debug_handler.post_log(std::string("Unable to watch directory: ") + directory_path.string(), DEBUG_MODE_ERROR);
+            return false;
+        }
+
+        // Same directory gives the same watch
+        watched_directories[directory_watch] = directory_path;
+        watched_files.insert(absolute_path.string());
+
+        CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, std::string("File is being watched: ") + absolute_path.string());
+        return true;
+    #else
+        debug_handler.post_log(std::string("File watching is not supported on this platform: ") + absolute_path.string(), DEBUG_MODE_WARNING);
+        return false;
+    #endif // Linux
+}
@@ -0,0 +1,77 @@
+/**
+ * @file       <CGUIFileWatcher.hpp>
+ * @brief      This header file implements CGUIFileWatcher class.
+ *
+ *             It is being used in order to notice changes of resource files,
+ *             so they could be reloaded without restart.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUIFILEWATCHER_HPP
+#define CGUIFILEWATCHER_HPP
+
+#include "../debug_handler/CGUIDebugHandler.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <string>
+#include <mutex>
+
+/**
+ * Interval in seconds, in which event thread checks watched files.
+ */
+#define CGUI_WATCH_INTERVAL 0.1
+
+/**
+ * @brief      This class implements watcher of files, based on inotify.
+ *
+ *             Parent directories of files are watched instead of files themselves, since
+ *             most editors save by writing new file and renaming it over the old one, which
+ *             would silently drop watch of the file. Only finished writes and renames are
+ *             reported, so file is never read half written. Descriptor is non-blocking and
+ *             is polled by the event thread, watched files can be replaced by any thread.
+ *             On other platforms watcher is inactive.
+ */
+class CGUIFileWatcher
+{
+public:
+    CGUIFileWatcher();
+    CGUIFileWatcher(const CGUIFileWatcher&) = delete;
+    ~CGUIFileWatcher();
+
+    bool watch(const fs::path& file_path);
+    bool watch_files(const std::vector<fs::path>& file_paths);
+    std::vector<fs::path> poll();
+
+    bool is_active();
+
+private:
+    bool add_watch(const fs::path& absolute_path);
+
+private:
+    int watch_descriptor = -1;
+
+    std::unordered_map<int, fs::path>   watched_directories;
+    std::unordered_set<std::string>     watched_files;
+    std::mutex                          watch_mutex;
+
+    CGUIDebugHandler debug_handler = CGUIDebugHandler(false);
+};
+
+#endif // CGUIFILEWATCHER_HPP
@@ -0,0 +1,1113 @@
+/**
+ * @file       <CGUIFrameCapture.cpp>
+ * @brief      This source file implements CGUIFrameCapture class.
+ *
+ *             It is being used in order to record GL command stream of several
+ *             frames into a file, that can be replayed and profiled offline.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUIFrameCapture.hpp"
+
+#include <type_traits>
+#include <algorithm>
+#include <utility>
+#include <chrono>
+#include <tuple>
+
+/**
+ * Main frame capture, that owns the installed wrappers.
+ */
+CGUIFrameCapture main_frame_capture;
+
+/**
+ * Set while wrapper is running, so GL calls made by capture itself are never recorded.
+ */
+static thread_local bool cgui_capture_nested = false;
+
+/**
+ * @brief      Wrapper of one glad function pointer.
+ *
+ * @tparam     record    Captured function.
+ * @tparam     Function  Type of glad function pointer.
+ */
+template<CGUICaptureRecord record, typename Function>
+struct CGUICaptureHook;
+
+template<CGUICaptureRecord record, typename Result, typename... Arguments>
+struct CGUICaptureHook<record, Result (GLAD_API_PTR *)(Arguments...)>
+{
+    static inline Result (GLAD_API_PTR *original)(Arguments...) = nullptr;
+
+    /**
+     * Functions, that update shader and framebuffer registry even without capture.
+     */
+    static constexpr bool tracked = record == CGUI_CAPTURE_CALL_ShaderSource || record == CGUI_CAPTURE_CALL_DeleteShader ||
+                                    record == CGUI_CAPTURE_CALL_LinkProgram || record == CGUI_CAPTURE_CALL_DeleteProgram ||
+                                    record == CGUI_CAPTURE_CALL_GenFramebuffers || record == CGUI_CAPTURE_CALL_DeleteFramebuffers;
+
+    static Result GLAD_API_PTR call(Arguments... arguments)
+    {
+        if (!tracked && !main_frame_capture.is_capturing())
+        {
+            return original(arguments...);
+        }
+
+        bool record_call = main_frame_capture.is_recording();
+        bool was_nested = cgui_capture_nested;
+        cgui_capture_nested = true;
+
+        if (record_call)
+        {
+            main_frame_capture.write_value((uint16_t)record);
+            write_arguments(std::index_sequence_for<Arguments...>{}, arguments...);
+
+            // Mapped memory is gone after the call
+            if constexpr (record == CGUI_CAPTURE_CALL_UnmapBuffer)
+            {
+                main_frame_capture.write_buffer_unmap(arguments...);
+            }
+        }
+
+        track_before(arguments...);
+
+        if constexpr (std::is_void_v<Result>)
+        {
+            original(arguments...);
+
+            track_after(arguments...);
+            if (record_call)
+            {
+                write_payload(arguments...);
+            }
+            cgui_capture_nested = was_nested;
+        }
+        else
+        {
+            Result result = original(arguments...);
+
+            if (record_call)
+            {
+                if constexpr (record == CGUI_CAPTURE_CALL_MapBufferRange)
+                {
+                    auto [target, offset, length, access] = std::tie(arguments...);
+                    main_frame_capture.track_buffer_map(target, result, length, access);
+                }
+                main_frame_capture.write_value(result);
+            }
+            cgui_capture_nested = was_nested;
+            return result;
+        }
+    }
+
+    template<std::size_t... indices>
+    static void write_arguments(std::index_sequence<indices...>, Arguments... arguments)
+    {
+        (write_argument<indices>(arguments), ...);
+    }
+
+    template<std::size_t index, typename Argument>
+    static void write_argument(Argument argument)
+    {
+        constexpr CGUICaptureArgument kind = cgui_capture_signature(record).arguments[index];
+
+        if constexpr (kind == CGUICaptureArgument::STRING)
+        {
+            main_frame_capture.write_string(argument);
+        }
+        else if constexpr (kind != CGUICaptureArgument::PAYLOAD && kind != CGUICaptureArgument::OUTPUT)
+        {
+            main_frame_capture.write_value(argument);
+        }
+    }
+
+    static void track_before(Arguments... arguments)
+    {
+        if constexpr (record == CGUI_CAPTURE_CALL_ShaderSource)
+        {
+            main_frame_capture.track_shader_source(arguments...);
+        }
+        else if constexpr (record == CGUI_CAPTURE_CALL_DeleteShader)
+        {
+            main_frame_capture.track_shader_delete(arguments...);
+        }
+        else if constexpr (record == CGUI_CAPTURE_CALL_DeleteProgram)
+        {
+            main_frame_capture.track_program_delete(arguments...);
+        }
+        else if constexpr (record == CGUI_CAPTURE_CALL_DeleteFramebuffers)
+        {
+            main_frame_capture.track_framebuffers(arguments..., false);
+        }
+        else
+        {
+            ((void)arguments, ...);
+        }
+    }
+
+    static void track_after(Arguments... arguments)
+    {
+        if constexpr (record == CGUI_CAPTURE_CALL_LinkProgram)
+        {
+            main_frame_capture.track_program_link(arguments...);
+        }
+        else if constexpr (record == CGUI_CAPTURE_CALL_GenFramebuffers)
+        {
+            main_frame_capture.track_framebuffers(arguments..., true);
+        }
+        else
+        {
+            ((void)arguments, ...);
+        }
+    }
+
+    static void write_payload(Arguments... arguments)
+    {
+        if constexpr (record == CGUI_CAPTURE_CALL_BufferData)
+        {
+            auto [target, size, data, usage] = std::tie(arguments...);
+            main_frame_capture.write_value((uint8_t)(data != nullptr));
+            if (data != nullptr)
+            {
+                main_frame_capture.write_blob(data, (std::size_t)size);
+            }
+        }
+        else if constexpr (record == CGUI_CAPTURE_CALL_BufferSubData)
+        {
+            auto [target, offset, size, data] = std::tie(arguments...);
+            main_frame_capture.write_blob(data, (std::size_t)size);
+        }
+        else if constexpr (record == CGUI_CAPTURE_CALL_GenBuffers || record == CGUI_CAPTURE_CALL_GenFramebuffers ||
+                           record == CGUI_CAPTURE_CALL_GenRenderbuffers || record == CGUI_CAPTURE_CALL_GenTextures ||
+                           record == CGUI_CAPTURE_CALL_GenVertexArrays || record == CGUI_CAPTURE_CALL_DeleteBuffers ||
+                           record == CGUI_CAPTURE_CALL_DeleteFramebuffers || record == CGUI_CAPTURE_CALL_DeleteRenderbuffers ||
+                           record == CGUI_CAPTURE_CALL_DeleteTextures || record == CGUI_CAPTURE_CALL_DeleteVertexArrays)
+        {
+            auto [count, object_ids] = std::tie(arguments...);
+            main_frame_capture.write_blob(object_ids, (std::size_t)std::max(count, 0) * sizeof(GLuint));
+        }
+        else if constexpr (record == CGUI_CAPTURE_CALL_ShaderSource)
+        {
+            auto [shader_id, count, strings, lengths] = std::tie(arguments...);
+            for (GLsizei string_index = 0; string_index < count; ++string_index)
+            {
+                std::size_t length = (lengths != nullptr && lengths[string_index] >= 0) ? (std::size_t)lengths[string_index] : std::strlen(strings[string_index]);
+                main_frame_capture.write_blob(strings[string_index], length);
+            }
+        }
+        else if constexpr (record == CGUI_CAPTURE_CALL_TexImage2D)
+        {
+            auto [target, level, internal_format, width, height, border, format, type, pixels] = std::tie(arguments...);
+            main_frame_capture.write_pixels(width, height, format, type, pixels);
+        }
+        else if constexpr (record == CGUI_CAPTURE_CALL_TexSubImage2D)
+        {
+            auto [target, level, x_offset, y_offset, width, height, format, type, pixels] = std::tie(arguments...);
+            main_frame_capture.write_pixels(width, height, format, type, pixels);
+        }
+        else if constexpr (record == CGUI_CAPTURE_CALL_UniformMatrix4fv)
+        {
+            auto [location, count, transpose, value] = std::tie(arguments...);
+            main_frame_capture.write_blob(value, (std::size_t)std::max(count, 0) * 16 * sizeof(GLfloat));
+        }
+        else
+        {
+            ((void)arguments, ...);
+        }
+    }
+};
+
+/**
+ * @brief      Constructs a new frame capture.
+ */
+CGUIFrameCapture::CGUIFrameCapture()
+{
+}
+
+/**
+ * @brief      Destroys frame capture.
+ */
+CGUIFrameCapture::~CGUIFrameCapture()
+{
+    stream.clear();
+}
+
+/**
+ * @brief      Replaces glad function pointers with capture wrappers.
+ *
+ *             Has to be called once, after GL is loaded and before any other thread uses GL.
+ */
+void CGUIFrameCapture::install()
+{
+    if (installed)
+    {
+        return;
+    }
+
+    #define CGUI_CAPTURE_INSTALL(name, ...) \
+        if (glad_gl##name != nullptr) \
+        { \
+            CGUICaptureHook<CGUI_CAPTURE_CALL_##name, decltype(glad_gl##name)>::original = glad_gl##name; \
+            glad_gl##name = &CGUICaptureHook<CGUI_CAPTURE_CALL_##name, decltype(glad_gl##name)>::call; \
+        }
+    CGUI_CAPTURE_FUNCTIONS(CGUI_CAPTURE_INSTALL)
+    #undef CGUI_CAPTURE_INSTALL
+
+    installed = true;
+    CGUI_POST_LOG(main_debug_handler, DEBUG_MODE_LOG, __CGUI_OBF__("Frame capture hooks have been installed."));
+}
+
+/**
+ * @brief      Requests capture of the next frames, can be called from any thread.
+ *
+ * @param[in]  frame_count  Amount of frames to capture.
+ */
+void CGUIFrameCapture::request_capture(uint32_t frame_count)
+{
+    if (!installed)
+    {
+        main_debug_handler.post_log(__CGUI_OBF__("Frame capture is not installed."), DEBUG_MODE_ERROR);
+        return;
+    }
+    if (recording.load())
+    {
+        main_debug_handler.post_log(__CGUI_OBF__("Frame capture is already running."), DEBUG_MODE_WARNING);
+        return;
+    }
+
+    frame_count = std::max<uint32_t>(frame_count, 1);
+    requested_frames.store(frame_count);
+    CGUI_POST_RECORD(main_debug_handler, CGUI_LOG_CAPTURE_REQUEST, frame_count);
+}
+
+/**
+ * @brief      Starts requested capture, has to be called from render thread before frame is recorded.
+ *
+ * @param[in]  framebuffer_size  Size of the default framebuffer.
+ */
+void CGUIFrameCapture::begin_frame(glm::ivec2 framebuffer_size)
+{
+    if (!recording.load() && requested_frames.load() != 0)
+    {
+        start_capture(framebuffer_size);
+    }
+}
+
+/**
+ * @brief      Ends recorded frame, has to be called from render thread after buffers are swapped.
+ */
+void CGUIFrameCapture::end_frame()
+{
+    if (!recording.load())
+    {
+        return;
+    }
+
+    begin_record(CGUI_CAPTURE_FRAME_END);
+    captured_frames++;
+
+    if (--remaining_frames == 0)
+    {
+        stop_capture();
+    }
+}
+
+/**
+ * @brief      Checks if capture is running on any thread.
+ *
+ * @return     Capture state.
+ */
+bool CGUIFrameCapture::is_capturing()
+{
+    return recording.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief      Checks if call of current thread has to be recorded.
+ *
+ * @return     True for calls of render thread during capture, that are not made by capture itself.
+ */
+bool CGUIFrameCapture::is_recording()
+{
+    return recording.load(std::memory_order_acquire) && !cgui_capture_nested && std::this_thread::get_id() == recording_thread.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief      Appends raw data to the stream.
+ *
+ * @param[in]  data  Data to append.
+ * @param[in]  size  Size of the data.
+ */
+void CGUIFrameCapture::write_data(const void* data, std::size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    stream.insert(stream.end(), bytes, bytes + size);
+}
+
+/**
+ * @brief      Appends data with its size to the stream.
+ *
+ * @param[in]  data  Data to append, can be nullptr if size is 0.
+ * @param[in]  size  Size of the data.
+ */
+void CGUIFrameCapture::write_blob(const void* data, std::size_t size)
+{
+    write_value((uint32_t)size);
+    if (size != 0)
+    {
+        write_data(data, size);
+    }
+}
+
+/**
+ * @brief      Appends null terminated string with its length to the stream.
+ *
+ * @param[in]  string  String to append, can be nullptr.
+ */
+void CGUIFrameCapture::write_string(const char* string)
+{
+    write_blob(string, (string != nullptr) ? std::strlen(string) : 0);
+}
+
+/**
+ * @brief      Keeps shader source, so it can be stored when program is linked.
+ *
+ * @param[in]  shader_id  Shader.
+ * @param[in]  count      Amount of strings.
+ * @param[in]  strings    Source strings.
+ * @param[in]  lengths    Lengths of strings, nullptr if they are null terminated.
+ */
+void CGUIFrameCapture::track_shader_source(GLuint shader_id, GLsizei count, const GLchar* const* strings, const GLint* lengths)
+{
+    std::string source;
+    for (GLsizei string_index = 0; string_index < count; ++string_index)
+    {
+        if (lengths != nullptr && lengths[string_index] >= 0)
+        {
+            source.append(strings[string_index], (std::size_t)lengths[string_index]);
+        }
+        else
+        {
+            source.append(strings[string_index]);
+        }
+    }
+
+    std::lock_guard registry_lock(registry_mutex);
+    shader_sources[shader_id] = std::move(source);
+}
+
+/**
+ * @brief      Forgets source of deleted shader.
+ *
+ * @param[in]  shader_id  Shader.
+ */
+void CGUIFrameCapture::track_shader_delete(GLuint shader_id)
+{
+    std::lock_guard registry_lock(registry_mutex);
+    shader_sources.erase(shader_id);
+}
+
+/**
+ * @brief      Stores sources of shaders, that are attached to linked program.
+ *
+ * @param[in]  program_id  Linked program.
+ */
+void CGUIFrameCapture::track_program_link(GLuint program_id)
+{
+    GLuint shader_ids[8];
+    GLsizei shader_count = 0;
+    glGetAttachedShaders(program_id, 8, &shader_count, shader_ids);
+
+    std::vector<CGUIShaderStage> stages;
+    for (GLsizei shader_index = 0; shader_index < shader_count; ++shader_index)
+    {
+        GLint shader_type = GL_NONE;
+        glGetShaderiv(shader_ids[shader_index], GL_SHADER_TYPE, &shader_type);
+
+        std::lock_guard registry_lock(registry_mutex);
+        auto source_iterator = shader_sources.find(shader_ids[shader_index]);
+        if (source_iterator != shader_sources.end())
+        {
+            stages.push_back({(GLenum)shader_type, source_iterator->second});
+        }
+    }
+
+    std::lock_guard registry_lock(registry_mutex);
+    program_sources[program_id] = std::move(stages);
+}
+
+/**
+ * @brief      Stores source of program stage, when program was not linked from sources.
+ *
+ * @param[in]  program_id   Program.
+ * @param[in]  shader_type  Stage of the source.
+ * @param[in]  source       Source of the stage.
+ */
+void CGUIFrameCapture::track_program_stage(GLuint program_id, GLenum shader_type, const std::string& source)
+{
+    std::lock_guard registry_lock(registry_mutex);
+    program_sources[program_id].push_back({shader_type, source});
+}
+
+/**
+ * @brief      Forgets sources of deleted program.
+ *
+ * @param[in]  program_id  Program.
+ */
+void CGUIFrameCapture::track_program_delete(GLuint program_id)
+{
+    std::lock_guard registry_lock(registry_mutex);
+    program_sources.erase(program_id);
+}
+
+/**
+ * @brief      Tracks framebuffer names, since they are not registered in memory tracker.
+ *
+ * @param[in]  count            Amount of framebuffers.
+ * @param[in]  framebuffer_ids  Framebuffers.
+ * @param[in]  created          True for created framebuffers, false for deleted ones.
+ */
+void CGUIFrameCapture::track_framebuffers(GLsizei count, const GLuint* framebuffer_ids_arg, bool created)
+{
+    std::lock_guard registry_lock(registry_mutex);
+    for (GLsizei framebuffer_index = 0; framebuffer_index < count; ++framebuffer_index)
+    {
+        if (created)
+        {
+            framebuffer_ids.insert(framebuffer_ids_arg[framebuffer_index]);
+        }
+        else
+        {
+            framebuffer_ids.erase(framebuffer_ids_arg[framebuffer_index]);
+        }
+    }
+}
+
+/**
+ * @brief      Remembers mapped range of recorded map call.
+ *
+ * @param[in]  target       Buffer target.
+ * @param[in]  mapped_data  Mapped memory.
+ * @param[in]  length       Length of the range.
+ * @param[in]  access       Access flags.
+ */
+void CGUIFrameCapture::track_buffer_map(GLenum target, void* mapped_data, GLsizeiptr length, GLbitfield access)
+{
+    mapped_ranges[target] = {mapped_data, length, access};
+}
+
+/**
+ * @brief      Stores content of written mapped range, right before it is unmapped.
+ *
+ * @param[in]  target  Buffer target.
+ */
+void CGUIFrameCapture::write_buffer_unmap(GLenum target)
+{
+    auto range_iterator = mapped_ranges.find(target);
+    bool has_data = range_iterator != mapped_ranges.end() && range_iterator->second.mapped_data != nullptr && (range_iterator->second.access & GL_MAP_WRITE_BIT);
+
+    write_value((uint8_t)has_data);
+    if (has_data)
+    {
+        write_blob(range_iterator->second.mapped_data, (std::size_t)range_iterator->second.length);
+    }
+
+    if (range_iterator != mapped_ranges.end())
+    {
+        mapped_ranges.erase(range_iterator);
+    }
+}
+
+/**
+ * @brief      Stores pixels of texture upload.
+ *
+ * @param[in]  width   Width of the image.
+ * @param[in]  height  Height of the image.
+ * @param[in]  format  Pixel format.
+ * @param[in]  type    Pixel type.
+ * @param[in]  pixels  Client memory or offset into bound pixel unpack buffer.
+ */
+void CGUIFrameCapture::write_pixels(GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+{
+    GLint unpack_buffer = 0;
+    glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &unpack_buffer);
+
+    if (unpack_buffer != 0)
+    {
+        write_value((uint8_t)CGUI_CAPTURE_PIXELS_OFFSET);
+        write_value((uint64_t)(uintptr_t)pixels);
+        return;
+    }
+    if (pixels == nullptr)
+    {
+        write_value((uint8_t)CGUI_CAPTURE_PIXELS_NONE);
+        return;
+    }
+
+    // Whole unpack footprint is stored, so replayed pixel store state reads it the same way
+    GLint row_length = 0, alignment = 4;
+    glGetIntegerv(GL_UNPACK_ROW_LENGTH, &row_length);
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+
+    std::size_t pixel_size = get_pixel_size(format, type);
+    std::size_t row_size = ((std::size_t)((row_length > 0) ? row_length : width) * pixel_size + alignment - 1) / alignment * alignment;
+    std::size_t data_size = (width > 0 && height > 0) ? row_size * (height - 1) + (std::size_t)width * pixel_size : 0;
+
+    write_value((uint8_t)CGUI_CAPTURE_PIXELS_DATA);
+    write_blob(pixels, data_size);
+}
+
+/**
+ * @brief      Gets size of one pixel in client memory.
+ *
+ * @param[in]  format  Pixel format.
+ * @param[in]  type    Pixel type.
+ *
+ * @return     Size in bytes.
+ */
+std::size_t CGUIFrameCapture::get_pixel_size(GLenum format, GLenum type)
+{
+    switch (type)
+    {
+        case GL_UNSIGNED_INT_8_8_8_8:
+        case GL_UNSIGNED_INT_8_8_8_8_REV:
+        case GL_UNSIGNED_INT_2_10_10_10_REV:
+        case GL_UNSIGNED_INT_24_8:
+            return 4;
+        case GL_UNSIGNED_SHORT_5_6_5:
+        case GL_UNSIGNED_SHORT_4_4_4_4:
+        case GL_UNSIGNED_SHORT_5_5_5_1:
+            return 2;
+        default:
+            break;
+    }
+
+    std::size_t component_size;
+    switch (type)
+    {
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:
+        case GL_HALF_FLOAT:
+            component_size = 2;
+            break;
+        case GL_UNSIGNED_INT:
+        case GL_INT:
+        case GL_FLOAT:
+            component_size = 4;
+            break;
+        default:
+            component_size = 1;
+            break;
+    }
+
+    switch (format)
+    {
+        case GL_RG:
+        case GL_RG_INTEGER:
+            return component_size * 2;
+        case GL_RGB:
+        case GL_BGR:
+        case GL_RGB_INTEGER:
+            return component_size * 3;
+        case GL_RGBA:
+        case GL_BGRA:
+        case GL_RGBA_INTEGER:
+            return component_size * 4;
+        default:
+            return component_size;
+    }
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Snapshots context and starts recording calls of current thread.
+ *
+ * @param[in]  framebuffer_size  Size of the default framebuffer.
+ */
+void CGUIFrameCapture::start_capture(glm::ivec2 framebuffer_size)
+{
+    remaining_frames = requested_frames.exchange(0);
+    captured_frames = 0;
+
+    header = CGUICaptureHeader();
+    header.framebuffer_width = framebuffer_size.x;
+    header.framebuffer_height = framebuffer_size.y;
+
+    stream.clear();
+    stream.reserve(16 * 1024 * 1024);
+    mapped_ranges.clear();
+
+    write_string(reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    write_string(reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+    // Objects are restored in dependency order: storage first, then containers, then bindings
+    snapshot_buffers();
+    snapshot_textures();
+    snapshot_renderbuffers();
+    snapshot_programs();
+    snapshot_vertex_arrays();
+    snapshot_framebuffers();
+    snapshot_state();
+
+    // Hooks of other threads, like uploader, see the thread before they see capture running
+    recording_thread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    recording.store(true, std::memory_order_release);
+
+    main_debug_handler.post_log(std::string(__CGUI_OBF__("Frame capture has been started, snapshot size: ")) + std::to_string(stream.size()) + __CGUI_OBF__(" bytes."), DEBUG_MODE_MESSAGE);
+}
+
+/**
+ * @brief      Stops recording and writes capture to a file.
+ */
+void CGUIFrameCapture::stop_capture()
+{
+    recording.store(false);
+    mapped_ranges.clear();
+
+    header.frame_count = captured_frames;
+
+    fs::path capture_path = get_capture_path();
+    std::ofstream capture_file(capture_path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!capture_file.good())
+    {
+        main_debug_handler.post_log(std::string(__CGUI_OBF__("Unable to write frame capture: ")) + capture_path.string(), DEBUG_MODE_ERROR);
+    }
+    else
+    {
+        capture_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        capture_file.write(reinterpret_cast<const char*>(stream.data()), (std::streamsize)stream.size());
+
+        main_debug_handler.post_log(std::string(__CGUI_OBF__("Frame capture of ")) + std::to_string(captured_frames) + __CGUI_OBF__(" frames has been written to: ") +
+                                    capture_path.string() + __CGUI_OBF__(" (") + std::to_string(stream.size() + sizeof(header)) + __CGUI_OBF__(" bytes)."), DEBUG_MODE_MESSAGE);
+    }
+
+    stream.clear();
+    stream.shrink_to_fit();
+}
+
+/**
+ * @brief      Stores size, usage and content of every buffer.
+ */
+void CGUIFrameCapture::snapshot_buffers()
+{
+    GLint previous_buffer = 0;
+    glGetIntegerv(GL_COPY_READ_BUFFER_BINDING, &previous_buffer);
+
+    std::vector<uint8_t> data;
+    for (const CGUIMemoryRecord& record : main_memory_tracker.get_records(CGUI_MEMORY_BUFFER))
+    {
+        if (glIsBuffer(record.object_id) != GL_TRUE)
+        {
+            continue;
+        }
+
+        GLint64 size = 0;
+        GLint usage = GL_STATIC_DRAW, mapped = GL_FALSE;
+
+        glBindBuffer(GL_COPY_READ_BUFFER, record.object_id);
+        glGetBufferParameteri64v(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+        glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_USAGE, &usage);
+        glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_MAPPED, &mapped);
+
+        // Content of mapped buffers can not be read, they are restored uninitialized
+        data.resize((size > 0 && mapped == GL_FALSE) ? (std::size_t)size : 0);
+        if (!data.empty())
+        {
+            glGetBufferSubData(GL_COPY_READ_BUFFER, 0, size, data.data());
+        }
+
+        begin_record(CGUI_CAPTURE_SNAPSHOT_BUFFER);
+        write_value(record.object_id);
+        write_value((uint64_t)size);
+        write_value((GLenum)usage);
+        write_blob(data.data(), data.size());
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, previous_buffer);
+}
+
+/**
+ * @brief      Stores format, parameters and level 0 of every 2D texture as RGBA8.
+ */
+void CGUIFrameCapture::snapshot_textures()
+{
+    GLint previous_texture = 0, previous_pack_alignment = 4, previous_pack_buffer = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous_texture);
+    glGetIntegerv(GL_PACK_ALIGNMENT, &previous_pack_alignment);
+    glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &previous_pack_buffer);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    std::vector<uint8_t> data;
+    for (const CGUIMemoryRecord& record : main_memory_tracker.get_records(CGUI_MEMORY_TEXTURE))
+    {
+        if (glIsTexture(record.object_id) != GL_TRUE)
+        {
+            continue;
+        }
+
+        GLint parameters[7] = {0, 0, GL_RGBA8, GL_LINEAR, GL_LINEAR, GL_REPEAT, GL_REPEAT};
+
+        glBindTexture(GL_TEXTURE_2D, record.object_id);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &parameters[0]);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &parameters[1]);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &parameters[2]);
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &parameters[3]);
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, &parameters[4]);
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, &parameters[5]);
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, &parameters[6]);
+
+        data.resize((std::size_t)std::max(parameters[0], 0) * (std::size_t)std::max(parameters[1], 0) * 4);
+        if (!data.empty())
+        {
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+        }
+
+        begin_record(CGUI_CAPTURE_SNAPSHOT_TEXTURE);
+        write_value(record.object_id);
+        write_data(parameters, sizeof(parameters));
+        write_blob(data.data(), data.size());
+    }
+
+    glBindTexture(GL_TEXTURE_2D, previous_texture);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, previous_pack_buffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, previous_pack_alignment);
+}
+
+/**
+ * @brief      Stores storage of every renderbuffer, content is not stored.
+ */
+void CGUIFrameCapture::snapshot_renderbuffers()
+{
+    GLint previous_renderbuffer = 0;
+    glGetIntegerv(GL_RENDERBUFFER_BINDING, &previous_renderbuffer);
+
+    for (const CGUIMemoryRecord& record : main_memory_tracker.get_records(CGUI_MEMORY_RENDERBUFFER))
+    {
+        if (glIsRenderbuffer(record.object_id) != GL_TRUE)
+        {
+            continue;
+        }
+
+        GLint parameters[4] = {0, 0, GL_RGBA8, 0};
+
+        glBindRenderbuffer(GL_RENDERBUFFER, record.object_id);
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_WIDTH, &parameters[0]);
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_HEIGHT, &parameters[1]);
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_INTERNAL_FORMAT, &parameters[2]);
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_SAMPLES, &parameters[3]);
+
+        begin_record(CGUI_CAPTURE_SNAPSHOT_RENDERBUFFER);
+        write_value(record.object_id);
+        write_data(parameters, sizeof(parameters));
+    }
+
+    glBindRenderbuffer(GL_RENDERBUFFER, previous_renderbuffer);
+}
+
+/**
+ * @brief      Stores stage sources and default block uniform values of every program.
+ */
+void CGUIFrameCapture::snapshot_programs()
+{
+    for (const CGUIMemoryRecord& record : main_memory_tracker.get_records(CGUI_MEMORY_PROGRAM))
+    {
+        if (glIsProgram(record.object_id) != GL_TRUE)
+        {
+            continue;
+        }
+
+        {
+            std::lock_guard registry_lock(registry_mutex);
+
+            auto sources_iterator = program_sources.find(record.object_id);
+            if (sources_iterator == program_sources.end())
+            {
+                main_debug_handler.post_log(std::string(__CGUI_OBF__("Sources of program ")) + std::to_string(record.object_id) + __CGUI_OBF__(" are unknown, it is not captured."), DEBUG_MODE_WARNING);
+                continue;
+            }
+
+            begin_record(CGUI_CAPTURE_SNAPSHOT_PROGRAM);
+            write_value(record.object_id);
+            write_value((uint32_t)sources_iterator->second.size());
+            for (const CGUIShaderStage& stage : sources_iterator->second)
+            {
+                write_value(stage.type);
+                write_blob(stage.source.data(), stage.source.size());
+            }
+        }
+
+        GLint uniform_count = 0;
+        glGetProgramiv(record.object_id, GL_ACTIVE_UNIFORMS, &uniform_count);
+
+        // Only first element of arrays is restored
+        for (GLuint uniform_index = 0; uniform_index < (GLuint)uniform_count; ++uniform_index)
+        {
+            GLchar uniform_name[256];
+            GLsizei name_length = 0;
+            GLint uniform_size = 0, block_index = -1;
+            GLenum uniform_type = GL_NONE;
+
+            glGetActiveUniform(record.object_id, uniform_index, sizeof(uniform_name), &name_length, &uniform_size, &uniform_type, uniform_name);
+            glGetActiveUniformsiv(record.object_id, 1, &uniform_index, GL_UNIFORM_BLOCK_INDEX, &block_index);
+
+            GLint location = glGetUniformLocation(record.object_id, uniform_name);
+            if (block_index != -1 || location < 0)
+            {
+                continue;
+            }
+
+            uint8_t value[16 * sizeof(GLfloat)] = {};
+            switch (cgui_capture_uniform_base(uniform_type))
+            {
+                case GL_FLOAT:
+                    glGetUniformfv(record.object_id, location, reinterpret_cast<GLfloat*>(value));
+                    break;
+                case GL_UNSIGNED_INT:
+                    glGetUniformuiv(record.object_id, location, reinterpret_cast<GLuint*>(value));
+                    break;
+                default:
+                    glGetUniformiv(record.object_id, location, reinterpret_cast<GLint*>(value));
+                    break;
+            }
+
+            begin_record(CGUI_CAPTURE_SNAPSHOT_UNIFORM);
+            write_value(record.object_id);
+            write_value(location);
+            write_value(uniform_type);
+            write_string(uniform_name);
+            write_data(value, sizeof(value));
+        }
+    }
+}
+
+/**
+ * @brief      Stores element buffer and attribute layout of every vertex array.
+ */
+void CGUIFrameCapture::snapshot_vertex_arrays()
+{
+    GLint previous_vertex_array = 0, attribute_limit = 16;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previous_vertex_array);
+    glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &attribute_limit);
+    attribute_limit = std::min(attribute_limit, 16);
+
+    std::vector<CGUICaptureAttribute> attributes;
+    for (const CGUIMemoryRecord& record : main_memory_tracker.get_records(CGUI_MEMORY_VERTEX_ARRAY))
+    {
+        // Vertex arrays are not shared, ones of other contexts are skipped
+        if (glIsVertexArray(record.object_id) != GL_TRUE)
+        {
+            continue;
+        }
+
+        glBindVertexArray(record.object_id);
+
+        GLint element_buffer = 0;
+        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &element_buffer);
+
+        attributes.clear();
+        for (GLint attribute_index = 0; attribute_index < attribute_limit; ++attribute_index)
+        {
+            CGUICaptureAttribute attribute = {};
+            void* attribute_pointer = nullptr;
+
+            attribute.index = (GLuint)attribute_index;
+            glGetVertexAttribiv(attribute.index, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &attribute.enabled);
+            glGetVertexAttribiv(attribute.index, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &attribute.buffer);
+
+            if (attribute.enabled == GL_FALSE && attribute.buffer == 0)
+            {
+                continue;
+            }
+
+            glGetVertexAttribiv(attribute.index, GL_VERTEX_ATTRIB_ARRAY_SIZE, &attribute.size);
+            glGetVertexAttribiv(attribute.index, GL_VERTEX_ATTRIB_ARRAY_TYPE, &attribute.type);
+            glGetVertexAttribiv(attribute.index, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &attribute.normalized);
+            glGetVertexAttribiv(attribute.index, GL_VERTEX_ATTRIB_ARRAY_INTEGER, &attribute.integer);
+            glGetVertexAttribiv(attribute.index, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &attribute.stride);
+            glGetVertexAttribiv(attribute.index, GL_VERTEX_ATTRIB_ARRAY_DIVISOR, &attribute.divisor);
+            glGetVertexAttribPointerv(attribute.index, GL_VERTEX_ATTRIB_ARRAY_POINTER, &attribute_pointer);
+            attribute.offset = (uint64_t)(uintptr_t)attribute_pointer;
+
+            attributes.push_back(attribute);
+        }
+
+        begin_record(CGUI_CAPTURE_SNAPSHOT_VERTEX_ARRAY);
+        write_value(record.object_id);
+        write_value(element_buffer);
+        write_value((uint32_t)attributes.size());
+        write_data(attributes.data(), attributes.size() * sizeof(CGUICaptureAttribute));
+    }
+
+    glBindVertexArray(previous_vertex_array);
+}
+
+/**
+ * @brief      Stores attachments of every framebuffer.
+ */
+void CGUIFrameCapture::snapshot_framebuffers()
+{
+    GLint previous_framebuffer = 0, color_limit = 8;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous_framebuffer);
+    glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &color_limit);
+    color_limit = std::min(color_limit, 8);
+
+    std::vector<GLuint> known_framebuffers;
+    {
+        std::lock_guard registry_lock(registry_mutex);
+        known_framebuffers.assign(framebuffer_ids.begin(), framebuffer_ids.end());
+    }
+
+    std::vector<GLenum> attachment_points = {GL_DEPTH_ATTACHMENT, GL_STENCIL_ATTACHMENT};
+    for (GLint color_index = 0; color_index < color_limit; ++color_index)
+    {
+        attachment_points.push_back(GL_COLOR_ATTACHMENT0 + color_index);
+    }
+
+    std::vector<CGUICaptureAttachment> attachments;
+    for (GLuint framebuffer_id : known_framebuffers)
+    {
+        // Framebuffers are not shared, ones of other contexts are skipped
+        if (glIsFramebuffer(framebuffer_id) != GL_TRUE)
+        {
+            continue;
+        }
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer_id);
+
+        attachments.clear();
+        for (GLenum attachment_point : attachment_points)
+        {
+            CGUICaptureAttachment attachment = {};
+            attachment.attachment = attachment_point;
+
+            glGetFramebufferAttachmentParameteriv(GL_READ_FRAMEBUFFER, attachment_point, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &attachment.object_type);
+            if (attachment.object_type != GL_TEXTURE && attachment.object_type != GL_RENDERBUFFER)
+            {
+                continue;
+            }
+
+            GLint object_id = 0;
+            glGetFramebufferAttachmentParameteriv(GL_READ_FRAMEBUFFER, attachment_point, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &object_id);
+            attachment.object_id = (GLuint)object_id;
+
+            if (attachment.object_type == GL_TEXTURE)
+            {
+                glGetFramebufferAttachmentParameteriv(GL_READ_FRAMEBUFFER, attachment_point, GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL, &attachment.level);
+            }
+
+            attachments.push_back(attachment);
+        }
+
+        begin_record(CGUI_CAPTURE_SNAPSHOT_FRAMEBUFFER);
+        write_value(framebuffer_id);
+        write_value((uint32_t)attachments.size());
+        write_data(attachments.data(), attachments.size() * sizeof(CGUICaptureAttachment));
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, previous_framebuffer);
+}
+
+/**
+ * @brief      Stores global context state and bindings.
+ */
+void CGUIFrameCapture::snapshot_state()
+{
+    CGUICaptureState state = {};
+
+    for (std::size_t cap_index = 0; cap_index < std::size(cgui_capture_caps); ++cap_index)
+    {
+        if (glIsEnabled(cgui_capture_caps[cap_index]) == GL_TRUE)
+        {
+            state.enabled_caps |= 1u << cap_index;
+        }
+    }
+
+    glGetIntegerv(GL_BLEND_SRC_RGB, &state.blend_func[0]);
+    glGetIntegerv(GL_BLEND_DST_RGB, &state.blend_func[1]);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &state.blend_func[2]);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &state.blend_func[3]);
+    glGetIntegerv(GL_VIEWPORT, state.viewport);
+    glGetIntegerv(GL_SCISSOR_BOX, state.scissor_box);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, state.clear_color);
+    glGetIntegerv(GL_CURRENT_PROGRAM, &state.program);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &state.vertex_array);
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &state.array_buffer);
+    glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &state.pixel_unpack_buffer);
+    glGetIntegerv(GL_DISPATCH_INDIRECT_BUFFER_BINDING, &state.dispatch_indirect_buffer);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &state.read_framebuffer);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &state.draw_framebuffer);
+    glGetIntegerv(GL_RENDERBUFFER_BINDING, &state.renderbuffer);
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &state.active_texture);
+    glGetIntegerv(GL_UNPACK_ROW_LENGTH, &state.unpack_row_length);
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &state.unpack_alignment);
+    glGetIntegerv(GL_PACK_ALIGNMENT, &state.pack_alignment);
+
+    for (GLint unit_index = 0; unit_index < 8; ++unit_index)
+    {
+        glActiveTexture(GL_TEXTURE0 + unit_index);
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &state.texture_units[unit_index]);
+    }
+    glActiveTexture(state.active_texture);
+
+    begin_record(CGUI_CAPTURE_SNAPSHOT_STATE);
+    write_value(state);
+}
+
+/**
+ * @brief      Starts new record.
+ *
+ * @param[in]  record  Type of the record.
+ */
+void CGUIFrameCapture::begin_record(CGUICaptureRecord record)
+{
+    write_value((uint16_t)record);
+}
+
+/**
+ * @brief      Builds path of new capture file next to debug logs.
+ *
+ * @return     Path of the file.
+ */
+fs::path CGUIFrameCapture::get_capture_path()
+{
+    fs::path capture_directory;
+    const char* user_name = getenv("USER");
+
+    #if defined(_WIN32) || defined(WIN32) || defined(__CYGWIN__) || defined(__MINGW32__) || defined(__BORLANDC__)
+        (void)user_name;
+        capture_directory = fs::current_path();
+    #endif // Windows
+    #if defined(__APPLE__)
+        capture_directory = fs::path(__CGUI_OBF__("/Users/") + std::string((user_name != nullptr) ? user_name : "") + __CGUI_OBF__("/Library/Application Support/CGUI"));
+    #endif // Apple
+    #if defined(__unix__) || defined(__linux__)
+        capture_directory = fs::path(__CGUI_OBF__("/home/") + std::string((user_name != nullptr) ? user_name : "") + __CGUI_OBF__("/.cgui"));
+    #endif // Unix
+
+    capture_directory += fs::path(__CGUI_OBF__("/capture"));
+    fs::create_directories(capture_directory);
+
+    uint64_t capture_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    return capture_directory / (std::string(__CGUI_OBF__("frame_capture_")) + std::to_string(capture_time) + __CGUI_OBF__(".cgcap"));
+}
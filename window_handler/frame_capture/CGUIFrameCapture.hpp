@@ -0,0 +1,168 @@
+/**
+ * @file       <CGUIFrameCapture.hpp>
+ * @brief      This header file implements CGUIFrameCapture class.
+ *
+ *             It is being used in order to record GL command stream of several
+ *             frames into a file, that can be replayed and profiled offline.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUIFRAMECAPTURE_HPP
+#define CGUIFRAMECAPTURE_HPP
+
+/**
+ * Include GLFW and GLAD for window handling.
+ */
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+
+#include "CGUIFrameCaptureFormat.hpp"
+#include "../debug_handler/CGUIDebugHandler.hpp"
+#include "../memory_tracker/CGUIMemoryTracker.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Amount of frames, that are recorded by default.
+ */
+#define CGUI_CAPTURE_DEFAULT_FRAMES 3
+
+/**
+ * @brief      This class implements capture of GL command stream.
+ *
+ *             Glad function pointers of every function from CGUI_CAPTURE_FUNCTIONS are replaced
+ *             by wrappers once, right after GL is loaded. Wrappers only check a flag until capture
+ *             is requested. Capture starts at frame boundary of the render thread with a snapshot
+ *             of all live objects and context state, then every call of that thread is appended
+ *             to memory buffer with its arguments, uploaded data and shader sources. After the
+ *             requested amount of frames the buffer is written to a file.
+ *
+ *             Shader sources are always kept for linked programs, since shaders are deleted
+ *             right after linking and snapshot would not be able to read them otherwise.
+ */
+class CGUIFrameCapture
+{
+public:
+    CGUIFrameCapture();
+    CGUIFrameCapture(const CGUIFrameCapture&) = delete;
+    ~CGUIFrameCapture();
+
+    void install();
+
+    void request_capture(uint32_t frame_count = CGUI_CAPTURE_DEFAULT_FRAMES);
+    void begin_frame(glm::ivec2 framebuffer_size);
+    void end_frame();
+
+    bool is_capturing();
+
+    /**
+     * Used by wrappers.
+     */
+    bool is_recording();
+
+    void write_data(const void* data, std::size_t size);
+    void write_blob(const void* data, std::size_t size);
+    void write_string(const char* string);
+
+    template<typename Value>
+    void write_value(const Value& value)
+    {
+        write_data(&value, sizeof(Value));
+    }
+
+    void track_shader_source(GLuint shader_id, GLsizei count, const GLchar* const* strings, const GLint* lengths);
+    void track_shader_delete(GLuint shader_id);
+    void track_program_link(GLuint program_id);
+    void track_program_stage(GLuint program_id, GLenum shader_type, const std::string& source);
+    void track_program_delete(GLuint program_id);
+    void track_framebuffers(GLsizei count, const GLuint* framebuffer_ids_arg, bool created);
+    void track_buffer_map(GLenum target, void* mapped_data, GLsizeiptr length, GLbitfield access);
+    void write_buffer_unmap(GLenum target);
+    void write_pixels(GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels);
+
+    static std::size_t get_pixel_size(GLenum format, GLenum type);
+
+private:
+    void start_capture(glm::ivec2 framebuffer_size);
+    void stop_capture();
+
+    void snapshot_buffers();
+    void snapshot_textures();
+    void snapshot_renderbuffers();
+    void snapshot_programs();
+    void snapshot_vertex_arrays();
+    void snapshot_framebuffers();
+    void snapshot_state();
+
+    void begin_record(CGUICaptureRecord record);
+
+    fs::path get_capture_path();
+
+private:
+    bool installed = false;
+
+    /**
+     * Capture state, requested frames are set by any thread, the rest is owned by render thread.
+     * Recording flag and thread are also read by GL hooks of every thread, that makes calls.
+     */
+    std::atomic<uint32_t>   requested_frames    = 0;
+    std::atomic<bool>       recording           = false;
+    std::atomic<std::thread::id> recording_thread;
+    uint32_t                remaining_frames    = 0;
+    uint32_t                captured_frames     = 0;
+    CGUICaptureHeader       header;
+    std::vector<uint8_t>    stream;
+
+    /**
+     * Mapped buffer ranges by target, their content is stored on unmap.
+     */
+    struct CGUIMappedRange
+    {
+        void*       mapped_data;
+        GLsizeiptr  length;
+        GLbitfield  access;
+    };
+    std::unordered_map<GLenum, CGUIMappedRange> mapped_ranges;
+
+    /**
+     * Always tracked objects, that GL can not give back during snapshot.
+     */
+    struct CGUIShaderStage
+    {
+        GLenum      type;
+        std::string source;
+    };
+    std::mutex                                                  registry_mutex;
+    std::unordered_map<GLuint, std::string>                     shader_sources;
+    std::unordered_map<GLuint, std::vector<CGUIShaderStage>>    program_sources;
+    std::unordered_set<GLuint>                                  framebuffer_ids;
+};
+
+extern CGUIFrameCapture main_frame_capture;
+
+#endif // CGUIFRAMECAPTURE_HPP
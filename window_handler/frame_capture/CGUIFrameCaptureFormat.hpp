@@ -0,0 +1,349 @@
+/**
+ * @file       <CGUIFrameCaptureFormat.hpp>
+ * @brief      This header file implements CGUIFrameCaptureFormat structures.
+ *
+ *             It is being used in order to share binary layout of frame captures
+ *             between recorder and replayer.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUIFRAMECAPTUREFORMAT_HPP
+#define CGUIFRAMECAPTUREFORMAT_HPP
+
+/**
+ * Include GLFW and GLAD for window handling.
+ */
+#include <glad/gl.h>
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Capture file header values.
+ */
+#define CGUI_CAPTURE_MAGIC          0x50414347u     // "CGAP"
+#define CGUI_CAPTURE_VERSION        2
+#define CGUI_CAPTURE_MAX_ARGUMENTS  12
+
+/**
+ * GL entry points, that are captured.
+ *
+ * Every entry is X(name, result kind, argument kinds...), kinds are values of CGUICaptureArgument,
+ * omitted trailing kinds are VALUE. Calls to functions outside of this list are
+ * executed, but not captured, so every new GL call of the renderer has to be added here.
+ */
+#define CGUI_CAPTURE_FUNCTIONS(X) \
+    X(ActiveTexture,            VALUE) \
+    X(AttachShader,             VALUE, PROGRAM, SHADER) \
+    X(BindBuffer,               VALUE, VALUE, BUFFER) \
+    X(BindBufferBase,           VALUE, VALUE, VALUE, BUFFER) \
+    X(BindBufferRange,          VALUE, VALUE, VALUE, BUFFER) \
+    X(BindFramebuffer,          VALUE, VALUE, FRAMEBUFFER) \
+    X(BindRenderbuffer,         VALUE, VALUE, RENDERBUFFER) \
+    X(BindTexture,              VALUE, VALUE, TEXTURE) \
+    X(BindVertexArray,          VALUE, VERTEX_ARRAY) \
+    X(BlendFuncSeparate,        VALUE) \
+    X(BlitFramebuffer,          VALUE) \
+    X(BufferData,               VALUE, VALUE, VALUE, PAYLOAD) \
+    X(BufferSubData,            VALUE, VALUE, VALUE, VALUE, PAYLOAD) \
+    X(Clear,                    VALUE) \
+    X(ClearColor,               VALUE) \
+    X(ClientWaitSync,           VALUE, SYNC) \
+    X(CompileShader,            VALUE, SHADER) \
+    X(CopyBufferSubData,        VALUE) \
+    X(CreateProgram,            PROGRAM) \
+    X(CreateShader,             SHADER) \
+    X(DeleteBuffers,            VALUE, VALUE, PAYLOAD) \
+    X(DeleteFramebuffers,       VALUE, VALUE, PAYLOAD) \
+    X(DeleteProgram,            VALUE, PROGRAM) \
+    X(DeleteRenderbuffers,      VALUE, VALUE, PAYLOAD) \
+    X(DeleteShader,             VALUE, SHADER) \
+    X(DeleteSync,               VALUE, SYNC) \
+    X(DeleteTextures,           VALUE, VALUE, PAYLOAD) \
+    X(DeleteVertexArrays,       VALUE, VALUE, PAYLOAD) \
+    X(DetachShader,             VALUE, PROGRAM, SHADER) \
+    X(Disable,                  VALUE) \
+    X(DisableVertexAttribArray, VALUE) \
+    X(DispatchCompute,          VALUE) \
+    X(DispatchComputeIndirect,  VALUE) \
+    X(DrawArrays,               VALUE) \
+    X(DrawArraysInstanced,      VALUE) \
+    X(DrawElements,             VALUE, VALUE, VALUE, VALUE, OFFSET) \
+    X(DrawElementsInstanced,    VALUE, VALUE, VALUE, VALUE, OFFSET) \
+    X(Enable,                   VALUE) \
+    X(EnableVertexAttribArray,  VALUE) \
+    X(FenceSync,                SYNC) \
+    X(Finish,                   VALUE) \
+    X(Flush,                    VALUE) \
+    X(FramebufferRenderbuffer,  VALUE, VALUE, VALUE, VALUE, RENDERBUFFER) \
+    X(FramebufferTexture2D,     VALUE, VALUE, VALUE, VALUE, TEXTURE) \
+    X(GenBuffers,               VALUE, VALUE, PAYLOAD) \
+    X(GenFramebuffers,          VALUE, VALUE, PAYLOAD) \
+    X(GenRenderbuffers,         VALUE, VALUE, PAYLOAD) \
+    X(GenTextures,              VALUE, VALUE, PAYLOAD) \
+    X(GenVertexArrays,          VALUE, VALUE, PAYLOAD) \
+    X(GetFloatv,                VALUE, VALUE, OUTPUT) \
+    X(GetIntegerv,              VALUE, VALUE, OUTPUT) \
+    X(GetProgramInfoLog,        VALUE, PROGRAM, VALUE, OUTPUT, OUTPUT) \
+    X(GetProgramiv,             VALUE, PROGRAM, VALUE, OUTPUT) \
+    X(GetShaderInfoLog,         VALUE, SHADER, VALUE, OUTPUT, OUTPUT) \
+    X(GetShaderiv,              VALUE, SHADER, VALUE, OUTPUT) \
+    X(GetUniformLocation,       LOCATION, PROGRAM, STRING) \
+    X(IsEnabled,                VALUE) \
+    X(LinkProgram,              VALUE, PROGRAM) \
+    X(MapBufferRange,           VALUE) \
+    X(MemoryBarrier,            VALUE) \
+    X(MemoryBarrierByRegion,    VALUE) \
+    X(PixelStorei,              VALUE) \
+    X(RenderbufferStorage,      VALUE) \
+    X(Scissor,                  VALUE) \
+    X(ShaderSource,             VALUE, SHADER, VALUE, PAYLOAD, PAYLOAD) \
+    X(TexImage2D,               VALUE, VALUE, VALUE, VALUE, VALUE, VALUE, VALUE, VALUE, VALUE, PAYLOAD) \
+    X(TexParameteri,            VALUE) \
+    X(TexSubImage2D,            VALUE, VALUE, VALUE, VALUE, VALUE, VALUE, VALUE, VALUE, VALUE, PAYLOAD) \
+    X(Uniform1f,                VALUE, LOCATION) \
+    X(Uniform1i,                VALUE, LOCATION) \
+    X(Uniform2f,                VALUE, LOCATION) \
+    X(Uniform4f,                VALUE, LOCATION) \
+    X(UniformMatrix4fv,         VALUE, LOCATION, VALUE, VALUE, PAYLOAD) \
+    X(UnmapBuffer,              VALUE) \
+    X(UseProgram,               VALUE, PROGRAM) \
+    X(VertexAttribDivisor,      VALUE) \
+    X(VertexAttribPointer,      VALUE, VALUE, VALUE, VALUE, VALUE, VALUE, OFFSET) \
+    X(Viewport,                 VALUE)
+
+/**
+ * Kinds of arguments and results, they define how value is stored and remapped on replay.
+ */
+enum class CGUICaptureArgument : uint8_t
+{
+    VALUE = 0,      // Stored as is
+    OFFSET,         // Pointer, that is an offset into bound buffer, stored as is
+    OUTPUT,         // Output pointer, not stored, replay passes scratch memory
+    STRING,         // Null terminated string, stored with its length
+    PAYLOAD,        // Stored by function specific code after all other arguments
+    BUFFER,         // GL object names, remapped on replay
+    VERTEX_ARRAY,
+    TEXTURE,
+    FRAMEBUFFER,
+    RENDERBUFFER,
+    PROGRAM,
+    SHADER,
+    SYNC,           // Sync object, stored as pointer value
+    LOCATION        // Uniform location of the current program
+};
+
+/**
+ * Kinds of result and arguments of one function.
+ */
+struct CGUICaptureSignature
+{
+    CGUICaptureArgument result;
+    CGUICaptureArgument arguments[CGUI_CAPTURE_MAX_ARGUMENTS];
+};
+
+/**
+ * Record types, every record starts with one of them.
+ */
+enum CGUICaptureRecord : uint16_t
+{
+    #define CGUI_CAPTURE_RECORD_ENUM(name, ...) CGUI_CAPTURE_CALL_##name,
+    CGUI_CAPTURE_FUNCTIONS(CGUI_CAPTURE_RECORD_ENUM)
+    #undef CGUI_CAPTURE_RECORD_ENUM
+
+    CGUI_CAPTURE_CALL_COUNT,
+
+    CGUI_CAPTURE_SNAPSHOT_BUFFER = 0x8000,
+    CGUI_CAPTURE_SNAPSHOT_TEXTURE,
+    CGUI_CAPTURE_SNAPSHOT_RENDERBUFFER,
+    CGUI_CAPTURE_SNAPSHOT_PROGRAM,
+    CGUI_CAPTURE_SNAPSHOT_UNIFORM,
+    CGUI_CAPTURE_SNAPSHOT_VERTEX_ARRAY,
+    CGUI_CAPTURE_SNAPSHOT_FRAMEBUFFER,
+    CGUI_CAPTURE_SNAPSHOT_STATE,
+    CGUI_CAPTURE_FRAME_END
+};
+
+/**
+ * Kinds of texture data payload.
+ */
+#define CGUI_CAPTURE_PIXELS_NONE    0   // NULL pointer
+#define CGUI_CAPTURE_PIXELS_DATA    1   // Client memory, stored as blob
+#define CGUI_CAPTURE_PIXELS_OFFSET  2   // Offset into bound pixel unpack buffer
+
+/**
+ * Capture file header.
+ */
+struct CGUICaptureHeader
+{
+    uint32_t    magic           = CGUI_CAPTURE_MAGIC;
+    uint32_t    version         = CGUI_CAPTURE_VERSION;
+    uint32_t    pointer_size    = sizeof(void*);
+    uint32_t    frame_count     = 0;
+    int32_t     framebuffer_width   = 0;
+    int32_t     framebuffer_height  = 0;
+};
+
+/**
+ * Snapshot of the global context state at the start of capture.
+ */
+struct CGUICaptureState
+{
+    uint32_t    enabled_caps;               // Bits follow cgui_capture_caps order
+    GLint       blend_func[4];              // Source rgb, destination rgb, source alpha, destination alpha
+    GLint       viewport[4];
+    GLint       scissor_box[4];
+    GLfloat     clear_color[4];
+    GLint       program;
+    GLint       vertex_array;
+    GLint       array_buffer;
+    GLint       pixel_unpack_buffer;
+    GLint       dispatch_indirect_buffer;
+    GLint       read_framebuffer;
+    GLint       draw_framebuffer;
+    GLint       renderbuffer;
+    GLint       active_texture;
+    GLint       texture_units[8];           // GL_TEXTURE_BINDING_2D of first units
+    GLint       unpack_row_length;
+    GLint       unpack_alignment;
+    GLint       pack_alignment;
+};
+
+/**
+ * Capabilities, that are stored in the state snapshot.
+ */
+inline constexpr GLenum cgui_capture_caps[] = {GL_BLEND, GL_SCISSOR_TEST, GL_DEPTH_TEST, GL_CULL_FACE, GL_STENCIL_TEST, GL_FRAMEBUFFER_SRGB, GL_MULTISAMPLE, GL_PRIMITIVE_RESTART};
+
+/**
+ * Attachment of framebuffer snapshot.
+ */
+struct CGUICaptureAttachment
+{
+    GLenum  attachment;
+    GLint   object_type;                    // GL_TEXTURE or GL_RENDERBUFFER
+    GLuint  object_id;
+    GLint   level;
+};
+
+/**
+ * Vertex attribute of vertex array snapshot.
+ */
+struct CGUICaptureAttribute
+{
+    GLuint  index;
+    GLint   enabled;
+    GLint   size;
+    GLint   type;
+    GLint   normalized;
+    GLint   integer;
+    GLint   stride;
+    GLint   buffer;
+    GLint   divisor;
+    uint64_t offset;
+};
+
+/**
+ * @brief      Gets argument kinds of captured function.
+ *
+ * @param[in]  record  Captured function.
+ *
+ * @return     Signature of the function.
+ */
+constexpr CGUICaptureSignature cgui_capture_signature(CGUICaptureRecord record)
+{
+    using enum CGUICaptureArgument;
+
+    switch (record)
+    {
+        #define CGUI_CAPTURE_RECORD_SIGNATURE(name, result, ...) case CGUI_CAPTURE_CALL_##name: return {result, {__VA_ARGS__}};
+        CGUI_CAPTURE_FUNCTIONS(CGUI_CAPTURE_RECORD_SIGNATURE)
+        #undef CGUI_CAPTURE_RECORD_SIGNATURE
+
+        default:
+            return {VALUE, {}};
+    }
+}
+
+/**
+ * @brief      Gets name of captured function.
+ *
+ * @param[in]  record  Captured function.
+ *
+ * @return     Name of the function, or nullptr for snapshot records.
+ */
+constexpr const char* cgui_capture_function_name(CGUICaptureRecord record)
+{
+    switch (record)
+    {
+        #define CGUI_CAPTURE_RECORD_NAME(name, ...) case CGUI_CAPTURE_CALL_##name: return "gl" #name;
+        CGUI_CAPTURE_FUNCTIONS(CGUI_CAPTURE_RECORD_NAME)
+        #undef CGUI_CAPTURE_RECORD_NAME
+
+        default:
+            return nullptr;
+    }
+}
+
+/**
+ * @brief      Gets amount of components of uniform type, samplers and images have one.
+ *
+ * @param[in]  type  Type of the uniform.
+ *
+ * @return     Amount of components.
+ */
+constexpr GLint cgui_capture_uniform_components(GLenum type)
+{
+    switch (type)
+    {
+        case GL_FLOAT_VEC2: case GL_INT_VEC2: case GL_UNSIGNED_INT_VEC2: case GL_BOOL_VEC2:
+            return 2;
+        case GL_FLOAT_VEC3: case GL_INT_VEC3: case GL_UNSIGNED_INT_VEC3: case GL_BOOL_VEC3:
+            return 3;
+        case GL_FLOAT_VEC4: case GL_INT_VEC4: case GL_UNSIGNED_INT_VEC4: case GL_BOOL_VEC4: case GL_FLOAT_MAT2:
+            return 4;
+        case GL_FLOAT_MAT3:
+            return 9;
+        case GL_FLOAT_MAT4:
+            return 16;
+        default:
+            return 1;
+    }
+}
+
+/**
+ * @brief      Gets base type of uniform, that selects glGetUniform* and glProgramUniform* variant.
+ *
+ * @param[in]  type  Type of the uniform.
+ *
+ * @return     GL_FLOAT, GL_UNSIGNED_INT or GL_INT.
+ */
+constexpr GLenum cgui_capture_uniform_base(GLenum type)
+{
+    switch (type)
+    {
+        case GL_FLOAT: case GL_FLOAT_VEC2: case GL_FLOAT_VEC3: case GL_FLOAT_VEC4:
+        case GL_FLOAT_MAT2: case GL_FLOAT_MAT3: case GL_FLOAT_MAT4:
+            return GL_FLOAT;
+        case GL_UNSIGNED_INT: case GL_UNSIGNED_INT_VEC2: case GL_UNSIGNED_INT_VEC3: case GL_UNSIGNED_INT_VEC4:
+            return GL_UNSIGNED_INT;
+        default:
+            return GL_INT;
+    }
+}
+
+#endif // CGUIFRAMECAPTUREFORMAT_HPP
@@ -0,0 +1,956 @@
+/**
+ * @file       <CGUIFrameReplayer.cpp>
+ * @brief      This source file implements CGUIFrameReplayer class.
+ *
+ *             It is being used in order to re-execute frame captures and
+ *             measure time of every GL call.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUIFrameReplayer.hpp"
+
+#include <type_traits>
+#include <algorithm>
+#include <iomanip>
+#include <fstream>
+#include <utility>
+#include <chrono>
+#include <cstring>
+#include <tuple>
+
+/**
+ * @brief      Constructs a new frame replayer.
+ */
+CGUIFrameReplayer::CGUIFrameReplayer()
+{
+    scratch.resize(64 * 1024);
+}
+
+/**
+ * @brief      Destroys frame replayer.
+ */
+CGUIFrameReplayer::~CGUIFrameReplayer()
+{
+    capture.clear();
+}
+
+/**
+ * @brief      Reads capture file.
+ *
+ * @param[in]  capture_path  Path of the file.
+ *
+ * @return     Status of loading, get_error describes failure.
+ */
+bool CGUIFrameReplayer::load(const std::filesystem::path& capture_path)
+{
+    std::ifstream capture_file(capture_path, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!capture_file.good())
+    {
+        fail("Unable to open capture: " + capture_path.string());
+        return false;
+    }
+
+    std::streamsize file_size = capture_file.tellg();
+    capture_file.seekg(0);
+
+    if (file_size < (std::streamsize)sizeof(CGUICaptureHeader))
+    {
+        fail("Capture is too small: " + capture_path.string());
+        return false;
+    }
+
+    capture_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    capture.resize((std::size_t)file_size - sizeof(header));
+    capture_file.read(reinterpret_cast<char*>(capture.data()), (std::streamsize)capture.size());
+
+    if (header.magic != CGUI_CAPTURE_MAGIC || header.version != CGUI_CAPTURE_VERSION)
+    {
+        fail("Unsupported capture format: " + capture_path.string());
+        return false;
+    }
+    if (header.pointer_size != sizeof(void*))
+    {
+        fail("Capture was recorded by " + std::to_string(header.pointer_size * 8) + " bit process.");
+        return false;
+    }
+
+    read_offset = 0;
+    renderer_name = read_string();
+    renderer_version = read_string();
+    stream_offset = read_offset;
+
+    return error.empty();
+}
+
+/**
+ * @brief      Replays loaded capture on current context.
+ *
+ * @param      window        Window of current context, its buffers are swapped after every frame.
+ * @param[in]  finish_calls  Call glFinish after every call, so its time includes GPU work.
+ *
+ * @return     Status of replay, get_error describes failure.
+ */
+bool CGUIFrameReplayer::replay(GLFWwindow* window, bool finish_calls)
+{
+    finish_after_call = finish_calls;
+    read_offset = stream_offset;
+
+    for (std::unordered_map<GLuint, GLuint>& names : object_names)
+    {
+        names.clear();
+    }
+    locations.clear();
+    syncs.clear();
+    mapped_pointers.clear();
+    frames.clear();
+    frame_open = false;
+    std::fill(std::begin(timings), std::end(timings), CGUIReplayTiming());
+
+    bool snapshot_done = false;
+    std::chrono::time_point<std::chrono::steady_clock> snapshot_start = std::chrono::steady_clock::now();
+
+    while (read_offset < capture.size() && error.empty())
+    {
+        CGUICaptureRecord record = (CGUICaptureRecord)read_value<uint16_t>();
+
+        if (record < CGUI_CAPTURE_CALL_COUNT)
+        {
+            if (!snapshot_done)
+            {
+                // Snapshot is finished before the first call
+                glFinish();
+                snapshot_time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - snapshot_start).count();
+                snapshot_done = true;
+            }
+            if (!frame_open)
+            {
+                frames.emplace_back();
+                glGenQueries(1, &frames.back().query_id);
+                glBeginQuery(GL_TIME_ELAPSED, frames.back().query_id);
+                frame_open = true;
+            }
+
+            replay_call(record);
+        }
+        else if (record == CGUI_CAPTURE_FRAME_END)
+        {
+            end_frame(window);
+        }
+        else
+        {
+            replay_snapshot(record);
+        }
+    }
+
+    if (frame_open)
+    {
+        glEndQuery(GL_TIME_ELAPSED);
+        frame_open = false;
+    }
+    glFinish();
+
+    for (CGUIReplayFrame& frame : frames)
+    {
+        if (frame.query_id == 0)
+        {
+            continue;
+        }
+
+        GLuint64 elapsed_time = 0;
+        glGetQueryObjectui64v(frame.query_id, GL_QUERY_RESULT, &elapsed_time);
+        glDeleteQueries(1, &frame.query_id);
+        frame.gpu_time = elapsed_time / 1000.0;
+    }
+
+    return error.empty();
+}
+
+/**
+ * @brief      Prints per frame and per function timings.
+ *
+ * @param      output  Stream to print to.
+ */
+void CGUIFrameReplayer::print_report(std::ostream& output)
+{
+    output << "Renderer: " << renderer_name << ", " << renderer_version << "\n";
+    output << "Framebuffer: " << header.framebuffer_width << "x" << header.framebuffer_height << ", frames: " << header.frame_count << "\n";
+    output << "Snapshot restore: " << std::fixed << std::setprecision(1) << snapshot_time << " us\n\n";
+
+    output << std::left << std::setw(8) << "Frame" << std::right << std::setw(10) << "Calls" << std::setw(16) << "CPU us" << std::setw(16) << "GPU us" << "\n";
+    for (std::size_t frame_index = 0; frame_index < frames.size(); ++frame_index)
+    {
+        output << std::left << std::setw(8) << frame_index << std::right << std::setw(10) << frames[frame_index].calls
+               << std::setw(16) << frames[frame_index].cpu_time << std::setw(16) << frames[frame_index].gpu_time << "\n";
+    }
+
+    std::vector<std::size_t> order;
+    for (std::size_t record = 0; record < CGUI_CAPTURE_CALL_COUNT; ++record)
+    {
+        if (timings[record].calls != 0)
+        {
+            order.push_back(record);
+        }
+    }
+    std::sort(order.begin(), order.end(), [this](std::size_t first, std::size_t second){ return timings[first].total_time > timings[second].total_time; });
+
+    output << "\n" << std::left << std::setw(28) << "Function" << std::right << std::setw(10) << "Calls" << std::setw(16) << "Total us"
+           << std::setw(14) << "Average us" << std::setw(14) << "Max us" << "\n";
+    for (std::size_t record : order)
+    {
+        const CGUIReplayTiming& timing = timings[record];
+        output << std::left << std::setw(28) << cgui_capture_function_name((CGUICaptureRecord)record) << std::right << std::setw(10) << timing.calls
+               << std::setw(16) << timing.total_time << std::setw(14) << timing.total_time / timing.calls << std::setw(14) << timing.max_time << "\n";
+    }
+
+    if (unmapped_names != 0)
+    {
+        output << "\n" << unmapped_names << " object names were used without being captured, they were passed as is.\n";
+    }
+}
+
+/**
+ * @brief      Gets header of loaded capture.
+ *
+ * @return     Capture header.
+ */
+const CGUICaptureHeader& CGUIFrameReplayer::get_header()
+{
+    return header;
+}
+
+/**
+ * @brief      Gets description of the last failure.
+ *
+ * @return     Error message, empty if there was none.
+ */
+const std::string& CGUIFrameReplayer::get_error()
+{
+    return error;
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Decodes, remaps, executes and times one call.
+ *
+ * @param[in]  function  Glad function pointer.
+ */
+template<CGUICaptureRecord record, typename Result, typename... Arguments>
+void CGUIFrameReplayer::replay_function(Result (GLAD_API_PTR *function)(Arguments...))
+{
+    constexpr CGUICaptureSignature signature = cgui_capture_signature(record);
+
+    std::tuple<Arguments...> arguments;
+    std::vector<std::string> strings;
+    strings.reserve(sizeof...(Arguments));
+
+    [&]<std::size_t... indices>(std::index_sequence<indices...>)
+    {
+        (read_argument<record, indices>(std::get<indices>(arguments), strings), ...);
+    }(std::index_sequence_for<Arguments...>{});
+
+    // Captured names are needed to key results
+    [[maybe_unused]] const std::tuple<Arguments...> captured_arguments = arguments;
+
+    // Payload storage has to live until the call
+    std::vector<GLuint> object_ids;
+    std::vector<const GLchar*> source_strings;
+    std::vector<GLint> source_lengths;
+    std::vector<GLfloat> matrices;
+    uint32_t blob_size = 0;
+
+    if constexpr (record == CGUI_CAPTURE_CALL_BufferData)
+    {
+        const uint8_t* data = (read_value<uint8_t>() != 0) ? read_blob(blob_size) : nullptr;
+        std::get<2>(arguments) = data;
+    }
+    else if constexpr (record == CGUI_CAPTURE_CALL_BufferSubData)
+    {
+        std::get<3>(arguments) = read_blob(blob_size);
+    }
+    else if constexpr (record == CGUI_CAPTURE_CALL_GenBuffers || record == CGUI_CAPTURE_CALL_GenFramebuffers ||
+                       record == CGUI_CAPTURE_CALL_GenRenderbuffers || record == CGUI_CAPTURE_CALL_GenTextures ||
+                       record == CGUI_CAPTURE_CALL_GenVertexArrays)
+    {
+        read_blob(blob_size);
+        object_ids.resize(std::max(std::get<0>(arguments), 0));
+        std::get<1>(arguments) = object_ids.data();
+    }
+    else if constexpr (record == CGUI_CAPTURE_CALL_DeleteBuffers || record == CGUI_CAPTURE_CALL_DeleteFramebuffers ||
+                       record == CGUI_CAPTURE_CALL_DeleteRenderbuffers || record == CGUI_CAPTURE_CALL_DeleteTextures ||
+                       record == CGUI_CAPTURE_CALL_DeleteVertexArrays)
+    {
+        constexpr CGUICaptureArgument kind = (record == CGUI_CAPTURE_CALL_DeleteBuffers) ? CGUICaptureArgument::BUFFER :
+                                             (record == CGUI_CAPTURE_CALL_DeleteFramebuffers) ? CGUICaptureArgument::FRAMEBUFFER :
+                                             (record == CGUI_CAPTURE_CALL_DeleteRenderbuffers) ? CGUICaptureArgument::RENDERBUFFER :
+                                             (record == CGUI_CAPTURE_CALL_DeleteTextures) ? CGUICaptureArgument::TEXTURE : CGUICaptureArgument::VERTEX_ARRAY;
+
+        const uint8_t* captured_ids = read_blob(blob_size);
+        object_ids.resize(blob_size / sizeof(GLuint));
+        if (!object_ids.empty())
+        {
+            std::memcpy(object_ids.data(), captured_ids, object_ids.size() * sizeof(GLuint));
+        }
+        for (GLuint& object_id : object_ids)
+        {
+            GLuint captured_id = object_id;
+            object_id = map_object(kind, captured_id);
+            object_names[(std::size_t)kind].erase(captured_id);
+        }
+        std::get<0>(arguments) = (GLsizei)object_ids.size();
+        std::get<1>(arguments) = object_ids.data();
+    }
+    else if constexpr (record == CGUI_CAPTURE_CALL_ShaderSource)
+    {
+        for (GLsizei string_index = 0; string_index < std::get<1>(arguments); ++string_index)
+        {
+            source_strings.push_back(reinterpret_cast<const GLchar*>(read_blob(blob_size)));
+            source_lengths.push_back((GLint)blob_size);
+        }
+        std::get<2>(arguments) = source_strings.data();
+        std::get<3>(arguments) = source_lengths.data();
+    }
+    else if constexpr (record == CGUI_CAPTURE_CALL_TexImage2D || record == CGUI_CAPTURE_CALL_TexSubImage2D)
+    {
+        switch (read_value<uint8_t>())
+        {
+            case CGUI_CAPTURE_PIXELS_DATA:
+                std::get<8>(arguments) = read_blob(blob_size);
+                break;
+            case CGUI_CAPTURE_PIXELS_OFFSET:
+                std::get<8>(arguments) = reinterpret_cast<const void*>((uintptr_t)read_value<uint64_t>());
+                break;
+            default:
+                std::get<8>(arguments) = nullptr;
+                break;
+        }
+    }
+    else if constexpr (record == CGUI_CAPTURE_CALL_UniformMatrix4fv)
+    {
+        const uint8_t* values = read_blob(blob_size);
+        matrices.resize(blob_size / sizeof(GLfloat));
+        if (!matrices.empty())
+        {
+            std::memcpy(matrices.data(), values, matrices.size() * sizeof(GLfloat));
+        }
+        std::get<3>(arguments) = matrices.data();
+    }
+    else if constexpr (record == CGUI_CAPTURE_CALL_UnmapBuffer)
+    {
+        const uint8_t* data = (read_value<uint8_t>() != 0) ? read_blob(blob_size) : nullptr;
+        auto pointer_iterator = mapped_pointers.find(std::get<0>(arguments));
+        if (data != nullptr && pointer_iterator != mapped_pointers.end() && pointer_iterator->second != nullptr)
+        {
+            std::memcpy(pointer_iterator->second, data, blob_size);
+        }
+        mapped_pointers.erase(std::get<0>(arguments));
+    }
+    else if constexpr (record == CGUI_CAPTURE_CALL_UseProgram)
+    {
+        current_program = std::get<0>(arguments);
+    }
+
+    [&]<std::size_t... indices>(std::index_sequence<indices...>)
+    {
+        (remap_argument<record, indices>(std::get<indices>(arguments)), ...);
+    }(std::index_sequence_for<Arguments...>{});
+
+    if (!error.empty())
+    {
+        return;
+    }
+
+    std::chrono::time_point<std::chrono::steady_clock> call_start = std::chrono::steady_clock::now();
+    [[maybe_unused]] Result* result_pointer = nullptr;
+
+    if constexpr (std::is_void_v<Result>)
+    {
+        std::apply(function, arguments);
+    }
+    else
+    {
+        Result result = std::apply(function, arguments);
+        Result captured_result = read_value<Result>();
+
+        if constexpr (signature.result == CGUICaptureArgument::PROGRAM || signature.result == CGUICaptureArgument::SHADER)
+        {
+            object_names[(std::size_t)signature.result][captured_result] = result;
+        }
+        else if constexpr (signature.result == CGUICaptureArgument::SYNC)
+        {
+            syncs[(uint64_t)(uintptr_t)captured_result] = result;
+        }
+        else if constexpr (signature.result == CGUICaptureArgument::LOCATION)
+        {
+            // Key uses captured program, which is the first argument of glGetUniformLocation
+            GLuint captured_program = std::get<0>(captured_arguments);
+            locations[((uint64_t)captured_program << 32) | (uint32_t)captured_result] = result;
+        }
+        else if constexpr (record == CGUI_CAPTURE_CALL_MapBufferRange)
+        {
+            mapped_pointers[std::get<0>(arguments)] = result;
+        }
+    }
+
+    if (finish_after_call)
+    {
+        glFinish();
+    }
+
+    double call_time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - call_start).count();
+
+    if constexpr (record == CGUI_CAPTURE_CALL_GenBuffers || record == CGUI_CAPTURE_CALL_GenFramebuffers ||
+                  record == CGUI_CAPTURE_CALL_GenRenderbuffers || record == CGUI_CAPTURE_CALL_GenTextures ||
+                  record == CGUI_CAPTURE_CALL_GenVertexArrays)
+    {
+        constexpr CGUICaptureArgument kind = (record == CGUI_CAPTURE_CALL_GenBuffers) ? CGUICaptureArgument::BUFFER :
+                                             (record == CGUI_CAPTURE_CALL_GenFramebuffers) ? CGUICaptureArgument::FRAMEBUFFER :
+                                             (record == CGUI_CAPTURE_CALL_GenRenderbuffers) ? CGUICaptureArgument::RENDERBUFFER :
+                                             (record == CGUI_CAPTURE_CALL_GenTextures) ? CGUICaptureArgument::TEXTURE : CGUICaptureArgument::VERTEX_ARRAY;
+
+        const uint8_t* captured_ids = capture.data() + read_offset - blob_size;
+        for (std::size_t object_index = 0; object_index < object_ids.size() && object_index < blob_size / sizeof(GLuint); ++object_index)
+        {
+            GLuint captured_id = 0;
+            std::memcpy(&captured_id, captured_ids + object_index * sizeof(GLuint), sizeof(GLuint));
+            object_names[(std::size_t)kind][captured_id] = object_ids[object_index];
+        }
+    }
+
+    CGUIReplayTiming& timing = timings[record];
+    timing.calls++;
+    timing.total_time += call_time;
+    timing.max_time = std::max(timing.max_time, call_time);
+
+    frames.back().calls++;
+    frames.back().cpu_time += call_time;
+}
+
+/**
+ * @brief      Reads argument, that is stored in the call record.
+ *
+ * @param      argument  Argument to fill.
+ * @param      strings   Storage of string arguments.
+ */
+template<CGUICaptureRecord record, std::size_t index, typename Argument>
+void CGUIFrameReplayer::read_argument(Argument& argument, std::vector<std::string>& strings)
+{
+    constexpr CGUICaptureArgument kind = cgui_capture_signature(record).arguments[index];
+
+    if constexpr (kind == CGUICaptureArgument::STRING)
+    {
+        strings.push_back(read_string());
+        argument = strings.back().c_str();
+    }
+    else if constexpr (kind == CGUICaptureArgument::OUTPUT)
+    {
+        argument = static_cast<Argument>(static_cast<void*>(scratch.data()));
+    }
+    else if constexpr (kind != CGUICaptureArgument::PAYLOAD)
+    {
+        read_data(&argument, sizeof(Argument));
+    }
+}
+
+/**
+ * @brief      Replaces captured object name, sync or location with replayed one.
+ *
+ * @param      argument  Argument to remap.
+ */
+template<CGUICaptureRecord record, std::size_t index, typename Argument>
+void CGUIFrameReplayer::remap_argument(Argument& argument)
+{
+    constexpr CGUICaptureArgument kind = cgui_capture_signature(record).arguments[index];
+
+    if constexpr (kind == CGUICaptureArgument::SYNC)
+    {
+        argument = map_sync(argument);
+    }
+    else if constexpr (kind == CGUICaptureArgument::LOCATION)
+    {
+        argument = map_location(argument);
+    }
+    else if constexpr (kind >= CGUICaptureArgument::BUFFER && kind <= CGUICaptureArgument::SHADER)
+    {
+        argument = map_object(kind, argument);
+    }
+}
+
+/**
+ * @brief      Replays one call record.
+ *
+ * @param[in]  record  Captured function.
+ */
+void CGUIFrameReplayer::replay_call(CGUICaptureRecord record)
+{
+    switch (record)
+    {
+        #define CGUI_CAPTURE_REPLAY(name, ...) case CGUI_CAPTURE_CALL_##name: replay_function<CGUI_CAPTURE_CALL_##name>(glad_gl##name); break;
+        CGUI_CAPTURE_FUNCTIONS(CGUI_CAPTURE_REPLAY)
+        #undef CGUI_CAPTURE_REPLAY
+
+        default:
+            fail("Unknown call record " + std::to_string((unsigned int)record) + ".");
+            break;
+    }
+}
+
+/**
+ * @brief      Recreates object or state from snapshot record.
+ *
+ * @param[in]  record  Snapshot record.
+ */
+void CGUIFrameReplayer::replay_snapshot(CGUICaptureRecord record)
+{
+    uint32_t blob_size = 0;
+
+    switch (record)
+    {
+        case CGUI_CAPTURE_SNAPSHOT_BUFFER:
+        {
+            GLuint captured_id = read_value<GLuint>();
+            uint64_t size = read_value<uint64_t>();
+            GLenum usage = read_value<GLenum>();
+            const uint8_t* data = read_blob(blob_size);
+
+            GLuint buffer_id = 0;
+            glGenBuffers(1, &buffer_id);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_id);
+            glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)size, (blob_size == size) ? data : nullptr, usage);
+            object_names[(std::size_t)CGUICaptureArgument::BUFFER][captured_id] = buffer_id;
+        }
+        break;
+
+        case CGUI_CAPTURE_SNAPSHOT_TEXTURE:
+        {
+            GLuint captured_id = read_value<GLuint>();
+            GLint parameters[7] = {};
+            read_data(parameters, sizeof(parameters));
+            const uint8_t* data = read_blob(blob_size);
+
+            // Pixel store state is restored by the state snapshot, that follows
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+            GLuint texture_id = 0;
+            glGenTextures(1, &texture_id);
+            glBindTexture(GL_TEXTURE_2D, texture_id);
+            glTexImage2D(GL_TEXTURE_2D, 0, parameters[2], parameters[0], parameters[1], 0, GL_RGBA, GL_UNSIGNED_BYTE, (blob_size != 0) ? data : nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, parameters[3]);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, parameters[4]);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, parameters[5]);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, parameters[6]);
+            object_names[(std::size_t)CGUICaptureArgument::TEXTURE][captured_id] = texture_id;
+        }
+        break;
+
+        case CGUI_CAPTURE_SNAPSHOT_RENDERBUFFER:
+        {
+            GLuint captured_id = read_value<GLuint>();
+            GLint parameters[4] = {};
+            read_data(parameters, sizeof(parameters));
+
+            GLuint renderbuffer_id = 0;
+            glGenRenderbuffers(1, &renderbuffer_id);
+            glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer_id);
+            glRenderbufferStorageMultisample(GL_RENDERBUFFER, parameters[3], parameters[2], parameters[0], parameters[1]);
+            object_names[(std::size_t)CGUICaptureArgument::RENDERBUFFER][captured_id] = renderbuffer_id;
+        }
+        break;
+
+        case CGUI_CAPTURE_SNAPSHOT_PROGRAM:
+        {
+            GLuint captured_id = read_value<GLuint>();
+            uint32_t stage_count = read_value<uint32_t>();
+
+            GLuint program_id = glCreateProgram();
+            std::vector<GLuint> shader_ids;
+
+            for (uint32_t stage_index = 0; stage_index < stage_count && error.empty(); ++stage_index)
+            {
+                GLenum stage_type = read_value<GLenum>();
+                const GLchar* source = reinterpret_cast<const GLchar*>(read_blob(blob_size));
+                GLint source_length = (GLint)blob_size;
+
+                GLuint shader_id = glCreateShader(stage_type);
+                glShaderSource(shader_id, 1, &source, &source_length);
+                glCompileShader(shader_id);
+                glAttachShader(program_id, shader_id);
+                shader_ids.push_back(shader_id);
+            }
+
+            glLinkProgram(program_id);
+
+            GLint link_status = GL_FALSE;
+            glGetProgramiv(program_id, GL_LINK_STATUS, &link_status);
+            if (link_status != GL_TRUE)
+            {
+                fail("Unable to link captured program " + std::to_string(captured_id) + ".");
+            }
+
+            for (GLuint shader_id : shader_ids)
+            {
+                glDetachShader(program_id, shader_id);
+                glDeleteShader(shader_id);
+            }
+            object_names[(std::size_t)CGUICaptureArgument::PROGRAM][captured_id] = program_id;
+        }
+        break;
+
+        case CGUI_CAPTURE_SNAPSHOT_UNIFORM:
+        {
+            GLuint captured_program = read_value<GLuint>();
+            GLint captured_location = read_value<GLint>();
+            GLenum uniform_type = read_value<GLenum>();
+            std::string uniform_name = read_string();
+            uint8_t value[16 * sizeof(GLfloat)] = {};
+            read_data(value, sizeof(value));
+
+            GLuint program_id = map_object(CGUICaptureArgument::PROGRAM, captured_program);
+            GLint location = glGetUniformLocation(program_id, uniform_name.c_str());
+
+            locations[((uint64_t)captured_program << 32) | (uint32_t)captured_location] = location;
+            replay_uniform(program_id, location, uniform_type, value);
+        }
+        break;
+
+        case CGUI_CAPTURE_SNAPSHOT_VERTEX_ARRAY:
+        {
+            GLuint captured_id = read_value<GLuint>();
+            GLuint element_buffer = read_value<GLuint>();
+            std::vector<CGUICaptureAttribute> attributes(read_value<uint32_t>());
+            read_data(attributes.data(), attributes.size() * sizeof(CGUICaptureAttribute));
+
+            GLuint vertex_array_id = 0;
+            glGenVertexArrays(1, &vertex_array_id);
+            glBindVertexArray(vertex_array_id);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, map_object(CGUICaptureArgument::BUFFER, element_buffer));
+
+            for (const CGUICaptureAttribute& attribute : attributes)
+            {
+                if (attribute.buffer != 0)
+                {
+                    const void* offset = reinterpret_cast<const void*>((uintptr_t)attribute.offset);
+                    glBindBuffer(GL_ARRAY_BUFFER, map_object(CGUICaptureArgument::BUFFER, (GLuint)attribute.buffer));
+
+                    if (attribute.integer == GL_TRUE)
+                    {
+                        glVertexAttribIPointer(attribute.index, attribute.size, attribute.type, attribute.stride, offset);
+                    }
+                    else
+                    {
+                        glVertexAttribPointer(attribute.index, attribute.size, attribute.type, (GLboolean)attribute.normalized, attribute.stride, offset);
+                    }
+                }
+
+                glVertexAttribDivisor(attribute.index, attribute.divisor);
+                if (attribute.enabled == GL_TRUE)
+                {
+                    glEnableVertexAttribArray(attribute.index);
+                }
+            }
+            object_names[(std::size_t)CGUICaptureArgument::VERTEX_ARRAY][captured_id] = vertex_array_id;
+        }
+        break;
+
+        case CGUI_CAPTURE_SNAPSHOT_FRAMEBUFFER:
+        {
+            GLuint captured_id = read_value<GLuint>();
+            std::vector<CGUICaptureAttachment> attachments(read_value<uint32_t>());
+            read_data(attachments.data(), attachments.size() * sizeof(CGUICaptureAttachment));
+
+            GLuint framebuffer_id = 0;
+            glGenFramebuffers(1, &framebuffer_id);
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_id);
+
+            for (const CGUICaptureAttachment& attachment : attachments)
+            {
+                if (attachment.object_type == GL_TEXTURE)
+                {
+                    glFramebufferTexture2D(GL_FRAMEBUFFER, attachment.attachment, GL_TEXTURE_2D, map_object(CGUICaptureArgument::TEXTURE, attachment.object_id), attachment.level);
+                }
+                else
+                {
+                    glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment.attachment, GL_RENDERBUFFER, map_object(CGUICaptureArgument::RENDERBUFFER, attachment.object_id));
+                }
+            }
+            object_names[(std::size_t)CGUICaptureArgument::FRAMEBUFFER][captured_id] = framebuffer_id;
+        }
+        break;
+
+        case CGUI_CAPTURE_SNAPSHOT_STATE:
+        {
+            CGUICaptureState state = read_value<CGUICaptureState>();
+
+            for (std::size_t cap_index = 0; cap_index < std::size(cgui_capture_caps); ++cap_index)
+            {
+                if (state.enabled_caps & (1u << cap_index))
+                {
+                    glEnable(cgui_capture_caps[cap_index]);
+                }
+                else
+                {
+                    glDisable(cgui_capture_caps[cap_index]);
+                }
+            }
+
+            glBlendFuncSeparate(state.blend_func[0], state.blend_func[1], state.blend_func[2], state.blend_func[3]);
+            glViewport(state.viewport[0], state.viewport[1], state.viewport[2], state.viewport[3]);
+            glScissor(state.scissor_box[0], state.scissor_box[1], state.scissor_box[2], state.scissor_box[3]);
+            glClearColor(state.clear_color[0], state.clear_color[1], state.clear_color[2], state.clear_color[3]);
+
+            current_program = (GLuint)state.program;
+            glUseProgram(map_object(CGUICaptureArgument::PROGRAM, (GLuint)state.program));
+            glBindVertexArray(map_object(CGUICaptureArgument::VERTEX_ARRAY, (GLuint)state.vertex_array));
+            glBindBuffer(GL_ARRAY_BUFFER, map_object(CGUICaptureArgument::BUFFER, (GLuint)state.array_buffer));
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, map_object(CGUICaptureArgument::BUFFER, (GLuint)state.pixel_unpack_buffer));
+            glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, map_object(CGUICaptureArgument::BUFFER, (GLuint)state.dispatch_indirect_buffer));
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, map_object(CGUICaptureArgument::FRAMEBUFFER, (GLuint)state.read_framebuffer));
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, map_object(CGUICaptureArgument::FRAMEBUFFER, (GLuint)state.draw_framebuffer));
+            glBindRenderbuffer(GL_RENDERBUFFER, map_object(CGUICaptureArgument::RENDERBUFFER, (GLuint)state.renderbuffer));
+
+            for (GLint unit_index = 0; unit_index < 8; ++unit_index)
+            {
+                glActiveTexture(GL_TEXTURE0 + unit_index);
+                glBindTexture(GL_TEXTURE_2D, map_object(CGUICaptureArgument::TEXTURE, (GLuint)state.texture_units[unit_index]));
+            }
+            glActiveTexture(state.active_texture);
+
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, state.unpack_row_length);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, state.unpack_alignment);
+            glPixelStorei(GL_PACK_ALIGNMENT, state.pack_alignment);
+        }
+        break;
+
+        default:
+            fail("Unknown snapshot record " + std::to_string((unsigned int)record) + ".");
+            break;
+    }
+}
+
+/**
+ * @brief      Sets default block uniform from snapshot.
+ *
+ * @param[in]  program_id  Replayed program.
+ * @param[in]  location    Replayed location.
+ * @param[in]  type        Type of the uniform.
+ * @param[in]  value       Raw value, up to 16 components.
+ */
+void CGUIFrameReplayer::replay_uniform(GLuint program_id, GLint location, GLenum type, const uint8_t* value)
+{
+    if (location < 0)
+    {
+        return;
+    }
+
+    GLfloat float_value[16];
+    GLint int_value[16];
+    GLuint uint_value[16];
+    std::memcpy(float_value, value, sizeof(float_value));
+    std::memcpy(int_value, value, sizeof(int_value));
+    std::memcpy(uint_value, value, sizeof(uint_value));
+
+    GLint components = cgui_capture_uniform_components(type);
+
+    switch (type)
+    {
+        case GL_FLOAT_MAT2:
+            glProgramUniformMatrix2fv(program_id, location, 1, GL_FALSE, float_value);
+            return;
+        case GL_FLOAT_MAT3:
+            glProgramUniformMatrix3fv(program_id, location, 1, GL_FALSE, float_value);
+            return;
+        case GL_FLOAT_MAT4:
+            glProgramUniformMatrix4fv(program_id, location, 1, GL_FALSE, float_value);
+            return;
+        default:
+            break;
+    }
+
+    switch (cgui_capture_uniform_base(type))
+    {
+        case GL_FLOAT:
+            (components == 1) ? glProgramUniform1fv(program_id, location, 1, float_value) :
+            (components == 2) ? glProgramUniform2fv(program_id, location, 1, float_value) :
+            (components == 3) ? glProgramUniform3fv(program_id, location, 1, float_value) : glProgramUniform4fv(program_id, location, 1, float_value);
+            break;
+        case GL_UNSIGNED_INT:
+            (components == 1) ? glProgramUniform1uiv(program_id, location, 1, uint_value) :
+            (components == 2) ? glProgramUniform2uiv(program_id, location, 1, uint_value) :
+            (components == 3) ? glProgramUniform3uiv(program_id, location, 1, uint_value) : glProgramUniform4uiv(program_id, location, 1, uint_value);
+            break;
+        default:
+            (components == 1) ? glProgramUniform1iv(program_id, location, 1, int_value) :
+            (components == 2) ? glProgramUniform2iv(program_id, location, 1, int_value) :
+            (components == 3) ? glProgramUniform3iv(program_id, location, 1, int_value) : glProgramUniform4iv(program_id, location, 1, int_value);
+            break;
+    }
+}
+
+/**
+ * @brief      Finishes timing of the frame and presents it.
+ *
+ * @param      window  Window of current context.
+ */
+void CGUIFrameReplayer::end_frame(GLFWwindow* window)
+{
+    if (!frame_open)
+    {
+        frames.emplace_back();
+    }
+    else
+    {
+        glEndQuery(GL_TIME_ELAPSED);
+        frame_open = false;
+    }
+
+    std::chrono::time_point<std::chrono::steady_clock> swap_start = std::chrono::steady_clock::now();
+    if (window != nullptr)
+    {
+        glfwSwapBuffers(window);
+    }
+    frames.back().cpu_time += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - swap_start).count();
+}
+
+/**
+ * @brief      Reads raw data from capture.
+ *
+ * @param      data  Destination.
+ * @param[in]  size  Size of the data.
+ *
+ * @return     False if capture is truncated.
+ */
+bool CGUIFrameReplayer::read_data(void* data, std::size_t size)
+{
+    if (size > capture.size() - read_offset)
+    {
+        fail("Capture is truncated.");
+        read_offset = capture.size();
+        std::memset(data, 0, size);
+        return false;
+    }
+
+    if (size != 0)
+    {
+        std::memcpy(data, capture.data() + read_offset, size);
+    }
+    read_offset += size;
+    return true;
+}
+
+/**
+ * @brief      Reads data with its size from capture without copying it.
+ *
+ * @param[out] size  Size of the data.
+ *
+ * @return     Pointer into loaded capture.
+ */
+const uint8_t* CGUIFrameReplayer::read_blob(uint32_t& size)
+{
+    size = read_value<uint32_t>();
+    if (size > capture.size() - read_offset)
+    {
+        fail("Capture is truncated.");
+        read_offset = capture.size();
+        size = 0;
+        return nullptr;
+    }
+
+    const uint8_t* data = capture.data() + read_offset;
+    read_offset += size;
+    return data;
+}
+
+/**
+ * @brief      Reads string from capture.
+ *
+ * @return     String.
+ */
+std::string CGUIFrameReplayer::read_string()
+{
+    uint32_t size = 0;
+    const uint8_t* data = read_blob(size);
+    return (data != nullptr) ? std::string(reinterpret_cast<const char*>(data), size) : std::string();
+}
+
+/**
+ * @brief      Maps captured object name to replayed one.
+ *
+ * @param[in]  kind       Type of the object.
+ * @param[in]  object_id  Captured name.
+ *
+ * @return     Replayed name, captured name if object was never captured.
+ */
+GLuint CGUIFrameReplayer::map_object(CGUICaptureArgument kind, GLuint object_id)
+{
+    if (object_id == 0)
+    {
+        return 0;
+    }
+
+    std::unordered_map<GLuint, GLuint>& names = object_names[(std::size_t)kind];
+    auto name_iterator = names.find(object_id);
+    if (name_iterator == names.end())
+    {
+        unmapped_names++;
+        return object_id;
+    }
+    return name_iterator->second;
+}
+
+/**
+ * @brief      Maps captured uniform location of the current program to replayed one.
+ *
+ * @param[in]  location  Captured location.
+ *
+ * @return     Replayed location, captured one if it was never queried.
+ */
+GLint CGUIFrameReplayer::map_location(GLint location)
+{
+    auto location_iterator = locations.find(((uint64_t)current_program << 32) | (uint32_t)location);
+    return (location_iterator != locations.end()) ? location_iterator->second : location;
+}
+
+/**
+ * @brief      Maps captured sync object to replayed one.
+ *
+ * @param[in]  sync  Captured sync.
+ *
+ * @return     Replayed sync.
+ */
+GLsync CGUIFrameReplayer::map_sync(GLsync sync)
+{
+    auto sync_iterator = syncs.find((uint64_t)(uintptr_t)sync);
+    return (sync_iterator != syncs.end()) ? sync_iterator->second : nullptr;
+}
+
+/**
+ * @brief      Stops replay with error.
+ *
+ * @param[in]  message  Description of the error.
+ */
+void CGUIFrameReplayer::fail(const std::string& message)
+{
+    if (error.empty())
+    {
+        error = message;
+    }
+}
@@ -0,0 +1,149 @@
+/**
+ * @file       <CGUIFrameReplayer.hpp>
+ * @brief      This header file implements CGUIFrameReplayer class.
+ *
+ *             It is being used in order to re-execute frame captures and
+ *             measure time of every GL call.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUIFRAMEREPLAYER_HPP
+#define CGUIFRAMEREPLAYER_HPP
+
+/**
+ * Include GLFW and GLAD for window handling.
+ */
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+
+#include "CGUIFrameCaptureFormat.hpp"
+
+#include <unordered_map>
+#include <filesystem>
+#include <ostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Timing of one captured function.
+ */
+struct CGUIReplayTiming
+{
+    uint64_t    calls       = 0;
+    double      total_time  = 0.0;          // Microseconds
+    double      max_time    = 0.0;          // Microseconds
+};
+
+/**
+ * Timing of one captured frame.
+ */
+struct CGUIReplayFrame
+{
+    uint64_t    calls       = 0;
+    double      cpu_time    = 0.0;          // Microseconds, sum of call times
+    double      gpu_time    = 0.0;          // Microseconds, from timer query
+    GLuint      query_id    = 0;
+};
+
+/**
+ * @brief      This class implements replay of frame captures, written by CGUIFrameCapture.
+ *
+ *             Snapshot records recreate objects and state, then every call is decoded, its object
+ *             names are remapped to names created by replay, and it is executed through glad and
+ *             timed. Optionally every call is followed by glFinish, so time includes GPU work.
+ *             Replay needs current GL context, created by the caller.
+ */
+class CGUIFrameReplayer
+{
+public:
+    CGUIFrameReplayer();
+    CGUIFrameReplayer(const CGUIFrameReplayer&) = delete;
+    ~CGUIFrameReplayer();
+
+    bool load(const std::filesystem::path& capture_path);
+    bool replay(GLFWwindow* window, bool finish_calls = false);
+
+    void print_report(std::ostream& output);
+
+    const CGUICaptureHeader& get_header();
+    const std::string& get_error();
+
+private:
+    template<CGUICaptureRecord record, typename Result, typename... Arguments>
+    void replay_function(Result (GLAD_API_PTR *function)(Arguments...));
+
+    template<CGUICaptureRecord record, std::size_t index, typename Argument>
+    void read_argument(Argument& argument, std::vector<std::string>& strings);
+
+    template<CGUICaptureRecord record, std::size_t index, typename Argument>
+    void remap_argument(Argument& argument);
+
+    void replay_call(CGUICaptureRecord record);
+    void replay_snapshot(CGUICaptureRecord record);
+    void replay_uniform(GLuint program_id, GLint location, GLenum type, const uint8_t* value);
+    void end_frame(GLFWwindow* window);
+
+    bool            read_data(void* data, std::size_t size);
+    const uint8_t*  read_blob(uint32_t& size);
+    std::string     read_string();
+
+    template<typename Value>
+    Value read_value()
+    {
+        Value value = {};
+        read_data(&value, sizeof(Value));
+        return value;
+    }
+
+    GLuint map_object(CGUICaptureArgument kind, GLuint object_id);
+    GLint  map_location(GLint location);
+    GLsync map_sync(GLsync sync);
+
+    void fail(const std::string& message);
+
+private:
+    CGUICaptureHeader       header;
+    std::string             renderer_name;
+    std::string             renderer_version;
+    std::vector<uint8_t>    capture;
+    std::size_t             read_offset         = 0;
+    std::size_t             stream_offset       = 0;
+    std::string             error;
+
+    /**
+     * Captured names to replayed ones, indexed by CGUICaptureArgument.
+     */
+    std::unordered_map<GLuint, GLuint>      object_names[(std::size_t)CGUICaptureArgument::LOCATION + 1];
+    std::unordered_map<uint64_t, GLint>     locations;
+    std::unordered_map<uint64_t, GLsync>    syncs;
+    std::unordered_map<GLenum, void*>       mapped_pointers;
+    GLuint                                  current_program     = 0;
+    uint64_t                                unmapped_names      = 0;
+
+    std::vector<uint8_t>    scratch;
+    bool                    finish_after_call   = false;
+
+    CGUIReplayTiming                timings[CGUI_CAPTURE_CALL_COUNT];
+    std::vector<CGUIReplayFrame>    frames;
+    bool                            frame_open          = false;
+    double                          snapshot_time       = 0.0;
+};
+
+#endif // CGUIFRAMEREPLAYER_HPP
@@ -0,0 +1,76 @@
+#include "CGUIFrameReplayer.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+/**
+ * Usage: cgui_replay <capture> [--finish]
+ *
+ * Replays frame capture in hidden window and prints timing of every frame and GL function.
+ * With --finish every call is followed by glFinish, so its time includes GPU work.
+ */
+int main(int argc, char const *argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: cgui_replay <capture> [--finish]\n";
+		return 1;
+	}
+
+	bool finish_calls = (argc > 2 && std::string(argv[2]) == "--finish");
+
+	CGUIFrameReplayer replayer;
+	if (!replayer.load(argv[1]))
+	{
+		std::cerr << replayer.get_error() << "\n";
+		return 1;
+	}
+
+	// Null platform is used, when there is no display
+	if (!glfwInit())
+	{
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+		if (!glfwInit())
+		{
+			std::cerr << "Unable to initialize GLFW.\n";
+			return 1;
+		}
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+	const CGUICaptureHeader& header = replayer.get_header();
+	GLFWwindow* window = glfwCreateWindow(std::max(header.framebuffer_width, 1), std::max(header.framebuffer_height, 1), "cgui_replay", nullptr, nullptr);
+	if (window == nullptr)
+	{
+		std::cerr << "Unable to create GL 4.6 context.\n";
+		glfwTerminate();
+		return 1;
+	}
+
+	glfwMakeContextCurrent(window);
+	if (!gladLoadGL(glfwGetProcAddress))
+	{
+		std::cerr << "Unable to properly initialize GLAD.\n";
+		glfwDestroyWindow(window);
+		glfwTerminate();
+		return 1;
+	}
+
+	bool replayed = replayer.replay(window, finish_calls);
+	replayer.print_report(std::cout);
+	if (!replayed)
+	{
+		std::cerr << replayer.get_error() << "\n";
+	}
+
+	glfwDestroyWindow(window);
+	glfwTerminate();
+
+	return (replayed) ? 0 : 1;
+}
@@ -0,0 +1,375 @@
+/**
+ * @file       <CGUIMemoryTracker.cpp>
+ * @brief      This source file implements CGUIMemoryTracker class.
+ *
+ *             It is being used in order to account memory of every GL object,
+ *             enforce budgets and report objects, that were never deleted.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUIMemoryTracker.hpp"
+
+#include <algorithm>
+
+/**
+ * Main memory tracker, that is shared by all GL object wrappers.
+ */
+CGUIMemoryTracker main_memory_tracker;
+
+/**
+ * @brief      Constructs a new memory tracker.
+ */
+CGUIMemoryTracker::CGUIMemoryTracker()
+{
+    for (std::size_t category = 0; category < CGUI_MEMORY_CATEGORY_COUNT; ++category)
+    {
+        budgets[category] = CGUI_MEMORY_UNLIMITED;
+    }
+}
+
+/**
+ * @brief      Destroys memory tracker.
+ */
+CGUIMemoryTracker::~CGUIMemoryTracker()
+{
+    records.clear();
+    eviction_callbacks.clear();
+}
+
+/**
+ * @brief      Registers GL object, registering the same object again replaces its record.
+ *
+ * @param[in]  category   Category of the object.
+ * @param[in]  object_id  GL name of the object.
+ * @param[in]  size       Size of the object in bytes.
+ * @param[in]  usage      Usage hint, GL_NONE if object has none.
+ * @param[in]  owner      Owner tag, shown in reports.
+ */
+void CGUIMemoryTracker::register_object(std::size_t category, GLuint object_id, std::size_t size, GLenum usage, const std::string& owner)
+{
+    if (category >= CGUI_MEMORY_CATEGORY_COUNT || object_id == 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard tracker_lock(tracker_mutex);
+
+        auto record_iterator = records.find(record_key(category, object_id));
+        if (record_iterator != records.end())
+        {
+            totals[category] -= record_iterator->second.size;
+            counts[category]--;
+        }
+
+        records[record_key(category, object_id)] = {category, object_id, size, usage, owner};
+        totals[category] += size;
+        counts[category]++;
+    }
+
+    enforce_budget(category);
+}
+
+/**
+ * @brief      Updates size of registered object, e.g. after buffer reallocation.
+ *
+ * @param[in]  category   Category of the object.
+ * @param[in]  object_id  GL name of the object.
+ * @param[in]  size       New size in bytes.
+ */
+void CGUIMemoryTracker::resize_object(std::size_t category, GLuint object_id, std::size_t size)
+{
+    {
+        std::lock_guard tracker_lock(tracker_mutex);
+
+        auto record_iterator = records.find(record_key(category, object_id));
+        if (record_iterator == records.end())
+        {
+            return;
+        }
+
+        totals[category] = totals[category] - record_iterator->second.size + size;
+        record_iterator->second.size = size;
+    }
+
+    enforce_budget(category);
+}
+
+/**
+ * @brief      Removes object from registry, should be called when object is deleted.
+ *
+ * @param[in]  category   Category of the object.
+ * @param[in]  object_id  GL name of the object.
+ */
+void CGUIMemoryTracker::unregister_object(std::size_t category, GLuint object_id)
+{
+    std::lock_guard tracker_lock(tracker_mutex);
+
+    auto record_iterator = records.find(record_key(category, object_id));
+    if (record_iterator == records.end())
+    {
+        return;
+    }
+
+    totals[category] -= record_iterator->second.size;
+    counts[category]--;
+    records.erase(record_iterator);
+}
+
+/**
+ * @brief      Sets memory budget of the category.
+ *
+ * @param[in]  category  Category of objects.
+ * @param[in]  budget    Budget in bytes, CGUI_MEMORY_UNLIMITED disables it.
+ */
+void CGUIMemoryTracker::set_budget(std::size_t category, std::size_t budget)
+{
+    if (category >= CGUI_MEMORY_CATEGORY_COUNT)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard tracker_lock(tracker_mutex);
+        budgets[category] = budget;
+    }
+
+    enforce_budget(category);
+}
+
+/**
+ * @brief      Adds callback, that is called when category exceeds its budget.
+ *
+ * @param[in]  category  Category of objects.
+ * @param[in]  callback  Eviction callback.
+ *
+ * @return     Id of the callback, that can be used in order to remove it.
+ */
+std::size_t CGUIMemoryTracker::add_eviction_callback(std::size_t category, CGUIEvictionCallback callback)
+{
+    std::lock_guard tracker_lock(tracker_mutex);
+
+    eviction_callbacks.push_back({next_callback_id, category, callback});
+    return next_callback_id++;
+}
+
+/**
+ * @brief      Removes eviction callback.
+ *
+ * @param[in]  callback_id  Id of the callback.
+ */
+void CGUIMemoryTracker::remove_eviction_callback(std::size_t callback_id)
+{
+    std::lock_guard tracker_lock(tracker_mutex);
+
+    eviction_callbacks.erase(std::remove_if(eviction_callbacks.begin(), eviction_callbacks.end(),
+        [callback_id](const CGUIEvictionEntry& entry){ return entry.callback_id == callback_id; }), eviction_callbacks.end());
+}
+
+/**
+ * @brief      Gets memory used by category.
+ *
+ * @param[in]  category  Category of objects.
+ *
+ * @return     Total size in bytes.
+ */
+std::size_t CGUIMemoryTracker::get_total(std::size_t category)
+{
+    std::lock_guard tracker_lock(tracker_mutex);
+    return (category < CGUI_MEMORY_CATEGORY_COUNT) ? totals[category] : 0;
+}
+
+/**
+ * @brief      Gets amount of objects in category.
+ *
+ * @param[in]  category  Category of objects.
+ *
+ * @return     Amount of objects.
+ */
+std::size_t CGUIMemoryTracker::get_count(std::size_t category)
+{
+    std::lock_guard tracker_lock(tracker_mutex);
+    return (category < CGUI_MEMORY_CATEGORY_COUNT) ? counts[category] : 0;
+}
+
+/**
+ * @brief      Gets memory budget of category.
+ *
+ * @param[in]  category  Category of objects.
+ *
+ * @return     Budget in bytes, CGUI_MEMORY_UNLIMITED if there is none.
+ */
+std::size_t CGUIMemoryTracker::get_budget(std::size_t category)
+{
+    std::lock_guard tracker_lock(tracker_mutex);
+    return (category < CGUI_MEMORY_CATEGORY_COUNT) ? budgets[category] : CGUI_MEMORY_UNLIMITED;
+}
+
+/**
+ * @brief      Gets copy of records of every object in category.
+ *
+ * @param[in]  category  Category of objects.
+ *
+ * @return     Records in no particular order.
+ */
+std::vector<CGUIMemoryRecord> CGUIMemoryTracker::get_records(std::size_t category)
+{
+    std::lock_guard tracker_lock(tracker_mutex);
+
+    std::vector<CGUIMemoryRecord> category_records;
+    for (const auto& [key, record] : records)
+    {
+        if (record.category == category)
+        {
+            category_records.push_back(record);
+        }
+    }
+    return category_records;
+}
+
+/**
+ * @brief      Posts every object, that is still registered, as leaked.
+ *
+ *             Should be called at shutdown, after all owners released their objects.
+ *
+ * @return     Amount of leaked objects.
+ */
+std::size_t CGUIMemoryTracker::report_leaks()
+{
+    std::lock_guard tracker_lock(tracker_mutex);
+
+    for (const auto& [key, record] : records)
+    {
+        main_debug_handler.post_log("Leaked " + get_category_name(record.category) + " " + std::to_string(record.object_id) +
+                                    " of " + std::to_string(record.size) + " bytes, owner: " + record.owner, DEBUG_MODE_WARNING);
+    }
+
+    if (records.empty())
+    {
+        CGUI_POST_LOG(main_debug_handler, DEBUG_MODE_LOG, "No leaked GL objects.");
+    }
+    return records.size();
+}
+
+/**
+ * @brief      Estimates memory of linked program by its binary length.
+ *
+ * @param[in]  program_id  Linked program.
+ *
+ * @return     Size in bytes.
+ */
+std::size_t CGUIMemoryTracker::get_program_size(GLuint program_id)
+{
+    GLint binary_length = 0;
+    glGetProgramiv(program_id, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+    return (binary_length > 0) ? (std::size_t)binary_length : 0;
+}
+
+/**
+ * @brief      Gets printable name of category.
+ *
+ * @param[in]  category  Category of objects.
+ *
+ * @return     Name of the category.
+ */
+std::string CGUIMemoryTracker::get_category_name(std::size_t category)
+{
+    switch (category)
+    {
+        case CGUI_MEMORY_BUFFER:
+            return "buffer";
+        case CGUI_MEMORY_VERTEX_ARRAY:
+            return "vertex array";
+        case CGUI_MEMORY_PROGRAM:
+            return "program";
+        case CGUI_MEMORY_TEXTURE:
+            return "texture";
+        case CGUI_MEMORY_RENDERBUFFER:
+            return "renderbuffer";
+        default:
+            return "unknown";
+    }
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Calls eviction callbacks until category fits its budget.
+ *
+ * @param[in]  category  Category of objects.
+ */
+void CGUIMemoryTracker::enforce_budget(std::size_t category)
+{
+    std::vector<CGUIEvictionCallback> callbacks;
+    std::size_t over_budget;
+    {
+        std::lock_guard tracker_lock(tracker_mutex);
+
+        // Callbacks delete objects, which might register new ones, so eviction is never nested
+        if (budgets[category] == CGUI_MEMORY_UNLIMITED || totals[category] <= budgets[category] || evicting[category])
+        {
+            return;
+        }
+
+        evicting[category] = true;
+        for (const CGUIEvictionEntry& entry : eviction_callbacks)
+        {
+            if (entry.category == category)
+            {
+                callbacks.push_back(entry.callback);
+            }
+        }
+    }
+
+    for (CGUIEvictionCallback& callback : callbacks)
+    {
+        {
+            std::lock_guard tracker_lock(tracker_mutex);
+            if (totals[category] <= budgets[category])
+            {
+                break;
+            }
+            over_budget = totals[category] - budgets[category];
+        }
+        callback(over_budget);
+    }
+
+    std::lock_guard tracker_lock(tracker_mutex);
+    evicting[category] = false;
+
+    if (totals[category] > budgets[category])
+    {
+        main_debug_handler.post_log("Budget of " + get_category_name(category) + " category is exceeded: " +
+                                    std::to_string(totals[category]) + " of " + std::to_string(budgets[category]) + " bytes.", DEBUG_MODE_WARNING);
+    }
+}
+
+/**
+ * @brief      Builds registry key of the object.
+ *
+ * @param[in]  category   Category of the object.
+ * @param[in]  object_id  GL name of the object.
+ *
+ * @return     Unique key.
+ */
+uint64_t CGUIMemoryTracker::record_key(std::size_t category, GLuint object_id)
+{
+    return ((uint64_t)category << 32) | (uint64_t)object_id;
+}
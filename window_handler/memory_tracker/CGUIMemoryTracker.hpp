@@ -0,0 +1,141 @@
+/**
+ * @file       <CGUIMemoryTracker.hpp>
+ * @brief      This header file implements CGUIMemoryTracker class.
+ *
+ *             It is being used in order to account memory of every GL object,
+ *             enforce budgets and report objects, that were never deleted.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUIMEMORYTRACKER_HPP
+#define CGUIMEMORYTRACKER_HPP
+
+/**
+ * Include GLFW and GLAD for window handling.
+ */
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+
+#include "../debug_handler/CGUIDebugHandler.hpp"
+
+#include <unordered_map>
+#include <functional>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * GL object categories.
+ */
+#define CGUI_MEMORY_BUFFER          0
+#define CGUI_MEMORY_VERTEX_ARRAY    1
+#define CGUI_MEMORY_PROGRAM         2
+#define CGUI_MEMORY_TEXTURE         3
+#define CGUI_MEMORY_RENDERBUFFER    4
+#define CGUI_MEMORY_CATEGORY_COUNT  5
+
+/**
+ * Budget value, that disables budget of the category.
+ */
+#define CGUI_MEMORY_UNLIMITED       0
+
+/**
+ * Tracked GL object.
+ */
+struct CGUIMemoryRecord
+{
+    std::size_t category    = CGUI_MEMORY_BUFFER;
+    GLuint      object_id   = 0;
+    std::size_t size        = 0;
+    GLenum      usage       = GL_NONE;
+    std::string owner;
+};
+
+/**
+ * Eviction callback receives amount of bytes, that are over budget, it should
+ * delete objects it owns (unregistering them) and return amount of freed bytes.
+ */
+using CGUIEvictionCallback = std::function<std::size_t(std::size_t)>;
+
+/**
+ * @brief      This class implements registry of GL allocations.
+ *
+ *             Every object is identified by its category and GL name. Registry can be used
+ *             from any thread, eviction callbacks are called on the thread, that registered
+ *             or resized object, which exceeded the budget, with registry unlocked.
+ */
+class CGUIMemoryTracker
+{
+public:
+    CGUIMemoryTracker();
+    CGUIMemoryTracker(const CGUIMemoryTracker&) = delete;
+    ~CGUIMemoryTracker();
+
+    void register_object(std::size_t category, GLuint object_id, std::size_t size, GLenum usage, const std::string& owner);
+    void resize_object(std::size_t category, GLuint object_id, std::size_t size);
+    void unregister_object(std::size_t category, GLuint object_id);
+
+    void        set_budget(std::size_t category, std::size_t budget);
+    std::size_t add_eviction_callback(std::size_t category, CGUIEvictionCallback callback);
+    void        remove_eviction_callback(std::size_t callback_id);
+
+    std::size_t get_total(std::size_t category);
+    std::size_t get_count(std::size_t category);
+    std::size_t get_budget(std::size_t category);
+
+    std::vector<CGUIMemoryRecord> get_records(std::size_t category);
+
+    std::size_t report_leaks();
+
+    static std::size_t get_program_size(GLuint program_id);
+    static std::string get_category_name(std::size_t category);
+
+private:
+    void enforce_budget(std::size_t category);
+
+    static uint64_t record_key(std::size_t category, GLuint object_id);
+
+private:
+    /**
+     * Registered eviction callback.
+     */
+    struct CGUIEvictionEntry
+    {
+        std::size_t             callback_id;
+        std::size_t             category;
+        CGUIEvictionCallback    callback;
+    };
+
+    std::unordered_map<uint64_t, CGUIMemoryRecord> records;
+
+    std::size_t totals[CGUI_MEMORY_CATEGORY_COUNT]      = {};
+    std::size_t counts[CGUI_MEMORY_CATEGORY_COUNT]      = {};
+    std::size_t budgets[CGUI_MEMORY_CATEGORY_COUNT]     = {};
+    bool        evicting[CGUI_MEMORY_CATEGORY_COUNT]    = {};
+
+    std::vector<CGUIEvictionEntry> eviction_callbacks;
+    std::size_t next_callback_id = 1;
+
+    std::mutex tracker_mutex;
+};
+
+extern CGUIMemoryTracker main_memory_tracker;
+
+#endif // CGUIMEMORYTRACKER_HPP
@@ -27,6 +27,13 @@
 
 #include "./ebo_handler/CGUIEBOHandler.hpp"
 #include "./vao_handler/CGUIVAOHandler.hpp"
+#include "./line_renderer/CGUILineRenderer.hpp"
+#include "./damage_tracker/CGUIDamageTracker.hpp"
+#include "./layer_cache/CGUILayerCache.hpp"
+#include "./upload_handler/CGUIUploadHandler.hpp"
+#include "./deletion_queue/CGUIDeletionQueue.hpp"
+#include "./software_renderer/CGUISoftwareRenderer.hpp"
+#include "./uniform_ring/CGUIUniformRing.hpp"
 
 
 class CGUIObjectRenderer
@@ -0,0 +1,412 @@
+/**
+ * @file       <CGUIDamageTracker.cpp>
+ * @brief      This source file implements CGUIDamageTracker class.
+ *
+ *             It is being used in order to collect dirty rectangles, redraw
+ *             only them into persistent frame target and skip unchanged frames.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUIDamageTracker.hpp"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * FNV-1a constants, used for draw list hashing.
+ */
+#define CGUI_DAMAGE_HASH_OFFSET 0xcbf29ce484222325ULL
+#define CGUI_DAMAGE_HASH_PRIME  0x00000100000001b3ULL
+
+/**
+ * @brief      Constructs a new damage tracker.
+ *
+ * @param[in]  max_rects_arg          Maximum amount of rectangles after merge.
+ * @param[in]  full_redraw_ratio_arg  Damaged part of the frame, after which whole frame is redrawn.
+ */
+CGUIDamageTracker::CGUIDamageTracker(std::size_t max_rects_arg, float full_redraw_ratio_arg)
+{
+    max_rects = std::max<std::size_t>(max_rects_arg, 1);
+    full_redraw_ratio = full_redraw_ratio_arg;
+}
+
+/**
+ * @brief      Destroys damage tracker.
+ */
+CGUIDamageTracker::~CGUIDamageTracker()
+{
+    pending_damage.clear();
+    frame_damage.clear();
+}
+
+/**
+ * @brief      Marks region as damaged, can be called from any thread.
+ *
+ * @param[in]  position  Top left corner in framebuffer pixels.
+ * @param[in]  size      Size of the region.
+ */
+void CGUIDamageTracker::add_damage(glm::ivec2 position, glm::ivec2 size)
+{
+    if (size.x <= 0 || size.y <= 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard damage_lock(damage_mutex);
+        pending_damage.push_back({position, size});
+    }
+    damage_con_v.notify_one();
+}
+
+/**
+ * @brief      Marks the whole frame as damaged, can be called from any thread.
+ */
+void CGUIDamageTracker::add_full_damage()
+{
+    {
+        std::lock_guard damage_lock(damage_mutex);
+        full_damage = true;
+    }
+    damage_con_v.notify_one();
+}
+
+/**
+ * @brief      Wakes thread, that waits for damage, without damaging anything.
+ *
+ *             Used for state, that is checked by the frame itself, like window closing.
+ */
+void CGUIDamageTracker::wake()
+{
+    {
+        std::lock_guard damage_lock(damage_mutex);
+        wake_requested = true;
+    }
+    damage_con_v.notify_one();
+}
+
+/**
+ * @brief      Starts hashing of the draw list for the next frame.
+ */
+void CGUIDamageTracker::begin_draw_list()
+{
+    draw_list_hash = CGUI_DAMAGE_HASH_OFFSET;
+}
+
+/**
+ * @brief      Hashes raw bytes of draw list state.
+ *
+ * @param[in]  data  Pointer to data.
+ * @param[in]  size  Size of data in bytes.
+ */
+void CGUIDamageTracker::hash_draw_list(const void* data, std::size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+    for (std::size_t index = 0; index < size; ++index)
+    {
+        draw_list_hash = (draw_list_hash ^ bytes[index]) * CGUI_DAMAGE_HASH_PRIME;
+    }
+}
+
+/**
+ * @brief      Finishes draw list and decides which regions should be redrawn.
+ *
+ *             Changed draw list is always redrawn completely, even if damage was reported,
+ *             because there is no way to know what has changed.
+ *
+ * @param[in]  framebuffer_size  Current framebuffer size.
+ *
+ * @return     True if frame should be submitted, False if it can be skipped.
+ */
+bool CGUIDamageTracker::end_draw_list(glm::ivec2 framebuffer_size)
+{
+    if (framebuffer_size != target_size)
+    {
+        resize_target(framebuffer_size);
+    }
+
+    bool redraw_everything;
+    {
+        std::lock_guard damage_lock(damage_mutex);
+
+        frame_damage.swap(pending_damage);
+        pending_damage.clear();
+
+        redraw_everything = full_damage || draw_list_hash != last_draw_list_hash;
+        full_damage = false;
+    }
+
+    last_draw_list_hash = draw_list_hash;
+
+    clamp_damage(frame_damage);
+    merge_damage(frame_damage);
+
+    if (redraw_everything || get_damaged_area() > full_redraw_ratio * target_size.x * target_size.y)
+    {
+        frame_damage.assign(1, {{0, 0}, target_size});
+    }
+
+    return !frame_damage.empty();
+}
+
+/**
+ * @brief      Gets merged damage of the current frame.
+ *
+ * @return     Damaged rectangles.
+ */
+const std::vector<CGUIDamageRect>& CGUIDamageTracker::get_damage()
+{
+    return frame_damage;
+}
+
+/**
+ * @brief      Binds persistent frame target for drawing.
+ */
+void CGUIDamageTracker::bind_target()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer_id);
+    glViewport(0, 0, target_size.x, target_size.y);
+    glEnable(GL_SCISSOR_TEST);
+}
+
+/**
+ * @brief      Restricts drawing to a damaged rectangle.
+ *
+ * @param[in]  rect  Damaged rectangle.
+ */
+void CGUIDamageTracker::scissor(const CGUIDamageRect& rect)
+{
+    // GL scissor has bottom left origin
+    glScissor(rect.position.x, target_size.y - rect.position.y - rect.size.y, rect.size.x, rect.size.y);
+}
+
+/**
+ * @brief      Copies frame target into default framebuffer.
+ */
+void CGUIDamageTracker::present_target()
+{
+    glDisable(GL_SCISSOR_TEST);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, frame_buffer_id);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, target_size.x, target_size.y, 0, 0, target_size.x, target_size.y, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    frame_damage.clear();
+}
+
+/**
+ * @brief      Deletes frame target.
+ */
+void CGUIDamageTracker::destroy()
+{
+    main_memory_tracker.unregister_object(CGUI_MEMORY_RENDERBUFFER, color_buffer_id);
+
+    glDeleteFramebuffers(1, &frame_buffer_id);
+    glDeleteRenderbuffers(1, &color_buffer_id);
+
+    frame_buffer_id = 0;
+    color_buffer_id = 0;
+    target_size = {0, 0};
+}
+
+/**
+ * @brief      Gets damaged area of the current frame.
+ *
+ * @return     Area in pixels, overlaps are counted once per rectangle.
+ */
+std::size_t CGUIDamageTracker::get_damaged_area()
+{
+    std::size_t damaged_area = 0;
+
+    for (const CGUIDamageRect& rect : frame_damage)
+    {
+        damaged_area += area(rect);
+    }
+    return damaged_area;
+}
+
+/**
+ * @brief      Checks if any damage was reported since last frame.
+ *
+ * @return     True if next frame should not be skipped.
+ */
+bool CGUIDamageTracker::has_pending_damage()
+{
+    std::lock_guard damage_lock(damage_mutex);
+    return full_damage || !pending_damage.empty();
+}
+
+/**
+ * @brief      Blocks until damage is reported or wake is requested.
+ */
+void CGUIDamageTracker::wait_for_damage()
+{
+    std::unique_lock damage_lock(damage_mutex);
+    damage_con_v.wait(damage_lock, [this]{return full_damage || !pending_damage.empty() || wake_requested;});
+    wake_requested = false;
+}
+
+/**
+ * @brief      Blocks until damage is reported, wake is requested or timeout has passed.
+ *
+ * @param[in]  timeout  Maximum time to wait.
+ */
+void CGUIDamageTracker::wait_for_damage(std::chrono::milliseconds timeout)
+{
+    std::unique_lock damage_lock(damage_mutex);
+    damage_con_v.wait_for(damage_lock, timeout, [this]{return full_damage || !pending_damage.empty() || wake_requested;});
+    wake_requested = false;
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Recreates frame target with new size.
+ *
+ * @param[in]  framebuffer_size  New framebuffer size.
+ */
+void CGUIDamageTracker::resize_target(glm::ivec2 framebuffer_size)
+{
+    destroy();
+
+    target_size = framebuffer_size;
+    add_full_damage();
+
+    if (target_size.x <= 0 || target_size.y <= 0)
+    {
+        return;
+    }
+
+    glGenRenderbuffers(1, &color_buffer_id);
+    glBindRenderbuffer(GL_RENDERBUFFER, color_buffer_id);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, target_size.x, target_size.y);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    main_memory_tracker.register_object(CGUI_MEMORY_RENDERBUFFER, color_buffer_id, (std::size_t)target_size.x * (std::size_t)target_size.y * 4, GL_NONE, "CGUIDamageTracker");
+
+    glGenFramebuffers(1, &frame_buffer_id);
+    glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer_id);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color_buffer_id);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/**
+ * @brief      Merges overlapping rectangles and limits their amount.
+ *
+ * @param      rects  Rectangles to merge.
+ */
+void CGUIDamageTracker::merge_damage(std::vector<CGUIDamageRect>& rects)
+{
+    bool merged = true;
+
+    // Merge rectangles, whose union is not bigger than both of them together
+    while (merged)
+    {
+        merged = false;
+        for (std::size_t first = 0; first < rects.size() && !merged; ++first)
+        {
+            for (std::size_t second = first + 1; second < rects.size(); ++second)
+            {
+                CGUIDamageRect united = unite(rects[first], rects[second]);
+                if (area(united) <= area(rects[first]) + area(rects[second]))
+                {
+                    rects[first] = united;
+                    rects.erase(rects.begin() + second);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Merge the cheapest pairs, until amount of rectangles fits the limit
+    while (rects.size() > max_rects)
+    {
+        std::size_t best_first = 0;
+        std::size_t best_second = 1;
+        std::size_t best_growth = std::numeric_limits<std::size_t>::max();
+
+        for (std::size_t first = 0; first < rects.size(); ++first)
+        {
+            for (std::size_t second = first + 1; second < rects.size(); ++second)
+            {
+                std::size_t growth = area(unite(rects[first], rects[second])) - area(rects[first]) - area(rects[second]);
+                if (growth < best_growth)
+                {
+                    best_growth = growth;
+                    best_first = first;
+                    best_second = second;
+                }
+            }
+        }
+
+        rects[best_first] = unite(rects[best_first], rects[best_second]);
+        rects.erase(rects.begin() + best_second);
+    }
+}
+
+/**
+ * @brief      Clamps rectangles to frame target and removes empty ones.
+ *
+ * @param      rects  Rectangles to clamp.
+ */
+void CGUIDamageTracker::clamp_damage(std::vector<CGUIDamageRect>& rects)
+{
+    for (CGUIDamageRect& rect : rects)
+    {
+        glm::ivec2 top_left = {std::max(rect.position.x, 0), std::max(rect.position.y, 0)};
+        glm::ivec2 bottom_right = {std::min(rect.position.x + rect.size.x, target_size.x), std::min(rect.position.y + rect.size.y, target_size.y)};
+
+        rect.position = top_left;
+        rect.size = {std::max(bottom_right.x - top_left.x, 0), std::max(bottom_right.y - top_left.y, 0)};
+    }
+
+    rects.erase(std::remove_if(rects.begin(), rects.end(), [](const CGUIDamageRect& rect){ return rect.size.x == 0 || rect.size.y == 0; }), rects.end());
+}
+
+/**
+ * @brief      Bounding rectangle of two rectangles.
+ *
+ * @param[in]  first   First rectangle.
+ * @param[in]  second  Second rectangle.
+ *
+ * @return     United rectangle.
+ */
+CGUIDamageRect CGUIDamageTracker::unite(const CGUIDamageRect& first, const CGUIDamageRect& second)
+{
+    glm::ivec2 top_left = {std::min(first.position.x, second.position.x), std::min(first.position.y, second.position.y)};
+    glm::ivec2 bottom_right = {std::max(first.position.x + first.size.x, second.position.x + second.size.x), std::max(first.position.y + first.size.y, second.position.y + second.size.y)};
+
+    return {top_left, {bottom_right.x - top_left.x, bottom_right.y - top_left.y}};
+}
+
+/**
+ * @brief      Area of the rectangle.
+ *
+ * @param[in]  rect  Rectangle.
+ *
+ * @return     Area in pixels.
+ */
+std::size_t CGUIDamageTracker::area(const CGUIDamageRect& rect)
+{
+    return (std::size_t)rect.size.x * (std::size_t)rect.size.y;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file       <CGUIDamageTracker.hpp>
+ * @brief      This header file implements CGUIDamageTracker class.
+ *
+ *             It is being used in order to collect dirty rectangles, redraw
+ *             only them into persistent frame target and skip unchanged frames.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUIDAMAGETRACKER_HPP
+#define CGUIDAMAGETRACKER_HPP
+
+/**
+ * Include GLFW and GLAD for window handling.
+ */
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+
+#include "../../memory_tracker/CGUIMemoryTracker.hpp"
+
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <condition_variable>
+
+/**
+ * Dirty rectangle in framebuffer pixels, top left origin.
+ */
+struct CGUIDamageRect
+{
+    glm::ivec2 position;
+    glm::ivec2 size;
+};
+
+/**
+ * @brief      This class tracks damaged regions of the window.
+ *
+ *             Frame is drawn into persistent FBO, so regions, that were not damaged,
+ *             keep their pixels from previous frames. Only regions, reported by add_damage,
+ *             are redrawn partially, any change of the draw list hash redraws whole target.
+ *             Target is always presented whole, because back buffer is undefined after swap.
+ *             Draw list hash is used in order to skip submission and swap of the frames,
+ *             that did not change at all.
+ */
+class CGUIDamageTracker
+{
+public:
+    CGUIDamageTracker(std::size_t max_rects_arg = 16, float full_redraw_ratio_arg = 0.7f);
+    CGUIDamageTracker(const CGUIDamageTracker&) = delete;
+    ~CGUIDamageTracker();
+
+    void add_damage(glm::ivec2 position, glm::ivec2 size);
+    void add_full_damage();
+    void wake();
+
+    void begin_draw_list();
+    void hash_draw_list(const void* data, std::size_t size);
+    bool end_draw_list(glm::ivec2 framebuffer_size);
+
+    /**
+     * @brief      Hashes trivially copyable value into current draw list.
+     *
+     * @param[in]  value  Value, that affects the frame.
+     *
+     * @tparam     T      Trivially copyable type.
+     */
+    template<typename T>
+        void hash_draw_value(const T& value)
+        {
+            hash_draw_list(&value, sizeof(T));
+        }
+
+    const std::vector<CGUIDamageRect>& get_damage();
+
+    void bind_target();
+    void scissor(const CGUIDamageRect& rect);
+    void present_target();
+    void destroy();
+
+    std::size_t get_damaged_area();
+    bool        has_pending_damage();
+
+    void wait_for_damage();
+    void wait_for_damage(std::chrono::milliseconds timeout);
+
+private:
+    void resize_target(glm::ivec2 framebuffer_size);
+    void merge_damage(std::vector<CGUIDamageRect>& rects);
+    void clamp_damage(std::vector<CGUIDamageRect>& rects);
+
+    static CGUIDamageRect unite(const CGUIDamageRect& first, const CGUIDamageRect& second);
+    static std::size_t area(const CGUIDamageRect& rect);
+
+private:
+    std::size_t max_rects;
+    float       full_redraw_ratio;
+
+    GLuint  frame_buffer_id     = 0;
+    GLuint  color_buffer_id     = 0;
+
+    glm::ivec2 target_size      = {0, 0};
+
+    uint64_t draw_list_hash     = 0;
+    uint64_t last_draw_list_hash = 0;
+
+    bool full_damage            = true;
+    bool wake_requested         = false;
+
+    std::vector<CGUIDamageRect> pending_damage;
+    std::vector<CGUIDamageRect> frame_damage;
+
+    std::mutex              damage_mutex;
+    std::condition_variable damage_con_v;
+};
+
+#endif // CGUIDAMAGETRACKER_HPP
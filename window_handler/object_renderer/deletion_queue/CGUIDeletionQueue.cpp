@@ -0,0 +1,201 @@
+/**
+ * @file       <CGUIDeletionQueue.cpp>
+ * @brief      This source file implements CGUIDeletionQueue class.
+ *
+ *             It is being used in order to delete GL objects from any thread,
+ *             once GPU has finished the frames, that might still use them.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUIDeletionQueue.hpp"
+
+#include <algorithm>
+
+/**
+ * Main deletion queue, that is used by all GL object wrappers.
+ */
+CGUIDeletionQueue main_deletion_queue;
+
+/**
+ * @brief      Constructs a new deletion queue.
+ */
+CGUIDeletionQueue::CGUIDeletionQueue()
+{
+}
+
+/**
+ * @brief      Destroys deletion queue, objects, that were not retired, are dropped.
+ */
+CGUIDeletionQueue::~CGUIDeletionQueue()
+{
+    pending_deletions.clear();
+    frame_fences.clear();
+}
+
+/**
+ * @brief      Queues object for deletion, can be called from any thread.
+ *
+ * @param[in]  category   Type of the object, one of CGUI_MEMORY_* categories.
+ * @param[in]  object_id  GL name of the object.
+ */
+void CGUIDeletionQueue::push(std::size_t category, GLuint object_id)
+{
+    if (object_id == 0)
+    {
+        return;
+    }
+
+    std::lock_guard deletion_lock(deletion_mutex);
+    pending_deletions.push_back({category, object_id, frame_index});
+}
+
+/**
+ * @brief      Ends recorded frame, has to be called from render thread after it was submitted.
+ */
+void CGUIDeletionQueue::end_frame()
+{
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    std::lock_guard deletion_lock(deletion_mutex);
+    frame_fences.push_back({frame_index, fence});
+    frame_index++;
+}
+
+/**
+ * @brief      Deletes objects of all frames, that GPU has finished, never blocks.
+ *
+ *             Has to be called from render thread.
+ */
+void CGUIDeletionQueue::retire()
+{
+    std::vector<CGUIDeletion> retired_deletions;
+    {
+        std::lock_guard deletion_lock(deletion_mutex);
+
+        // Fences signal in order, so the first unsignalled one ends the search
+        while (!frame_fences.empty())
+        {
+            GLenum status = glClientWaitSync(frame_fences.front().fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            {
+                break;
+            }
+
+            completed_frame = frame_fences.front().frame;
+            any_frame_completed = true;
+
+            glDeleteSync(frame_fences.front().fence);
+            frame_fences.pop_front();
+        }
+
+        if (!any_frame_completed || pending_deletions.empty())
+        {
+            return;
+        }
+
+        auto retired_begin = std::partition(pending_deletions.begin(), pending_deletions.end(),
+            [this](const CGUIDeletion& deletion){ return deletion.frame > completed_frame; });
+
+        retired_deletions.assign(retired_begin, pending_deletions.end());
+        pending_deletions.erase(retired_begin, pending_deletions.end());
+    }
+
+    delete_objects(retired_deletions);
+}
+
+/**
+ * @brief      Waits for GPU and deletes every queued object, used at shutdown.
+ *
+ *             Has to be called from render thread.
+ */
+void CGUIDeletionQueue::flush()
+{
+    glFinish();
+
+    std::vector<CGUIDeletion> retired_deletions;
+    {
+        std::lock_guard deletion_lock(deletion_mutex);
+
+        for (CGUIFrameFence& frame_fence : frame_fences)
+        {
+            glDeleteSync(frame_fence.fence);
+        }
+        frame_fences.clear();
+
+        retired_deletions.swap(pending_deletions);
+    }
+
+    delete_objects(retired_deletions);
+}
+
+/**
+ * @brief      Gets amount of objects, that are waiting for deletion.
+ *
+ * @return     Amount of objects.
+ */
+std::size_t CGUIDeletionQueue::get_pending_count()
+{
+    std::lock_guard deletion_lock(deletion_mutex);
+    return pending_deletions.size();
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Deletes objects, one GL call per object type.
+ *
+ * @param      deletions  Objects to delete.
+ */
+void CGUIDeletionQueue::delete_objects(std::vector<CGUIDeletion>& deletions)
+{
+    std::vector<GLuint> object_ids[CGUI_MEMORY_CATEGORY_COUNT];
+
+    for (const CGUIDeletion& deletion : deletions)
+    {
+        if (deletion.category < CGUI_MEMORY_CATEGORY_COUNT)
+        {
+            object_ids[deletion.category].push_back(deletion.object_id);
+            main_memory_tracker.unregister_object(deletion.category, deletion.object_id);
+        }
+    }
+
+    if (!object_ids[CGUI_MEMORY_BUFFER].empty())
+    {
+        glDeleteBuffers((GLsizei)object_ids[CGUI_MEMORY_BUFFER].size(), object_ids[CGUI_MEMORY_BUFFER].data());
+    }
+    if (!object_ids[CGUI_MEMORY_VERTEX_ARRAY].empty())
+    {
+        glDeleteVertexArrays((GLsizei)object_ids[CGUI_MEMORY_VERTEX_ARRAY].size(), object_ids[CGUI_MEMORY_VERTEX_ARRAY].data());
+    }
+    if (!object_ids[CGUI_MEMORY_TEXTURE].empty())
+    {
+        glDeleteTextures((GLsizei)object_ids[CGUI_MEMORY_TEXTURE].size(), object_ids[CGUI_MEMORY_TEXTURE].data());
+    }
+    if (!object_ids[CGUI_MEMORY_RENDERBUFFER].empty())
+    {
+        glDeleteRenderbuffers((GLsizei)object_ids[CGUI_MEMORY_RENDERBUFFER].size(), object_ids[CGUI_MEMORY_RENDERBUFFER].data());
+    }
+
+    // Programs have no batched delete
+    for (GLuint program_id : object_ids[CGUI_MEMORY_PROGRAM])
+    {
+        glDeleteProgram(program_id);
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ * @file       <CGUIDeletionQueue.hpp>
+ * @brief      This header file implements CGUIDeletionQueue class.
+ *
+ *             It is being used in order to delete GL objects from any thread,
+ *             once GPU has finished the frames, that might still use them.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUIDELETIONQUEUE_HPP
+#define CGUIDELETIONQUEUE_HPP
+
+/**
+ * Include GLFW and GLAD for window handling.
+ */
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+
+#include "../../memory_tracker/CGUIMemoryTracker.hpp"
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Object, that is waiting for deletion, its type is one of CGUI_MEMORY_* categories.
+ */
+struct CGUIDeletion
+{
+    std::size_t category    = CGUI_MEMORY_BUFFER;
+    GLuint      object_id   = 0;
+    uint64_t    frame       = 0;
+};
+
+/**
+ * Fence, inserted after all commands of the frame.
+ */
+struct CGUIFrameFence
+{
+    uint64_t    frame   = 0;
+    GLsync      fence   = nullptr;
+};
+
+/**
+ * @brief      This class implements frame deferred deletion of GL objects.
+ *
+ *             Objects can be pushed from any thread, every object is tagged with the frame,
+ *             that is being recorded at that moment, since it is the last frame that could
+ *             use it. Render thread ends every frame with a fence and retires all objects of
+ *             the frames, whose fences have signalled, with one glDelete* call per type.
+ */
+class CGUIDeletionQueue
+{
+public:
+    CGUIDeletionQueue();
+    CGUIDeletionQueue(const CGUIDeletionQueue&) = delete;
+    ~CGUIDeletionQueue();
+
+    void push(std::size_t category, GLuint object_id);
+
+    void end_frame();
+    void retire();
+    void flush();
+
+    std::size_t get_pending_count();
+
+private:
+    void delete_objects(std::vector<CGUIDeletion>& deletions);
+
+private:
+    uint64_t    frame_index         = 0;
+    uint64_t    completed_frame     = 0;
+    bool        any_frame_completed = false;
+
+    std::vector<CGUIDeletion>   pending_deletions;
+    std::deque<CGUIFrameFence>  frame_fences;
+
+    std::mutex  deletion_mutex;
+};
+
+extern CGUIDeletionQueue main_deletion_queue;
+
+#endif // CGUIDELETIONQUEUE_HPP
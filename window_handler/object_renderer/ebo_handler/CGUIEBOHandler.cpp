@@ -30,22 +30,62 @@
  *
  * @param      indices           Vector of indices.
  * @param[in]  is_buffer_static  Indicates if buffer static
+ * @param[in]  owner             Owner tag for memory tracker
  */
-CGUIEBO::CGUIEBO(std::vector<GLuint>& indices, bool is_buffer_static)
+CGUIEBO::CGUIEBO(std::vector<GLuint>& indices, bool is_buffer_static, const std::string& owner)
 {
     buffer_static = is_buffer_static;
 
     glGenBuffers(1, &buffer_id);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer_id);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), (buffer_static == true) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
+
+    main_memory_tracker.register_object(CGUI_MEMORY_BUFFER, buffer_id, indices.size() * sizeof(GLuint), (buffer_static == true) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW, owner);
+}
+
+/**
+ * @brief      Constructs a new EBO, which data is uploaded by background uploader.
+ *
+ *             EBO should not be drawn until is_uploaded returns true.
+ *
+ * @param      uploader          Background uploader.
+ * @param      indices           Vector of indices, it is moved into uploader.
+ * @param[in]  is_buffer_static  Indicates if buffer static
+ * @param[in]  owner             Owner tag for memory tracker
+ */
+CGUIEBO::CGUIEBO(CGUIUploader& uploader, std::vector<GLuint>&& indices, bool is_buffer_static, const std::string& owner)
+{
+    buffer_static = is_buffer_static;
+    buffer_uploader = &uploader;
+
+    std::size_t buffer_size = indices.size() * sizeof(GLuint);
+
+    glGenBuffers(1, &buffer_id);
+    upload_ticket = uploader.upload_buffer(GL_ELEMENT_ARRAY_BUFFER, buffer_id, std::move(indices), (buffer_static == true) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
+
+    main_memory_tracker.register_object(CGUI_MEMORY_BUFFER, buffer_id, buffer_size, (buffer_static == true) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW, owner);
 }
 
 
+/**
+ * @brief      Destroys EBO, queueing its buffer for deletion.
+ */
+CGUIEBO::~CGUIEBO()
+{
+    destroy();
+}
+
 /**
  * @brief      Binds EBO.
  */
 void CGUIEBO::bind()
 {
+    // Buffer of failed upload has undefined contents
+    if (buffer_uploader != nullptr && buffer_uploader->is_failed(upload_ticket))
+    {
+        return;
+    }
+
     glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
 }
 
@@ -58,11 +98,18 @@ void CGUIEBO::unbind()
 }
 
 /**
- * @brief      Deletes EBO.
+ * @brief      Queues EBO for deletion, can be called from any thread.
  */
 void CGUIEBO::destroy()
 {
-    glDeleteBuffers(1, &buffer_id);
+    if (buffer_id == 0)
+    {
+        return;
+    }
+
+    // Object is deleted by render thread, once GPU has finished frames, that might use it
+    main_deletion_queue.push(CGUI_MEMORY_BUFFER, buffer_id);
+    buffer_id = 0;
 }
 
 /**
@@ -75,3 +122,16 @@ bool CGUIEBO::is_static()
     return buffer_static;
 }
 
+/**
+ * @brief      Determines if EBO data is uploaded.
+ *
+ * @return     True if data is ready to be drawn, False if it is not uploaded yet or upload has failed.
+ */
+bool CGUIEBO::is_uploaded()
+{
+    if (buffer_uploader == nullptr)
+    {
+        return true;
+    }
+    return buffer_uploader->is_complete(upload_ticket) && !buffer_uploader->is_failed(upload_ticket);
+}
@@ -33,10 +33,16 @@
 #include <glad/gl.h>
 #include <GLFW/glfw3.h>
 
+#include "../upload_handler/CGUIUploadHandler.hpp"
+#include "../../memory_tracker/CGUIMemoryTracker.hpp"
+#include "../deletion_queue/CGUIDeletionQueue.hpp"
+
 class CGUIEBO
 {
 public:
-    CGUIEBO(std::vector<GLuint>& indices, bool is_buffer_static = false);
+    CGUIEBO(std::vector<GLuint>& indices, bool is_buffer_static = false, const std::string& owner = "CGUIEBO");
+    CGUIEBO(CGUIUploader& uploader, std::vector<GLuint>&& indices, bool is_buffer_static = false, const std::string& owner = "CGUIEBO");
+    CGUIEBO(const CGUIEBO&) = delete;
     ~CGUIEBO();
 
     void bind();
@@ -44,10 +50,14 @@ public:
     void destroy();
 
     bool is_static();
+    bool is_uploaded();
 
 private:
     bool    buffer_static;
-    GLuint  buffer_id;
+    GLuint  buffer_id = 0;
+
+    CGUIUploader*       buffer_uploader = nullptr;
+    CGUIUploadTicket    upload_ticket;
 
 };
 
@@ -0,0 +1,491 @@
+/**
+ * @file       <CGUILayerCache.cpp>
+ * @brief      This source file implements CGUILayerCache class.
+ *
+ *             It is being used in order to render rarely changing subtrees
+ *             into pooled textures and composite them as a single quad.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUILayerCache.hpp"
+
+/**
+ * Layers, that were not used for this amount of frames, are removed.
+ */
+#define CGUI_LAYER_STALE_FRAMES 256
+
+/**
+ * @brief      Constructs a new layer cache.
+ *
+ * @param[in]  layer_program       Linked program built from cgui_layer_vert.vs and cgui_layer_frag.fs.
+ * @param      uniform_ring_arg    Ring, that holds uniforms of every composite.
+ * @param[in]  memory_budget_arg   Maximum amount of texture memory in bytes.
+ * @param[in]  promote_after_arg   Amount of unchanged frames, after which layer is cached.
+ */
+CGUILayerCache::CGUILayerCache(GLuint layer_program, CGUIUniformRing* uniform_ring_arg, std::size_t memory_budget_arg, std::size_t promote_after_arg)
+{
+    uniform_ring = uniform_ring_arg;
+    memory_budget = memory_budget_arg;
+    promote_after = promote_after_arg;
+
+    set_program(layer_program);
+
+    glGenFramebuffers(1, &frame_buffer_id);
+    glGenVertexArrays(1, &vertex_array_id);
+
+    main_memory_tracker.register_object(CGUI_MEMORY_VERTEX_ARRAY, vertex_array_id, 0, GL_NONE, "CGUILayerCache");
+}
+
+/**
+ * @brief      Destroys layer cache.
+ */
+CGUILayerCache::~CGUILayerCache()
+{
+    layers.clear();
+    texture_pool.clear();
+}
+
+/**
+ * @brief      Starts a new frame.
+ *
+ * @param[in]  framebuffer_size_arg  Current framebuffer size.
+ */
+void CGUILayerCache::begin_frame(glm::ivec2 framebuffer_size_arg)
+{
+    frame_index++;
+
+    // Layer content is drawn in window coordinates, so new framebuffer size invalidates everything
+    if (framebuffer_size_arg != framebuffer_size)
+    {
+        framebuffer_size = framebuffer_size_arg;
+        for (auto& [layer_id, layer] : layers)
+        {
+            invalidate(layer_id);
+        }
+    }
+
+    if (frame_index % CGUI_LAYER_STALE_FRAMES == 0)
+    {
+        for (auto layer_iterator = layers.begin(); layer_iterator != layers.end();)
+        {
+            if (frame_index - layer_iterator->second.last_used_frame > CGUI_LAYER_STALE_FRAMES)
+            {
+                release_texture(layer_iterator->second.texture);
+                layer_iterator = layers.erase(layer_iterator);
+            }
+            else
+            {
+                ++layer_iterator;
+            }
+        }
+        enforce_budget(memory_budget, UINT64_MAX);
+    }
+}
+
+/**
+ * @brief      Starts a layer.
+ *
+ * @param[in]  layer_id  Unique layer id, chosen by owner of the subtree.
+ * @param[in]  position  Top left corner in framebuffer pixels.
+ * @param[in]  size      Layer size in pixels.
+ * @param[in]  revision  Revision of subtree content, any change invalidates cached texture.
+ *
+ * @return     True if subtree should be drawn now, False if cached texture would be used.
+ */
+bool CGUILayerCache::begin_layer(uint64_t layer_id, glm::ivec2 position, glm::ivec2 size, uint64_t revision)
+{
+    CGUILayer& layer = layers[layer_id];
+
+    if (layer.size != size || layer.revision != revision)
+    {
+        invalidate(layer_id);
+        layer.size = size;
+        layer.revision = revision;
+    }
+    else if (layer.last_used_frame != frame_index)
+    {
+        layer.unchanged_frames++;
+    }
+
+    layer.position = position;
+    layer.last_used_frame = frame_index;
+
+    active_layer_id = layer_id;
+    active_layer = true;
+    active_rendering = false;
+
+    if (layer.cached)
+    {
+        return false;
+    }
+
+    if (!(layer.cacheable || layer.unchanged_frames >= promote_after) || size.x <= 0 || size.y <= 0 || texture_bytes(size) > memory_budget)
+    {
+        return true;
+    }
+
+    layer.texture = acquire_texture(size);
+    layer.cached = true;
+    enforce_budget(memory_budget, layer_id);
+
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &saved_frame_buffer);
+    glGetIntegerv(GL_VIEWPORT, saved_viewport);
+    saved_scissor = glIsEnabled(GL_SCISSOR_TEST);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, saved_clear_color);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer_id);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, layer.texture.texture_id, 0);
+
+    // Shift viewport, so subtree drawn in window coordinates lands into texture origin
+    glDisable(GL_SCISSOR_TEST);
+    glViewport(-position.x, -(framebuffer_size.y - position.y - size.y), framebuffer_size.x, framebuffer_size.y);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    active_rendering = true;
+    return true;
+}
+
+/**
+ * @brief      Finishes a layer and composites it if it is cached.
+ */
+void CGUILayerCache::end_layer()
+{
+    if (!active_layer)
+    {
+        return;
+    }
+    active_layer = false;
+
+    if (active_rendering)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, saved_frame_buffer);
+        glViewport(saved_viewport[0], saved_viewport[1], saved_viewport[2], saved_viewport[3]);
+        glClearColor(saved_clear_color[0], saved_clear_color[1], saved_clear_color[2], saved_clear_color[3]);
+        if (saved_scissor == GL_TRUE)
+        {
+            glEnable(GL_SCISSOR_TEST);
+        }
+        active_rendering = false;
+    }
+
+    auto layer_iterator = layers.find(active_layer_id);
+    if (layer_iterator != layers.end() && layer_iterator->second.cached)
+    {
+        composite(layer_iterator->second);
+    }
+}
+
+/**
+ * @brief      Marks layer as cacheable, it would be cached without waiting for unchanged frames.
+ *
+ * @param[in]  layer_id   Layer id.
+ * @param[in]  cacheable  Cacheable flag.
+ */
+void CGUILayerCache::set_cacheable(uint64_t layer_id, bool cacheable)
+{
+    layers[layer_id].cacheable = cacheable;
+
+    if (!cacheable)
+    {
+        invalidate(layer_id);
+    }
+}
+
+/**
+ * @brief      Drops cached texture of the layer.
+ *
+ * @param[in]  layer_id  Layer id.
+ */
+void CGUILayerCache::invalidate(uint64_t layer_id)
+{
+    auto layer_iterator = layers.find(layer_id);
+    if (layer_iterator == layers.end())
+    {
+        return;
+    }
+
+    CGUILayer& layer = layer_iterator->second;
+    if (layer.cached)
+    {
+        release_texture(layer.texture);
+        layer.cached = false;
+    }
+    layer.unchanged_frames = 0;
+}
+
+/**
+ * @brief      Sets texture memory budget.
+ *
+ * @param[in]  memory_budget_arg  Budget in bytes.
+ */
+void CGUILayerCache::set_memory_budget(std::size_t memory_budget_arg)
+{
+    memory_budget = memory_budget_arg;
+    enforce_budget(memory_budget, UINT64_MAX);
+}
+
+/**
+ * @brief      Sets program, that composites cached layers.
+ *
+ * @param[in]  layer_program  Linked program built from cgui_layer_vert.vs and cgui_layer_frag.fs.
+ */
+void CGUILayerCache::set_program(GLuint layer_program)
+{
+    program_id = layer_program;
+}
+
+/**
+ * @brief      Deletes all textures and framebuffer.
+ */
+void CGUILayerCache::destroy()
+{
+    for (auto& [layer_id, layer] : layers)
+    {
+        if (layer.cached)
+        {
+            delete_texture(layer.texture);
+        }
+    }
+    for (CGUILayerTexture& texture : texture_pool)
+    {
+        delete_texture(texture);
+    }
+
+    layers.clear();
+    texture_pool.clear();
+    memory_usage = 0;
+
+    main_memory_tracker.unregister_object(CGUI_MEMORY_VERTEX_ARRAY, vertex_array_id);
+
+    glDeleteFramebuffers(1, &frame_buffer_id);
+    glDeleteVertexArrays(1, &vertex_array_id);
+}
+
+/**
+ * @brief      Frees texture memory on request of memory tracker.
+ *
+ *             Layer, that is being drawn now, is never evicted.
+ *
+ * @param[in]  bytes_to_free  Amount of bytes, that should be freed.
+ *
+ * @return     Amount of freed bytes.
+ */
+std::size_t CGUILayerCache::trim(std::size_t bytes_to_free)
+{
+    std::size_t previous_usage = memory_usage;
+
+    enforce_budget((memory_usage > bytes_to_free) ? memory_usage - bytes_to_free : 0, (active_layer == true) ? active_layer_id : UINT64_MAX);
+    return previous_usage - memory_usage;
+}
+
+/**
+ * @brief      Gets texture memory used by cached layers and pool.
+ *
+ * @return     Memory usage in bytes.
+ */
+std::size_t CGUILayerCache::get_memory_usage()
+{
+    return memory_usage;
+}
+
+/**
+ * @brief      Gets amount of cached layers.
+ *
+ * @return     Amount of cached layers.
+ */
+std::size_t CGUILayerCache::get_cached_layer_count()
+{
+    std::size_t cached_layer_count = 0;
+
+    for (const auto& [layer_id, layer] : layers)
+    {
+        cached_layer_count += (layer.cached == true) ? 1 : 0;
+    }
+    return cached_layer_count;
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Takes texture from pool or creates a new one.
+ *
+ * @param[in]  size  Required size.
+ *
+ * @return     Texture, that is at least of required size.
+ */
+CGUILayerTexture CGUILayerCache::acquire_texture(glm::ivec2 size)
+{
+    glm::ivec2 pooled_size = {
+        (size.x + CGUI_LAYER_TEXTURE_GRANULARITY - 1) / CGUI_LAYER_TEXTURE_GRANULARITY * CGUI_LAYER_TEXTURE_GRANULARITY,
+        (size.y + CGUI_LAYER_TEXTURE_GRANULARITY - 1) / CGUI_LAYER_TEXTURE_GRANULARITY * CGUI_LAYER_TEXTURE_GRANULARITY
+    };
+
+    // Reuse the smallest pooled texture, that fits and does not waste more than half of it
+    auto best_texture = texture_pool.end();
+    for (auto texture_iterator = texture_pool.begin(); texture_iterator != texture_pool.end(); ++texture_iterator)
+    {
+        if (texture_iterator->size.x >= pooled_size.x && texture_iterator->size.y >= pooled_size.y &&
+            texture_bytes(texture_iterator->size) <= 2 * texture_bytes(pooled_size) &&
+            (best_texture == texture_pool.end() || texture_bytes(texture_iterator->size) < texture_bytes(best_texture->size)))
+        {
+            best_texture = texture_iterator;
+        }
+    }
+
+    CGUILayerTexture texture;
+    if (best_texture != texture_pool.end())
+    {
+        texture = *best_texture;
+        texture_pool.erase(best_texture);
+        return texture;
+    }
+
+    texture.size = pooled_size;
+    glGenTextures(1, &texture.texture_id);
+    glBindTexture(GL_TEXTURE_2D, texture.texture_id);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, pooled_size.x, pooled_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    memory_usage += texture_bytes(pooled_size);
+    main_memory_tracker.register_object(CGUI_MEMORY_TEXTURE, texture.texture_id, texture_bytes(pooled_size), GL_NONE, "CGUILayerCache");
+    return texture;
+}
+
+/**
+ * @brief      Returns texture into pool.
+ *
+ * @param      texture  Texture to release.
+ */
+void CGUILayerCache::release_texture(CGUILayerTexture& texture)
+{
+    if (texture.texture_id != 0)
+    {
+        texture_pool.push_back(texture);
+    }
+    texture = CGUILayerTexture();
+}
+
+/**
+ * @brief      Deletes texture and stops tracking its memory.
+ *
+ * @param      texture  Texture to delete.
+ */
+void CGUILayerCache::delete_texture(CGUILayerTexture& texture)
+{
+    memory_usage -= texture_bytes(texture.size);
+    main_memory_tracker.unregister_object(CGUI_MEMORY_TEXTURE, texture.texture_id);
+    glDeleteTextures(1, &texture.texture_id);
+    texture = CGUILayerTexture();
+}
+
+/**
+ * @brief      Frees texture memory until it fits the limit.
+ *
+ *             Pooled textures go first, then least recently used cached layers.
+ *
+ * @param[in]  memory_limit        Amount of memory, that can stay in use.
+ * @param[in]  protected_layer_id  Layer, that should not be evicted.
+ */
+void CGUILayerCache::enforce_budget(std::size_t memory_limit, uint64_t protected_layer_id)
+{
+    while (memory_usage > memory_limit)
+    {
+        if (!texture_pool.empty())
+        {
+            delete_texture(texture_pool.front());
+            texture_pool.erase(texture_pool.begin());
+            continue;
+        }
+
+        CGUILayer* least_used_layer = nullptr;
+        for (auto& [layer_id, layer] : layers)
+        {
+            if (layer.cached && layer_id != protected_layer_id && (least_used_layer == nullptr || layer.last_used_frame < least_used_layer->last_used_frame))
+            {
+                least_used_layer = &layer;
+            }
+        }
+
+        if (least_used_layer == nullptr)
+        {
+            break;
+        }
+
+        // Evicted layer has to stay unchanged again before it is promoted back
+        delete_texture(least_used_layer->texture);
+        least_used_layer->cached = false;
+        least_used_layer->unchanged_frames = 0;
+    }
+}
+
+/**
+ * @brief      Draws cached layer as a single quad.
+ *
+ * @param[in]  layer  Layer to composite.
+ */
+void CGUILayerCache::composite(const CGUILayer& layer)
+{
+    glm::fvec4 ndc_rect = {
+        layer.position.x / (float)framebuffer_size.x * 2.0f - 1.0f,
+        (framebuffer_size.y - layer.position.y - layer.size.y) / (float)framebuffer_size.y * 2.0f - 1.0f,
+        (layer.position.x + layer.size.x) / (float)framebuffer_size.x * 2.0f - 1.0f,
+        (framebuffer_size.y - layer.position.y) / (float)framebuffer_size.y * 2.0f - 1.0f
+    };
+
+    glm::fvec2 uv_scale = {layer.size.x / (float)layer.texture.size.x, layer.size.y / (float)layer.texture.size.y};
+
+    CGUILayerUniforms uniforms = {ndc_rect, uv_scale, {0.0f, 0.0f}};
+    if (!uniform_ring->push(CGUI_UNIFORM_BINDING_LAYER, uniforms))
+    {
+        return;
+    }
+
+    // Sampler binding is set by the shader
+    glUseProgram(program_id);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, layer.texture.texture_id);
+
+    glEnable(GL_BLEND);
+    glBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    glBindVertexArray(vertex_array_id);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindVertexArray(0);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ * @brief      Memory, that is required for RGBA8 texture.
+ *
+ * @param[in]  size  Texture size.
+ *
+ * @return     Size in bytes.
+ */
+std::size_t CGUILayerCache::texture_bytes(glm::ivec2 size)
+{
+    return (std::size_t)size.x * (std::size_t)size.y * 4;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file       <CGUILayerCache.hpp>
+ * @brief      This header file implements CGUILayerCache class.
+ *
+ *             It is being used in order to render rarely changing subtrees
+ *             into pooled textures and composite them as a single quad.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUILAYERCACHE_HPP
+#define CGUILAYERCACHE_HPP
+
+/**
+ * Include GLFW and GLAD for window handling.
+ */
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+
+#include "../../memory_tracker/CGUIMemoryTracker.hpp"
+#include "../uniform_ring/CGUIUniformRing.hpp"
+
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Pooled textures are rounded up to this granularity, so resized layers can reuse them.
+ */
+#define CGUI_LAYER_TEXTURE_GRANULARITY 64
+
+/**
+ * Texture from the layer pool.
+ */
+struct CGUILayerTexture
+{
+    GLuint      texture_id  = 0;
+    glm::ivec2  size        = {0, 0};
+};
+
+/**
+ * Uniforms of one composite, std140 layout of CGUILayerBlock in cgui_layer_vert.vs.
+ */
+struct CGUILayerUniforms
+{
+    glm::fvec4  rect;
+    glm::fvec2  uv_scale;
+    float       padding[2];
+};
+
+/**
+ * Cached state of one layer.
+ */
+struct CGUILayer
+{
+    glm::ivec2          position            = {0, 0};
+    glm::ivec2          size                = {0, 0};
+    uint64_t            revision            = 0;
+    uint64_t            last_used_frame     = 0;
+    std::size_t         unchanged_frames    = 0;
+    bool                cacheable           = false;
+    bool                cached              = false;
+    CGUILayerTexture    texture;
+};
+
+/**
+ * @brief      This class implements compositing layers.
+ *
+ *             Usage for every subtree, that might be cached:
+ *
+ *                 if (layer_cache.begin_layer(id, position, size, revision)) { draw subtree }
+ *                 layer_cache.end_layer();
+ *
+ *             Layer is promoted after promote_after unchanged frames or immediately if it
+ *             was marked cacheable, and stays cached until its revision or size changes.
+ */
+class CGUILayerCache
+{
+public:
+    CGUILayerCache(GLuint layer_program, CGUIUniformRing* uniform_ring_arg, std::size_t memory_budget_arg = 64 * 1024 * 1024, std::size_t promote_after_arg = 30);
+    CGUILayerCache(const CGUILayerCache&) = delete;
+    ~CGUILayerCache();
+
+    void begin_frame(glm::ivec2 framebuffer_size_arg);
+
+    bool begin_layer(uint64_t layer_id, glm::ivec2 position, glm::ivec2 size, uint64_t revision);
+    void end_layer();
+
+    void set_cacheable(uint64_t layer_id, bool cacheable);
+    void invalidate(uint64_t layer_id);
+    void set_memory_budget(std::size_t memory_budget_arg);
+    void set_program(GLuint layer_program);
+    void destroy();
+
+    std::size_t trim(std::size_t bytes_to_free);
+
+    std::size_t get_memory_usage();
+    std::size_t get_cached_layer_count();
+
+private:
+    CGUILayerTexture acquire_texture(glm::ivec2 size);
+    void release_texture(CGUILayerTexture& texture);
+    void delete_texture(CGUILayerTexture& texture);
+    void enforce_budget(std::size_t memory_limit, uint64_t protected_layer_id);
+    void composite(const CGUILayer& layer);
+
+    static std::size_t texture_bytes(glm::ivec2 size);
+
+private:
+    GLuint      program_id;
+    GLuint      frame_buffer_id     = 0;
+    GLuint      vertex_array_id     = 0;
+
+    CGUIUniformRing* uniform_ring;
+
+    std::size_t memory_budget;
+    std::size_t memory_usage        = 0;
+    std::size_t promote_after;
+
+    uint64_t    frame_index         = 0;
+
+    glm::ivec2  framebuffer_size    = {0, 0};
+
+    std::unordered_map<uint64_t, CGUILayer> layers;
+    std::vector<CGUILayerTexture>           texture_pool;
+
+    /**
+     * State of the layer between begin_layer and end_layer.
+     */
+    uint64_t    active_layer_id     = 0;
+    bool        active_layer        = false;
+    bool        active_rendering    = false;
+    GLint       saved_frame_buffer  = 0;
+    GLint       saved_viewport[4]   = {0, 0, 0, 0};
+    GLboolean   saved_scissor       = GL_FALSE;
+    GLfloat     saved_clear_color[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+};
+
+#endif // CGUILAYERCACHE_HPP
@@ -0,0 +1,315 @@
+/**
+ * @file       <CGUILineRenderer.cpp>
+ * @brief      This source file implements CGUILineRenderer class.
+ *
+ *             It is being used in order to draw wide anti-aliased polylines,
+ *             every segment of which is an instance expanded in vertex shader.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUILineRenderer.hpp"
+
+/**
+ * @brief      Constructs a new line renderer.
+ *
+ * @param[in]  line_program      Linked program built from cgui_line_vert.vs and cgui_line_frag.fs.
+ * @param      uniform_ring_arg  Ring, that holds uniforms of every draw.
+ * @param[in]  is_buffer_static  Indicates if point buffer is static.
+ */
+CGUILineRenderer::CGUILineRenderer(GLuint line_program, CGUIUniformRing* uniform_ring_arg, bool is_buffer_static)
+{
+    buffer_static = is_buffer_static;
+    uniform_ring = uniform_ring_arg;
+
+    set_program(line_program);
+
+    glGenVertexArrays(1, &vertex_array_id);
+    glGenBuffers(1, &point_buffer_id);
+
+    main_memory_tracker.register_object(CGUI_MEMORY_VERTEX_ARRAY, vertex_array_id, 0, GL_NONE, "CGUILineRenderer");
+    main_memory_tracker.register_object(CGUI_MEMORY_BUFFER, point_buffer_id, 0, (buffer_static == true) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW, "CGUILineRenderer");
+
+    link_segment_attributes();
+}
+
+/**
+ * @brief      Destroys line renderer.
+ */
+CGUILineRenderer::~CGUILineRenderer()
+{
+    line_points.clear();
+    padded_points.clear();
+}
+
+/**
+ * @brief      Replaces the whole polyline.
+ *
+ * @param[in]  points  Polyline points in data space.
+ */
+void CGUILineRenderer::set_points(const std::vector<glm::fvec2>& points)
+{
+    line_points = points;
+    point_count = points.size();
+    revision++;
+
+    upload_points();
+}
+
+/**
+ * @brief      Overwrites part of the polyline without touching the rest of the buffer.
+ *
+ * @param[in]  first_point  Index of the first point to overwrite.
+ * @param[in]  points       New point values.
+ */
+void CGUILineRenderer::update_points(std::size_t first_point, const std::vector<glm::fvec2>& points)
+{
+    if (points.empty() || first_point + points.size() > point_count)
+    {
+        return;
+    }
+
+    revision++;
+
+    // Buffer indices match point indices only, if there are no duplicates before and after the update
+    bool had_duplicates = padded_points.size() != point_count + 2;
+    std::copy(points.begin(), points.end(), line_points.begin() + first_point);
+
+    if (had_duplicates || has_duplicates(first_point, first_point + points.size()))
+    {
+        upload_points();
+        return;
+    }
+
+    std::copy(points.begin(), points.end(), padded_points.begin() + first_point + 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, point_buffer_id);
+    glBufferSubData(GL_ARRAY_BUFFER, (first_point + 1) * sizeof(glm::fvec2), points.size() * sizeof(glm::fvec2), points.data());
+
+    // Keep duplicated endpoints in sync, otherwise open ends would get joins
+    if (first_point == 0)
+    {
+        padded_points.front() = points.front();
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(glm::fvec2), &points.front());
+    }
+    if (first_point + points.size() == point_count)
+    {
+        padded_points.back() = points.back();
+        glBufferSubData(GL_ARRAY_BUFFER, (point_count + 1) * sizeof(glm::fvec2), sizeof(glm::fvec2), &points.back());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/**
+ * @brief      Sets program, that draws the line.
+ *
+ *             Line is redrawn with the new program, since its revision changes.
+ *
+ * @param[in]  line_program  Linked program built from cgui_line_vert.vs and cgui_line_frag.fs.
+ */
+void CGUILineRenderer::set_program(GLuint line_program)
+{
+    program_id = line_program;
+    revision++;
+}
+
+/**
+ * @brief      Sets the line style.
+ *
+ * @param[in]  new_style  New line style.
+ */
+void CGUILineRenderer::set_style(const CGUILineStyle& new_style)
+{
+    style = new_style;
+    revision++;
+}
+
+/**
+ * @brief      Sets data space to NDC transform.
+ *
+ * @param[in]  scale   Scale of data space.
+ * @param[in]  offset  Offset applied after scale.
+ */
+void CGUILineRenderer::set_transform(glm::fvec2 scale, glm::fvec2 offset)
+{
+    transform = {scale.x, scale.y, offset.x, offset.y};
+    revision++;
+}
+
+/**
+ * @brief      Draws polyline, one instance per segment.
+ *
+ * @param[in]  viewport_size  Framebuffer size in pixels.
+ */
+void CGUILineRenderer::draw(glm::ivec2 viewport_size)
+{
+    if (segment_count == 0 || program_id == 0)
+    {
+        return;
+    }
+
+    CGUILineUniforms uniforms = {transform, style.color, glm::fvec2(viewport_size), style.width, style.miter_limit, style.join_type, {0, 0, 0}};
+    if (!uniform_ring->push(CGUI_UNIFORM_BINDING_LINE, uniforms))
+    {
+        return;
+    }
+
+    glUseProgram(program_id);
+
+    // Separate alpha keeps destination premultiplied, so lines can be drawn into layer textures
+    glEnable(GL_BLEND);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    glBindVertexArray(vertex_array_id);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, CGUI_LINE_SEGMENT_VERTICES, (GLsizei)segment_count);
+    glBindVertexArray(0);
+}
+
+/**
+ * @brief      Deletes line buffers.
+ */
+void CGUILineRenderer::destroy()
+{
+    main_memory_tracker.unregister_object(CGUI_MEMORY_BUFFER, point_buffer_id);
+    main_memory_tracker.unregister_object(CGUI_MEMORY_VERTEX_ARRAY, vertex_array_id);
+
+    glDeleteBuffers(1, &point_buffer_id);
+    glDeleteVertexArrays(1, &vertex_array_id);
+
+    point_count = 0;
+    point_capacity = 0;
+    segment_count = 0;
+}
+
+/**
+ * @brief      Gets amount of points in polyline.
+ *
+ * @return     Amount of points.
+ */
+std::size_t CGUILineRenderer::get_point_count()
+{
+    return point_count;
+}
+
+/**
+ * @brief      Gets revision of the line, it changes every time line is modified.
+ *
+ * @return     Line revision.
+ */
+uint64_t CGUILineRenderer::get_revision()
+{
+    return revision;
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Links prev/start/end/next attributes to the same point buffer.
+ *
+ *             Every attribute is shifted by one point and advances once per instance.
+ */
+void CGUILineRenderer::link_segment_attributes()
+{
+    glBindVertexArray(vertex_array_id);
+    glBindBuffer(GL_ARRAY_BUFFER, point_buffer_id);
+
+    for (GLuint layout = 0; layout < 4; ++layout)
+    {
+        glVertexAttribPointer(layout, 2, GL_FLOAT, GL_FALSE, sizeof(glm::fvec2), (void*)(layout * sizeof(glm::fvec2)));
+        glVertexAttribDivisor(layout, 1);
+        glEnableVertexAttribArray(layout);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/**
+ * @brief      Uploads the whole polyline, buffer grows if it does not fit.
+ */
+void CGUILineRenderer::upload_points()
+{
+    segment_count = 0;
+    padded_points.clear();
+
+    if (point_count < 2)
+    {
+        return;
+    }
+
+    write_padded_points(line_points);
+
+    // Polyline, whose points are all the same, has no direction to be drawn with
+    if (padded_points.size() < 4)
+    {
+        return;
+    }
+    segment_count = padded_points.size() - 3;
+
+    glBindBuffer(GL_ARRAY_BUFFER, point_buffer_id);
+    if (padded_points.size() > point_capacity)
+    {
+        // Dynamic traces grow geometrically, so appending samples does not reallocate every frame
+        point_capacity = (buffer_static == true) ? padded_points.size() : padded_points.size() + padded_points.size() / 2;
+        glBufferData(GL_ARRAY_BUFFER, point_capacity * sizeof(glm::fvec2), NULL, (buffer_static == true) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
+        main_memory_tracker.resize_object(CGUI_MEMORY_BUFFER, point_buffer_id, point_capacity * sizeof(glm::fvec2));
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, padded_points.size() * sizeof(glm::fvec2), padded_points.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/**
+ * @brief      Copies points into scratch buffer with both endpoints duplicated.
+ *
+ *             Consecutive duplicate points are skipped, zero length segment
+ *             would be taken for an open end by its neighbours.
+ *
+ * @param[in]  points  Polyline points.
+ */
+void CGUILineRenderer::write_padded_points(const std::vector<glm::fvec2>& points)
+{
+    padded_points.reserve(points.size() + 2);
+    padded_points.push_back(points.front());
+
+    for (const glm::fvec2& point : points)
+    {
+        if (padded_points.size() == 1 || padded_points.back() != point)
+        {
+            padded_points.push_back(point);
+        }
+    }
+
+    padded_points.push_back(padded_points.back());
+}
+
+/**
+ * @brief      Checks points of the range and their neighbours for consecutive duplicates.
+ *
+ * @param[in]  first_point  Index of the first point of the range.
+ * @param[in]  last_point   Index after the last point of the range.
+ *
+ * @return     True if any point is equal to the next one.
+ */
+bool CGUILineRenderer::has_duplicates(std::size_t first_point, std::size_t last_point)
+{
+    std::size_t first_index = (first_point > 0) ? first_point - 1 : 0;
+    std::size_t last_index = std::min(last_point + 1, line_points.size());
+
+    return std::adjacent_find(line_points.begin() + first_index, line_points.begin() + last_index) != line_points.begin() + last_index;
+}
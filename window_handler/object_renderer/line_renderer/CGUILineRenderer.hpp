@@ -0,0 +1,137 @@
+/**
+ * @file       <CGUILineRenderer.hpp>
+ * @brief      This header file implements CGUILineRenderer class.
+ *
+ *             It is being used in order to draw wide anti-aliased polylines,
+ *             every segment of which is an instance expanded in vertex shader.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUILINERENDERER_HPP
+#define CGUILINERENDERER_HPP
+
+/**
+ * Include GLFW and GLAD for window handling.
+ */
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+
+#include "../../memory_tracker/CGUIMemoryTracker.hpp"
+#include "../uniform_ring/CGUIUniformRing.hpp"
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * Line join types, must match uJoin in cgui_line_vert.vs.
+ */
+#define CGUI_LINE_JOIN_MITER    0
+#define CGUI_LINE_JOIN_ROUND    1
+
+/**
+ * Vertices of one segment instance, quad of two triangles and bevel triangle of its end joint.
+ */
+#define CGUI_LINE_SEGMENT_VERTICES 9
+
+/**
+ * Line style, that is applied to the whole polyline.
+ */
+struct CGUILineStyle
+{
+    glm::fvec4  color       = {1.0f, 1.0f, 1.0f, 1.0f};
+    float       width       = 1.0f;
+    float       miter_limit = 4.0f;
+    uint8_t     join_type   = CGUI_LINE_JOIN_MITER;
+};
+
+/**
+ * Uniforms of one draw, std140 layout of CGUILineBlock in cgui_line_vert.vs.
+ */
+struct CGUILineUniforms
+{
+    glm::fvec4  transform;
+    glm::fvec4  color;
+    glm::fvec2  viewport;
+    float       width;
+    float       miter_limit;
+    int32_t     join_type;
+    int32_t     padding[3];
+};
+
+/**
+ * @brief      This class draws a single polyline with instanced segments.
+ *
+ *             Points are stored once in a vertex buffer with duplicated endpoints,
+ *             segment i reads points [i, i + 3] as per-instance attributes, so
+ *             every segment knows its neighbours for joins without any geometry shader.
+ *             Consecutive duplicate points are removed, otherwise they would be drawn as caps.
+ *             Segments are split at bisectors of their joints, so translucent line is blended once.
+ */
+class CGUILineRenderer
+{
+public:
+    CGUILineRenderer(GLuint line_program, CGUIUniformRing* uniform_ring_arg, bool is_buffer_static = false);
+    CGUILineRenderer(const CGUILineRenderer&) = delete;
+    ~CGUILineRenderer();
+
+    void set_points(const std::vector<glm::fvec2>& points);
+    void update_points(std::size_t first_point, const std::vector<glm::fvec2>& points);
+
+    void set_program(GLuint line_program);
+    void set_style(const CGUILineStyle& new_style);
+    void set_transform(glm::fvec2 scale, glm::fvec2 offset);
+
+    void draw(glm::ivec2 viewport_size);
+    void destroy();
+
+    std::size_t get_point_count();
+    uint64_t    get_revision();
+
+private:
+    void link_segment_attributes();
+    void upload_points();
+    void write_padded_points(const std::vector<glm::fvec2>& points);
+
+    bool has_duplicates(std::size_t first_point, std::size_t last_point);
+
+private:
+    bool    buffer_static;
+
+    GLuint  program_id;
+    GLuint  vertex_array_id = 0;
+    GLuint  point_buffer_id = 0;
+
+    CGUIUniformRing* uniform_ring;
+
+    std::size_t point_count     = 0;
+    std::size_t point_capacity  = 0;
+    std::size_t segment_count   = 0;
+
+    uint64_t    revision        = 0;
+
+    CGUILineStyle style;
+
+    glm::fvec4 transform = {1.0f, 1.0f, 0.0f, 0.0f};
+
+    std::vector<glm::fvec2> line_points;
+    std::vector<glm::fvec2> padded_points;
+};
+
+#endif // CGUILINERENDERER_HPP
@@ -0,0 +1,811 @@
+/**
+ * @file       <CGUISoftwareRenderer.cpp>
+ * @brief      This source file implements CGUISoftwareRenderer class.
+ *
+ *             It is being used in order to draw objects on machines without
+ *             usable GPU, by rasterizing them on CPU.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUISoftwareRenderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CGUI_SOFTWARE_SSE2
+    #include <emmintrin.h>
+#endif // SSE2
+
+#ifdef CGUI_SOFTWARE_SSE2
+/**
+ * @brief      Blends 4 colors over 4 RGBA8 pixels with straight alpha.
+ *
+ * @param[in]  destination  Pixels in framebuffer.
+ * @param[in]  red          Source red in range [0, 1].
+ * @param[in]  green        Source green in range [0, 1].
+ * @param[in]  blue         Source blue in range [0, 1].
+ * @param[in]  alpha        Source alpha in range [0, 1].
+ *
+ * @return     Blended pixels.
+ */
+static inline __m128i cgui_blend_pixels(__m128i destination, __m128 red, __m128 green, __m128 blue, __m128 alpha)
+{
+    const __m128i byte_mask = _mm_set1_epi32(0xff);
+
+    __m128 inverse_alpha = _mm_sub_ps(_mm_set1_ps(1.0f), alpha);
+    __m128 source_scale = _mm_mul_ps(alpha, _mm_set1_ps(255.0f));
+
+    __m128 destination_red      = _mm_cvtepi32_ps(_mm_and_si128(destination, byte_mask));
+    __m128 destination_green    = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(destination, 8), byte_mask));
+    __m128 destination_blue     = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(destination, 16), byte_mask));
+    __m128 destination_alpha    = _mm_cvtepi32_ps(_mm_srli_epi32(destination, 24));
+
+    __m128i result_red      = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(red, source_scale), _mm_mul_ps(destination_red, inverse_alpha)));
+    __m128i result_green    = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(green, source_scale), _mm_mul_ps(destination_green, inverse_alpha)));
+    __m128i result_blue     = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(blue, source_scale), _mm_mul_ps(destination_blue, inverse_alpha)));
+    __m128i result_alpha    = _mm_cvtps_epi32(_mm_add_ps(source_scale, _mm_mul_ps(destination_alpha, inverse_alpha)));
+
+    return _mm_or_si128(_mm_or_si128(result_red, _mm_slli_epi32(result_green, 8)),
+                        _mm_or_si128(_mm_slli_epi32(result_blue, 16), _mm_slli_epi32(result_alpha, 24)));
+}
+
+/**
+ * @brief      Clamps 4 values into range [0, 1].
+ *
+ * @param[in]  value  Values to clamp.
+ *
+ * @return     Clamped values.
+ */
+static inline __m128 cgui_saturate(__m128 value)
+{
+    return _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+}
+
+/**
+ * @brief      Replaces masked pixels in framebuffer.
+ *
+ * @param      target  First of 4 pixels.
+ * @param[in]  mask    Lane mask.
+ * @param[in]  blended Blended pixels.
+ * @param[in]  old     Pixels, that were loaded from target.
+ */
+static inline void cgui_store_pixels(uint32_t* target, __m128i mask, __m128i blended, __m128i old)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_or_si128(_mm_and_si128(mask, blended), _mm_andnot_si128(mask, old)));
+}
+#else
+/**
+ * @brief      Blends color over RGBA8 pixel with straight alpha.
+ *
+ * @param[in]  destination  Pixel in framebuffer.
+ * @param[in]  color        Source color in range [0, 1].
+ *
+ * @return     Blended pixel.
+ */
+static inline uint32_t cgui_blend_pixel(uint32_t destination, glm::fvec4 color)
+{
+    float inverse_alpha = 1.0f - color.w;
+    float source_scale = color.w * 255.0f;
+
+    uint32_t red    = (uint32_t)std::lround(color.x * source_scale + (float)(destination & 0xff) * inverse_alpha);
+    uint32_t green  = (uint32_t)std::lround(color.y * source_scale + (float)((destination >> 8) & 0xff) * inverse_alpha);
+    uint32_t blue   = (uint32_t)std::lround(color.z * source_scale + (float)((destination >> 16) & 0xff) * inverse_alpha);
+    uint32_t alpha  = (uint32_t)std::lround(source_scale + (float)(destination >> 24) * inverse_alpha);
+
+    return red | (green << 8) | (blue << 16) | (alpha << 24);
+}
+#endif // CGUI_SOFTWARE_SSE2
+
+/**
+ * @brief      Constructs a new software renderer and starts its thread pool.
+ *
+ * @param[in]  framebuffer_size_arg  Size of the framebuffer in pixels.
+ * @param[in]  thread_count          Amount of rasterizing threads including caller of draw, 0 uses all cores.
+ */
+CGUISoftwareRenderer::CGUISoftwareRenderer(glm::ivec2 framebuffer_size_arg, std::size_t thread_count)
+{
+    resize(framebuffer_size_arg);
+
+    if (thread_count == 0)
+    {
+        thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    // Thread, that calls draw, rasterizes tiles as well
+    for (std::size_t worker_index = 1; worker_index < thread_count; ++worker_index)
+    {
+        workers.emplace_back(&CGUISoftwareRenderer::worker_thread, this);
+    }
+}
+
+/**
+ * @brief      Destroys software renderer and stops its thread pool.
+ */
+CGUISoftwareRenderer::~CGUISoftwareRenderer()
+{
+    {
+        std::lock_guard pool_lock(pool_mutex);
+        pool_stopped = true;
+    }
+    pool_con_v.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+/**
+ * @brief      Adds object, indices are read as triangle list, object without indices is drawn as triangle list of vertices.
+ *
+ * @param[in]  new_object  Object to draw.
+ */
+void CGUISoftwareRenderer::add_object(CGUIObject new_object)
+{
+    objects.push_back(std::move(new_object));
+    submissions.push_back((uint32_t)(objects.size() - 1));
+}
+
+/**
+ * @brief      Adds axis aligned quad.
+ *
+ * @param[in]  min_corner  Bottom left corner in NDC.
+ * @param[in]  max_corner  Top right corner in NDC.
+ * @param[in]  color       Straight alpha color.
+ */
+void CGUISoftwareRenderer::add_quad(glm::fvec2 min_corner, glm::fvec2 max_corner, glm::fvec4 color)
+{
+    submitted_quads.push_back({min_corner, max_corner, color});
+    submissions.push_back((uint32_t)(submitted_quads.size() - 1) | CGUI_SOFTWARE_QUAD_BIT);
+}
+
+/**
+ * @brief      Removes all objects and quads.
+ */
+void CGUISoftwareRenderer::clear_objects()
+{
+    objects.clear();
+    submitted_quads.clear();
+    submissions.clear();
+}
+
+/**
+ * @brief      Sets color, that every frame starts with.
+ *
+ * @param[in]  clear_color_arg  Clear color.
+ */
+void CGUISoftwareRenderer::set_clear_color(glm::fvec4 clear_color_arg)
+{
+    clear_color = clear_color_arg;
+}
+
+/**
+ * @brief      Resizes framebuffer, should not be called during draw.
+ *
+ * @param[in]  framebuffer_size_arg  New size in pixels.
+ */
+void CGUISoftwareRenderer::resize(glm::ivec2 framebuffer_size_arg)
+{
+    framebuffer_size = {std::max(framebuffer_size_arg.x, 0), std::max(framebuffer_size_arg.y, 0)};
+
+    // Rows are padded, so 4 pixel groups never cross them
+    stride = ((std::size_t)framebuffer_size.x + 3) / 4 * 4;
+    tile_count = {(framebuffer_size.x + CGUI_SOFTWARE_TILE_SIZE - 1) / CGUI_SOFTWARE_TILE_SIZE, (framebuffer_size.y + CGUI_SOFTWARE_TILE_SIZE - 1) / CGUI_SOFTWARE_TILE_SIZE};
+
+    pixels.assign(stride * framebuffer_size.y, pack_color(clear_color));
+    tile_bins.resize((std::size_t)tile_count.x * tile_count.y);
+}
+
+/**
+ * @brief      Rasterizes all objects into framebuffer, returns after the whole frame is ready.
+ */
+void CGUISoftwareRenderer::draw()
+{
+    if (framebuffer_size.x <= 0 || framebuffer_size.y <= 0)
+    {
+        return;
+    }
+
+    setup_primitives();
+    bin_primitives();
+
+    // Order matters, late worker of the previous frame must not finish tiles of this one
+    finished_tiles.store(0);
+    next_tile.store(0);
+    {
+        std::lock_guard pool_lock(pool_mutex);
+        job_generation++;
+    }
+    pool_con_v.notify_all();
+
+    process_tiles();
+
+    std::unique_lock pool_lock(pool_mutex);
+    done_con_v.wait(pool_lock, [this]{ return finished_tiles.load() >= tile_bins.size(); });
+}
+
+/**
+ * @brief      Copies framebuffer into window through GL blit, has to be called from thread with GL context.
+ *
+ * @param[in]  window_framebuffer_size  Size of default framebuffer, image is stretched to it.
+ */
+void CGUISoftwareRenderer::present(glm::ivec2 window_framebuffer_size)
+{
+    if (framebuffer_size.x <= 0 || framebuffer_size.y <= 0)
+    {
+        return;
+    }
+
+    if (texture_id == 0)
+    {
+        glGenTextures(1, &texture_id);
+        glGenFramebuffers(1, &frame_buffer_id);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+
+    if (texture_size != framebuffer_size)
+    {
+        texture_size = framebuffer_size;
+
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, texture_size.x, texture_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer_id);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture_id, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        main_memory_tracker.register_object(CGUI_MEMORY_TEXTURE, texture_id, (std::size_t)texture_size.x * (std::size_t)texture_size.y * 4, GL_STREAM_DRAW, "CGUISoftwareRenderer");
+    }
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, (GLint)stride);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, framebuffer_size.x, framebuffer_size.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, frame_buffer_id);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, framebuffer_size.x, framebuffer_size.y, 0, 0, window_framebuffer_size.x, window_framebuffer_size.y, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/**
+ * @brief      Deletes GL objects, used by present.
+ */
+void CGUISoftwareRenderer::destroy()
+{
+    main_memory_tracker.unregister_object(CGUI_MEMORY_TEXTURE, texture_id);
+
+    glDeleteTextures(1, &texture_id);
+    glDeleteFramebuffers(1, &frame_buffer_id);
+
+    texture_id = 0;
+    frame_buffer_id = 0;
+    texture_size = {0, 0};
+}
+
+/**
+ * @brief      Gets framebuffer for headless output.
+ *
+ * @return     RGBA8 pixels, rows go bottom to top and are get_stride() pixels long.
+ */
+const uint32_t* CGUISoftwareRenderer::get_pixels()
+{
+    return pixels.data();
+}
+
+/**
+ * @brief      Gets row length of the framebuffer.
+ *
+ * @return     Row length in pixels.
+ */
+std::size_t CGUISoftwareRenderer::get_stride()
+{
+    return stride;
+}
+
+/**
+ * @brief      Gets framebuffer size.
+ *
+ * @return     Size in pixels.
+ */
+glm::ivec2 CGUISoftwareRenderer::get_size()
+{
+    return framebuffer_size;
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Converts submitted objects and quads into pixel space primitives.
+ */
+void CGUISoftwareRenderer::setup_primitives()
+{
+    triangles.clear();
+    quads.clear();
+    primitive_order.clear();
+
+    for (uint32_t submission : submissions)
+    {
+        if (submission & CGUI_SOFTWARE_QUAD_BIT)
+        {
+            const CGUISoftwareQuadSubmission& submitted_quad = submitted_quads[submission & ~CGUI_SOFTWARE_QUAD_BIT];
+
+            glm::fvec2 first_corner = to_pixels({submitted_quad.min_corner.x, submitted_quad.min_corner.y, 0.0f});
+            glm::fvec2 second_corner = to_pixels({submitted_quad.max_corner.x, submitted_quad.max_corner.y, 0.0f});
+
+            // Pixel is covered if its center is inside the quad
+            CGUISoftwareQuad quad;
+            quad.min_corner = {std::clamp((int)std::ceil(std::min(first_corner.x, second_corner.x) - 0.5f), 0, framebuffer_size.x),
+                               std::clamp((int)std::ceil(std::min(first_corner.y, second_corner.y) - 0.5f), 0, framebuffer_size.y)};
+            quad.max_corner = {std::clamp((int)std::ceil(std::max(first_corner.x, second_corner.x) - 0.5f), 0, framebuffer_size.x),
+                               std::clamp((int)std::ceil(std::max(first_corner.y, second_corner.y) - 0.5f), 0, framebuffer_size.y)};
+            quad.color = {std::clamp(submitted_quad.color.x, 0.0f, 1.0f), std::clamp(submitted_quad.color.y, 0.0f, 1.0f),
+                          std::clamp(submitted_quad.color.z, 0.0f, 1.0f), std::clamp(submitted_quad.color.w, 0.0f, 1.0f)};
+
+            if (quad.min_corner.x >= quad.max_corner.x || quad.min_corner.y >= quad.max_corner.y || quad.color.w <= 0.0f)
+            {
+                continue;
+            }
+
+            primitive_order.push_back((uint32_t)quads.size() | CGUI_SOFTWARE_QUAD_BIT);
+            quads.push_back(quad);
+            continue;
+        }
+
+        const CGUIObject& object = objects[submission];
+
+        if (object.indices.empty())
+        {
+            for (std::size_t vertex = 0; vertex + 2 < object.vertices.size(); vertex += 3)
+            {
+                setup_triangle(object.vertices[vertex], object.vertices[vertex + 1], object.vertices[vertex + 2]);
+            }
+            continue;
+        }
+
+        for (std::size_t index = 0; index + 2 < object.indices.size(); index += 3)
+        {
+            if (object.indices[index] >= object.vertices.size() || object.indices[index + 1] >= object.vertices.size() || object.indices[index + 2] >= object.vertices.size())
+            {
+                continue;
+            }
+            setup_triangle(object.vertices[object.indices[index]], object.vertices[object.indices[index + 1]], object.vertices[object.indices[index + 2]]);
+        }
+    }
+}
+
+/**
+ * @brief      Computes edge functions and color planes of the triangle.
+ *
+ * @param[in]  first   First vertex.
+ * @param[in]  second  Second vertex.
+ * @param[in]  third   Third vertex.
+ */
+void CGUISoftwareRenderer::setup_triangle(const CGUIVertex& first, const CGUIVertex& second, const CGUIVertex& third)
+{
+    glm::fvec2 points[3] = {to_pixels(first.position), to_pixels(second.position), to_pixels(third.position)};
+    glm::fvec4 colors[3] = {first.color, second.color, third.color};
+
+    float area = (points[1].x - points[0].x) * (points[2].y - points[0].y) - (points[1].y - points[0].y) * (points[2].x - points[0].x);
+
+    // Degenerate and NaN triangles are skipped, clockwise ones are flipped, there is no culling
+    if (!(std::fabs(area) > 0.0f))
+    {
+        return;
+    }
+    if (area < 0.0f)
+    {
+        std::swap(points[1], points[2]);
+        std::swap(colors[1], colors[2]);
+        area = -area;
+    }
+
+    CGUISoftwareTriangle triangle;
+
+    float min_x = std::min({points[0].x, points[1].x, points[2].x});
+    float min_y = std::min({points[0].y, points[1].y, points[2].y});
+    float max_x = std::max({points[0].x, points[1].x, points[2].x});
+    float max_y = std::max({points[0].y, points[1].y, points[2].y});
+
+    triangle.min_corner = {std::clamp((int)std::floor(min_x), 0, framebuffer_size.x), std::clamp((int)std::floor(min_y), 0, framebuffer_size.y)};
+    triangle.max_corner = {std::clamp((int)std::ceil(max_x), 0, framebuffer_size.x), std::clamp((int)std::ceil(max_y), 0, framebuffer_size.y)};
+
+    if (triangle.min_corner.x >= triangle.max_corner.x || triangle.min_corner.y >= triangle.max_corner.y)
+    {
+        return;
+    }
+
+    // Edge functions are evaluated relative to the bounding box, which keeps float precision on big framebuffers
+    glm::fvec2 origin = {(float)triangle.min_corner.x, (float)triangle.min_corner.y};
+    float edge_a[3], edge_b[3], edge_c[3];
+
+    // Edge i is opposite to vertex i, so its function is barycentric weight of vertex i times area
+    for (std::size_t edge = 0; edge < 3; ++edge)
+    {
+        const glm::fvec2& start = points[(edge + 1) % 3];
+        const glm::fvec2& end = points[(edge + 2) % 3];
+
+        edge_a[edge] = start.y - end.y;
+        edge_b[edge] = end.x - start.x;
+        edge_c[edge] = -(edge_a[edge] * (start.x - origin.x) + edge_b[edge] * (start.y - origin.y));
+
+        // Counter clockwise triangle with y up: left edges go down, top edges go left
+        triangle.edge_top_left[edge] = (end.y < start.y) || (end.y == start.y && end.x < start.x);
+    }
+
+    triangle.edge_a = {edge_a[0], edge_a[1], edge_a[2]};
+    triangle.edge_b = {edge_b[0], edge_b[1], edge_b[2]};
+    triangle.edge_c = {edge_c[0], edge_c[1], edge_c[2]};
+
+    float inverse_area = 1.0f / area;
+    triangle.color_dx = {
+        (edge_a[0] * colors[0].x + edge_a[1] * colors[1].x + edge_a[2] * colors[2].x) * inverse_area,
+        (edge_a[0] * colors[0].y + edge_a[1] * colors[1].y + edge_a[2] * colors[2].y) * inverse_area,
+        (edge_a[0] * colors[0].z + edge_a[1] * colors[1].z + edge_a[2] * colors[2].z) * inverse_area,
+        (edge_a[0] * colors[0].w + edge_a[1] * colors[1].w + edge_a[2] * colors[2].w) * inverse_area
+    };
+    triangle.color_dy = {
+        (edge_b[0] * colors[0].x + edge_b[1] * colors[1].x + edge_b[2] * colors[2].x) * inverse_area,
+        (edge_b[0] * colors[0].y + edge_b[1] * colors[1].y + edge_b[2] * colors[2].y) * inverse_area,
+        (edge_b[0] * colors[0].z + edge_b[1] * colors[1].z + edge_b[2] * colors[2].z) * inverse_area,
+        (edge_b[0] * colors[0].w + edge_b[1] * colors[1].w + edge_b[2] * colors[2].w) * inverse_area
+    };
+    triangle.color_origin = {
+        (edge_c[0] * colors[0].x + edge_c[1] * colors[1].x + edge_c[2] * colors[2].x) * inverse_area,
+        (edge_c[0] * colors[0].y + edge_c[1] * colors[1].y + edge_c[2] * colors[2].y) * inverse_area,
+        (edge_c[0] * colors[0].z + edge_c[1] * colors[1].z + edge_c[2] * colors[2].z) * inverse_area,
+        (edge_c[0] * colors[0].w + edge_c[1] * colors[1].w + edge_c[2] * colors[2].w) * inverse_area
+    };
+
+    primitive_order.push_back((uint32_t)triangles.size());
+    triangles.push_back(triangle);
+}
+
+/**
+ * @brief      Adds every primitive to bins of the tiles it overlaps, keeping submission order.
+ */
+void CGUISoftwareRenderer::bin_primitives()
+{
+    for (std::vector<uint32_t>& tile_bin : tile_bins)
+    {
+        tile_bin.clear();
+    }
+
+    for (uint32_t primitive : primitive_order)
+    {
+        bool is_quad = primitive & CGUI_SOFTWARE_QUAD_BIT;
+        const CGUISoftwareTriangle* triangle = is_quad ? nullptr : &triangles[primitive];
+
+        glm::ivec2 min_corner = is_quad ? quads[primitive & ~CGUI_SOFTWARE_QUAD_BIT].min_corner : triangle->min_corner;
+        glm::ivec2 max_corner = is_quad ? quads[primitive & ~CGUI_SOFTWARE_QUAD_BIT].max_corner : triangle->max_corner;
+
+        for (int tile_y = min_corner.y / CGUI_SOFTWARE_TILE_SIZE; tile_y <= (max_corner.y - 1) / CGUI_SOFTWARE_TILE_SIZE; ++tile_y)
+        {
+            for (int tile_x = min_corner.x / CGUI_SOFTWARE_TILE_SIZE; tile_x <= (max_corner.x - 1) / CGUI_SOFTWARE_TILE_SIZE; ++tile_x)
+            {
+                // Tile is skipped if the most inner pixel center of it is outside of any edge
+                if (triangle != nullptr)
+                {
+                    float tile_min_x = tile_x * CGUI_SOFTWARE_TILE_SIZE + 0.5f - triangle->min_corner.x;
+                    float tile_min_y = tile_y * CGUI_SOFTWARE_TILE_SIZE + 0.5f - triangle->min_corner.y;
+                    float tile_max_x = tile_min_x + CGUI_SOFTWARE_TILE_SIZE - 1.0f;
+                    float tile_max_y = tile_min_y + CGUI_SOFTWARE_TILE_SIZE - 1.0f;
+
+                    if (triangle->edge_a.x * ((triangle->edge_a.x > 0.0f) ? tile_max_x : tile_min_x) + triangle->edge_b.x * ((triangle->edge_b.x > 0.0f) ? tile_max_y : tile_min_y) + triangle->edge_c.x < 0.0f ||
+                        triangle->edge_a.y * ((triangle->edge_a.y > 0.0f) ? tile_max_x : tile_min_x) + triangle->edge_b.y * ((triangle->edge_b.y > 0.0f) ? tile_max_y : tile_min_y) + triangle->edge_c.y < 0.0f ||
+                        triangle->edge_a.z * ((triangle->edge_a.z > 0.0f) ? tile_max_x : tile_min_x) + triangle->edge_b.z * ((triangle->edge_b.z > 0.0f) ? tile_max_y : tile_min_y) + triangle->edge_c.z < 0.0f)
+                    {
+                        continue;
+                    }
+                }
+
+                tile_bins[(std::size_t)tile_y * tile_count.x + tile_x].push_back(primitive);
+            }
+        }
+    }
+}
+
+/**
+ * @brief      Worker of thread pool, it joins every draw until renderer is destroyed.
+ */
+void CGUISoftwareRenderer::worker_thread()
+{
+    uint64_t last_generation = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock pool_lock(pool_mutex);
+            pool_con_v.wait(pool_lock, [this, last_generation]{ return pool_stopped || job_generation != last_generation; });
+
+            if (pool_stopped)
+            {
+                return;
+            }
+            last_generation = job_generation;
+        }
+
+        process_tiles();
+    }
+}
+
+/**
+ * @brief      Takes tiles, until there are none left.
+ */
+void CGUISoftwareRenderer::process_tiles()
+{
+    std::size_t total_tiles = tile_bins.size();
+
+    for (std::size_t tile_index = next_tile.fetch_add(1); tile_index < total_tiles; tile_index = next_tile.fetch_add(1))
+    {
+        rasterize_tile(tile_index);
+
+        if (finished_tiles.fetch_add(1) + 1 == total_tiles)
+        {
+            std::lock_guard pool_lock(pool_mutex);
+            done_con_v.notify_all();
+        }
+    }
+}
+
+/**
+ * @brief      Clears tile and draws its bin.
+ *
+ * @param[in]  tile_index  Index of the tile.
+ */
+void CGUISoftwareRenderer::rasterize_tile(std::size_t tile_index)
+{
+    glm::ivec2 tile_min = {(int)(tile_index % tile_count.x) * CGUI_SOFTWARE_TILE_SIZE, (int)(tile_index / tile_count.x) * CGUI_SOFTWARE_TILE_SIZE};
+    glm::ivec2 tile_max = {std::min(tile_min.x + CGUI_SOFTWARE_TILE_SIZE, framebuffer_size.x), std::min(tile_min.y + CGUI_SOFTWARE_TILE_SIZE, framebuffer_size.y)};
+
+    uint32_t packed_clear_color = pack_color(clear_color);
+    for (int y = tile_min.y; y < tile_max.y; ++y)
+    {
+        std::fill(pixels.begin() + y * stride + tile_min.x, pixels.begin() + y * stride + tile_max.x, packed_clear_color);
+    }
+
+    for (uint32_t primitive : tile_bins[tile_index])
+    {
+        if (primitive & CGUI_SOFTWARE_QUAD_BIT)
+        {
+            rasterize_quad(quads[primitive & ~CGUI_SOFTWARE_QUAD_BIT], tile_min, tile_max);
+        }
+        else
+        {
+            rasterize_triangle(triangles[primitive], tile_min, tile_max);
+        }
+    }
+}
+
+/**
+ * @brief      Draws part of the triangle, that lies in the tile.
+ *
+ * @param[in]  triangle  Triangle after setup.
+ * @param[in]  tile_min  Bottom left pixel of the tile.
+ * @param[in]  tile_max  Top right pixel of the tile, exclusive.
+ */
+void CGUISoftwareRenderer::rasterize_triangle(const CGUISoftwareTriangle& triangle, glm::ivec2 tile_min, glm::ivec2 tile_max)
+{
+    glm::ivec2 area_min = {std::max(triangle.min_corner.x, tile_min.x), std::max(triangle.min_corner.y, tile_min.y)};
+    glm::ivec2 area_max = {std::min(triangle.max_corner.x, tile_max.x), std::min(triangle.max_corner.y, tile_max.y)};
+
+    if (area_min.x >= area_max.x || area_min.y >= area_max.y)
+    {
+        return;
+    }
+
+#ifdef CGUI_SOFTWARE_SSE2
+    // Tiles start at multiples of 4, so aligned groups never leave the tile
+    int start_x = area_min.x & ~3;
+
+    const __m128 lane_offset = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128i lane_index = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i range_min = _mm_set1_epi32(area_min.x - 1);
+    const __m128i range_max = _mm_set1_epi32(area_max.x);
+    const __m128 zero = _mm_setzero_ps();
+
+    const __m128 edge_a[3] = {_mm_set1_ps(triangle.edge_a.x), _mm_set1_ps(triangle.edge_a.y), _mm_set1_ps(triangle.edge_a.z)};
+    const __m128 color_dx[4] = {_mm_set1_ps(triangle.color_dx.x), _mm_set1_ps(triangle.color_dx.y), _mm_set1_ps(triangle.color_dx.z), _mm_set1_ps(triangle.color_dx.w)};
+
+    for (int y = area_min.y; y < area_max.y; ++y)
+    {
+        float pixel_y = y + 0.5f - triangle.min_corner.y;
+        uint32_t* row = pixels.data() + y * stride;
+
+        const __m128 edge_row[3] = {
+            _mm_set1_ps(triangle.edge_b.x * pixel_y + triangle.edge_c.x),
+            _mm_set1_ps(triangle.edge_b.y * pixel_y + triangle.edge_c.y),
+            _mm_set1_ps(triangle.edge_b.z * pixel_y + triangle.edge_c.z)
+        };
+        const __m128 color_row[4] = {
+            _mm_set1_ps(triangle.color_dy.x * pixel_y + triangle.color_origin.x),
+            _mm_set1_ps(triangle.color_dy.y * pixel_y + triangle.color_origin.y),
+            _mm_set1_ps(triangle.color_dy.z * pixel_y + triangle.color_origin.z),
+            _mm_set1_ps(triangle.color_dy.w * pixel_y + triangle.color_origin.w)
+        };
+
+        for (int x = start_x; x < area_max.x; x += 4)
+        {
+            __m128 pixel_x = _mm_add_ps(_mm_set1_ps((float)(x - triangle.min_corner.x)), lane_offset);
+            __m128i pixel_index = _mm_add_epi32(_mm_set1_epi32(x), lane_index);
+
+            __m128i mask = _mm_and_si128(_mm_cmpgt_epi32(pixel_index, range_min), _mm_cmplt_epi32(pixel_index, range_max));
+            for (std::size_t edge = 0; edge < 3; ++edge)
+            {
+                __m128 weight = _mm_add_ps(_mm_mul_ps(edge_a[edge], pixel_x), edge_row[edge]);
+                __m128 inside = (triangle.edge_top_left[edge] == true) ? _mm_cmpge_ps(weight, zero) : _mm_cmpgt_ps(weight, zero);
+                mask = _mm_and_si128(mask, _mm_castps_si128(inside));
+            }
+
+            if (_mm_movemask_epi8(mask) == 0)
+            {
+                continue;
+            }
+
+            __m128 red      = cgui_saturate(_mm_add_ps(_mm_mul_ps(color_dx[0], pixel_x), color_row[0]));
+            __m128 green    = cgui_saturate(_mm_add_ps(_mm_mul_ps(color_dx[1], pixel_x), color_row[1]));
+            __m128 blue     = cgui_saturate(_mm_add_ps(_mm_mul_ps(color_dx[2], pixel_x), color_row[2]));
+            __m128 alpha    = cgui_saturate(_mm_add_ps(_mm_mul_ps(color_dx[3], pixel_x), color_row[3]));
+
+            __m128i old_pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+            cgui_store_pixels(row + x, mask, cgui_blend_pixels(old_pixels, red, green, blue, alpha), old_pixels);
+        }
+    }
+#else
+    for (int y = area_min.y; y < area_max.y; ++y)
+    {
+        float pixel_y = y + 0.5f - triangle.min_corner.y;
+        uint32_t* row = pixels.data() + y * stride;
+
+        for (int x = area_min.x; x < area_max.x; ++x)
+        {
+            float pixel_x = x + 0.5f - triangle.min_corner.x;
+
+            float weights[3] = {
+                triangle.edge_a.x * pixel_x + triangle.edge_b.x * pixel_y + triangle.edge_c.x,
+                triangle.edge_a.y * pixel_x + triangle.edge_b.y * pixel_y + triangle.edge_c.y,
+                triangle.edge_a.z * pixel_x + triangle.edge_b.z * pixel_y + triangle.edge_c.z
+            };
+
+            bool inside = true;
+            for (std::size_t edge = 0; edge < 3; ++edge)
+            {
+                inside = inside && ((triangle.edge_top_left[edge] == true) ? weights[edge] >= 0.0f : weights[edge] > 0.0f);
+            }
+
+            if (!inside)
+            {
+                continue;
+            }
+
+            glm::fvec4 color = {
+                std::clamp(triangle.color_dx.x * pixel_x + triangle.color_dy.x * pixel_y + triangle.color_origin.x, 0.0f, 1.0f),
+                std::clamp(triangle.color_dx.y * pixel_x + triangle.color_dy.y * pixel_y + triangle.color_origin.y, 0.0f, 1.0f),
+                std::clamp(triangle.color_dx.z * pixel_x + triangle.color_dy.z * pixel_y + triangle.color_origin.z, 0.0f, 1.0f),
+                std::clamp(triangle.color_dx.w * pixel_x + triangle.color_dy.w * pixel_y + triangle.color_origin.w, 0.0f, 1.0f)
+            };
+
+            row[x] = cgui_blend_pixel(row[x], color);
+        }
+    }
+#endif // CGUI_SOFTWARE_SSE2
+}
+
+/**
+ * @brief      Draws part of the quad, that lies in the tile.
+ *
+ * @param[in]  quad      Quad in pixels.
+ * @param[in]  tile_min  Bottom left pixel of the tile.
+ * @param[in]  tile_max  Top right pixel of the tile, exclusive.
+ */
+void CGUISoftwareRenderer::rasterize_quad(const CGUISoftwareQuad& quad, glm::ivec2 tile_min, glm::ivec2 tile_max)
+{
+    glm::ivec2 area_min = {std::max(quad.min_corner.x, tile_min.x), std::max(quad.min_corner.y, tile_min.y)};
+    glm::ivec2 area_max = {std::min(quad.max_corner.x, tile_max.x), std::min(quad.max_corner.y, tile_max.y)};
+
+    if (area_min.x >= area_max.x || area_min.y >= area_max.y)
+    {
+        return;
+    }
+
+    // Opaque quads are plain fills
+    if (quad.color.w >= 1.0f)
+    {
+        uint32_t packed_color = pack_color(quad.color);
+        for (int y = area_min.y; y < area_max.y; ++y)
+        {
+            std::fill(pixels.begin() + y * stride + area_min.x, pixels.begin() + y * stride + area_max.x, packed_color);
+        }
+        return;
+    }
+
+#ifdef CGUI_SOFTWARE_SSE2
+    int start_x = area_min.x & ~3;
+
+    const __m128i lane_index = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i range_min = _mm_set1_epi32(area_min.x - 1);
+    const __m128i range_max = _mm_set1_epi32(area_max.x);
+
+    const __m128 red    = _mm_set1_ps(quad.color.x);
+    const __m128 green  = _mm_set1_ps(quad.color.y);
+    const __m128 blue   = _mm_set1_ps(quad.color.z);
+    const __m128 alpha  = _mm_set1_ps(quad.color.w);
+
+    for (int y = area_min.y; y < area_max.y; ++y)
+    {
+        uint32_t* row = pixels.data() + y * stride;
+
+        for (int x = start_x; x < area_max.x; x += 4)
+        {
+            __m128i pixel_index = _mm_add_epi32(_mm_set1_epi32(x), lane_index);
+            __m128i mask = _mm_and_si128(_mm_cmpgt_epi32(pixel_index, range_min), _mm_cmplt_epi32(pixel_index, range_max));
+
+            __m128i old_pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+            cgui_store_pixels(row + x, mask, cgui_blend_pixels(old_pixels, red, green, blue, alpha), old_pixels);
+        }
+    }
+#else
+    for (int y = area_min.y; y < area_max.y; ++y)
+    {
+        uint32_t* row = pixels.data() + y * stride;
+
+        for (int x = area_min.x; x < area_max.x; ++x)
+        {
+            row[x] = cgui_blend_pixel(row[x], quad.color);
+        }
+    }
+#endif // CGUI_SOFTWARE_SSE2
+}
+
+/**
+ * @brief      Converts NDC position into pixel space.
+ *
+ * @param[in]  position  Position in NDC.
+ *
+ * @return     Position in pixels, bottom left origin.
+ */
+glm::fvec2 CGUISoftwareRenderer::to_pixels(const glm::fvec3& position)
+{
+    return {(position.x * 0.5f + 0.5f) * framebuffer_size.x, (position.y * 0.5f + 0.5f) * framebuffer_size.y};
+}
+
+/**
+ * @brief      Packs color into RGBA8 pixel.
+ *
+ * @param[in]  color  Color in range [0, 1].
+ *
+ * @return     Packed pixel, red is in the lowest byte.
+ */
+uint32_t CGUISoftwareRenderer::pack_color(glm::fvec4 color)
+{
+    uint32_t red    = (uint32_t)std::lround(std::clamp(color.x, 0.0f, 1.0f) * 255.0f);
+    uint32_t green  = (uint32_t)std::lround(std::clamp(color.y, 0.0f, 1.0f) * 255.0f);
+    uint32_t blue   = (uint32_t)std::lround(std::clamp(color.z, 0.0f, 1.0f) * 255.0f);
+    uint32_t alpha  = (uint32_t)std::lround(std::clamp(color.w, 0.0f, 1.0f) * 255.0f);
+
+    return red | (green << 8) | (blue << 16) | (alpha << 24);
+}
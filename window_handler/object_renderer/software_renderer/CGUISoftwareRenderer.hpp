@@ -0,0 +1,183 @@
+/**
+ * @file       <CGUISoftwareRenderer.hpp>
+ * @brief      This header file implements CGUISoftwareRenderer class.
+ *
+ *             It is being used in order to draw objects on machines without
+ *             usable GPU, by rasterizing them on CPU.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUISOFTWARERENDERER_HPP
+#define CGUISOFTWARERENDERER_HPP
+
+/**
+ * Include GLFW and GLAD for window handling.
+ */
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+
+#include "../vbo_handler/CGUIVBOHandler.hpp"
+#include "../../memory_tracker/CGUIMemoryTracker.hpp"
+
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Size of the square tile, every tile is rasterized by one thread. Has to be multiple of 4.
+ */
+#define CGUI_SOFTWARE_TILE_SIZE     64
+
+/**
+ * Bin entries with this bit set refer to quads, the rest to triangles.
+ */
+#define CGUI_SOFTWARE_QUAD_BIT      0x80000000u
+
+/**
+ * Triangle after setup, edge functions and color planes are in pixel space.
+ */
+struct CGUISoftwareTriangle
+{
+    glm::fvec3  edge_a;                 // dE/dx of the three edges
+    glm::fvec3  edge_b;                 // dE/dy of the three edges
+    glm::fvec3  edge_c;                 // E at pixel space origin
+    bool        edge_top_left[3];       // Edges, that own pixels lying exactly on them
+
+    glm::fvec4  color_dx;
+    glm::fvec4  color_dy;
+    glm::fvec4  color_origin;
+
+    glm::ivec2  min_corner;
+    glm::ivec2  max_corner;             // Exclusive
+};
+
+/**
+ * Axis aligned quad in pixels, filled without edge functions.
+ */
+struct CGUISoftwareQuad
+{
+    glm::ivec2  min_corner;
+    glm::ivec2  max_corner;             // Exclusive
+    glm::fvec4  color;
+};
+
+/**
+ * Quad, as it was submitted, in NDC.
+ */
+struct CGUISoftwareQuadSubmission
+{
+    glm::fvec2  min_corner;
+    glm::fvec2  max_corner;
+    glm::fvec4  color;
+};
+
+/**
+ * @brief      This class implements CPU rasterizer with the same draw interface as CGUIObjectRenderer.
+ *
+ *             Vertex positions are given in NDC, like for GL renderer, only vertex colors are used.
+ *             Primitives are binned into tiles, tiles are rasterized in parallel by thread pool,
+ *             4 pixels at a time with SSE2, or one at a time where it is not available.
+ *             Primitives are blended in submission order with straight alpha. Framebuffer is RGBA8
+ *             with rows stored bottom to top, so it can be uploaded to GL as is.
+ */
+class CGUISoftwareRenderer
+{
+public:
+    CGUISoftwareRenderer(glm::ivec2 framebuffer_size_arg, std::size_t thread_count = 0);
+    CGUISoftwareRenderer(const CGUISoftwareRenderer&) = delete;
+    ~CGUISoftwareRenderer();
+
+    void add_object(CGUIObject new_object);
+    void add_quad(glm::fvec2 min_corner, glm::fvec2 max_corner, glm::fvec4 color);
+    void clear_objects();
+
+    void set_clear_color(glm::fvec4 clear_color_arg);
+    void resize(glm::ivec2 framebuffer_size_arg);
+
+    void draw();
+    void present(glm::ivec2 window_framebuffer_size);
+    void destroy();
+
+    const uint32_t* get_pixels();
+    std::size_t     get_stride();
+    glm::ivec2      get_size();
+
+private:
+    void setup_primitives();
+    void bin_primitives();
+    void setup_triangle(const CGUIVertex& first, const CGUIVertex& second, const CGUIVertex& third);
+
+    void worker_thread();
+    void process_tiles();
+    void rasterize_tile(std::size_t tile_index);
+    void rasterize_triangle(const CGUISoftwareTriangle& triangle, glm::ivec2 tile_min, glm::ivec2 tile_max);
+    void rasterize_quad(const CGUISoftwareQuad& quad, glm::ivec2 tile_min, glm::ivec2 tile_max);
+
+    glm::fvec2 to_pixels(const glm::fvec3& position);
+
+    static uint32_t pack_color(glm::fvec4 color);
+
+private:
+    glm::ivec2  framebuffer_size;
+    std::size_t stride;                 // Row length in pixels, rounded up to 4
+    glm::ivec2  tile_count;
+
+    std::vector<uint32_t>   pixels;
+    glm::fvec4              clear_color = {0.0f, 0.0f, 0.0f, 1.0f};
+
+    /**
+     * Submitted objects and quads, submissions keep their order, quad entries have CGUI_SOFTWARE_QUAD_BIT.
+     */
+    std::vector<CGUIObject>             objects;
+    std::vector<CGUISoftwareQuadSubmission> submitted_quads;
+    std::vector<uint32_t>               submissions;
+
+    /**
+     * Primitives of the current frame in submission order.
+     */
+    std::vector<CGUISoftwareTriangle>   triangles;
+    std::vector<CGUISoftwareQuad>       quads;
+    std::vector<uint32_t>               primitive_order;
+    std::vector<std::vector<uint32_t>>  tile_bins;
+
+    /**
+     * Thread pool state.
+     */
+    std::vector<std::thread>    workers;
+    std::mutex                  pool_mutex;
+    std::condition_variable     pool_con_v;
+    std::condition_variable     done_con_v;
+    uint64_t                    job_generation  = 0;
+    bool                        pool_stopped    = false;
+    std::atomic<std::size_t>    next_tile       = 0;
+    std::atomic<std::size_t>    finished_tiles  = 0;
+
+    /**
+     * GL objects, used by present.
+     */
+    GLuint      texture_id          = 0;
+    GLuint      frame_buffer_id     = 0;
+    glm::ivec2  texture_size        = {0, 0};
+};
+
+#endif // CGUISOFTWARERENDERER_HPP
@@ -0,0 +1,203 @@
+/**
+ * @file       <CGUIUniformRing.cpp>
+ * @brief      This source file implements CGUIUniformRing class.
+ *
+ *             It is being used in order to pass per draw uniforms to shaders
+ *             through uniform buffer, that is written by CPU without any GL calls.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUIUniformRing.hpp"
+
+/**
+ * @brief      Constructs a new uniform ring, has to be called from render thread.
+ *
+ * @param[in]  frame_size_arg  Size of the part of one frame in bytes.
+ */
+CGUIUniformRing::CGUIUniformRing(std::size_t frame_size_arg)
+{
+    debug_handler = CGUIDebugHandler(main_debug_handler);
+
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    offset_alignment = (alignment > 0) ? (std::size_t)alignment : offset_alignment;
+
+    frame_size = (frame_size_arg + offset_alignment - 1) / offset_alignment * offset_alignment;
+    std::size_t ring_size = frame_size * CGUI_UNIFORM_RING_FRAMES;
+
+    // Dynamic storage allows frame capture to record written blocks as buffer updates
+    GLbitfield storage_flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT | GL_DYNAMIC_STORAGE_BIT;
+
+    glGenBuffers(1, &buffer_id);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer_id);
+    glBufferStorage(GL_UNIFORM_BUFFER, (GLsizeiptr)ring_size, nullptr, storage_flags);
+    mapped_data = static_cast<uint8_t*>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, (GLsizeiptr)ring_size, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT));
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    if (mapped_data == nullptr)
+    {
+        debug_handler.post_log("Unable to map uniform ring.", DEBUG_MODE_ERROR);
+        return;
+    }
+
+    main_memory_tracker.register_object(CGUI_MEMORY_BUFFER, buffer_id, ring_size, GL_DYNAMIC_DRAW, "CGUIUniformRing");
+    CGUI_POST_FORMAT(debug_handler, DEBUG_MODE_LOG, "Uniform ring has been created, frame size: {}", frame_size);
+}
+
+/**
+ * @brief      Destroys uniform ring, buffer has to be deleted by destroy.
+ */
+CGUIUniformRing::~CGUIUniformRing()
+{
+}
+
+/**
+ * @brief      Starts writing the next part of the ring.
+ *
+ *             Waits for the frame, that has used it before, which only happens,
+ *             when GPU is CGUI_UNIFORM_RING_FRAMES frames behind.
+ */
+void CGUIUniformRing::begin_frame()
+{
+    frame_slot = (frame_slot + 1) % CGUI_UNIFORM_RING_FRAMES;
+    frame_offset = 0;
+    overflow_reported = false;
+
+    GLsync& frame_fence = frame_fences[frame_slot];
+    if (frame_fence == nullptr)
+    {
+        return;
+    }
+
+    GLenum wait_status = GL_TIMEOUT_EXPIRED;
+    while (wait_status == GL_TIMEOUT_EXPIRED)
+    {
+        wait_status = glClientWaitSync(frame_fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+    }
+
+    if (wait_status == GL_WAIT_FAILED)
+    {
+        debug_handler.post_log("Unable to wait for uniform ring frame.", DEBUG_MODE_ERROR);
+    }
+
+    glDeleteSync(frame_fence);
+    frame_fence = nullptr;
+}
+
+/**
+ * @brief      Ends writing the part of the ring, has to be called after frame was submitted.
+ */
+void CGUIUniformRing::end_frame()
+{
+    if (frame_fences[frame_slot] != nullptr)
+    {
+        glDeleteSync(frame_fences[frame_slot]);
+    }
+
+    frame_fences[frame_slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/**
+ * @brief      Allocates block in the part of the current frame.
+ *
+ * @param[in]  size  Size of the block.
+ *
+ * @return     Allocated block, its data is nullptr if the part is full.
+ */
+CGUIUniformAllocation CGUIUniformRing::allocate(std::size_t size)
+{
+    CGUIUniformAllocation allocation;
+
+    std::size_t aligned_size = (size + offset_alignment - 1) / offset_alignment * offset_alignment;
+    if (mapped_data == nullptr || frame_offset + aligned_size > frame_size)
+    {
+        if (!overflow_reported)
+        {
+            overflow_reported = true;
+            debug_handler.post_log(std::string("Uniform ring is full, frame size: ") + std::to_string(frame_size), DEBUG_MODE_WARNING);
+        }
+        return allocation;
+    }
+
+    allocation.offset = (GLintptr)(frame_slot * frame_size + frame_offset);
+    allocation.size = (GLsizeiptr)size;
+    allocation.data = mapped_data + allocation.offset;
+
+    frame_offset += aligned_size;
+    return allocation;
+}
+
+/**
+ * @brief      Binds written block to uniform block binding.
+ *
+ * @param[in]  binding     Binding of the block.
+ * @param[in]  allocation  Allocated block, its data has to be written already.
+ */
+void CGUIUniformRing::bind(GLuint binding, const CGUIUniformAllocation& allocation)
+{
+    if (allocation.data == nullptr)
+    {
+        return;
+    }
+
+    glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer_id, allocation.offset, allocation.size);
+
+    // Writes through mapping are invisible to capture, so block is recorded as an update
+    if (main_frame_capture.is_capturing())
+    {
+        glBufferSubData(GL_UNIFORM_BUFFER, allocation.offset, allocation.size, allocation.data);
+    }
+}
+
+/**
+ * @brief      Deletes ring buffer and fences.
+ */
+void CGUIUniformRing::destroy()
+{
+    for (GLsync& frame_fence : frame_fences)
+    {
+        if (frame_fence != nullptr)
+        {
+            glDeleteSync(frame_fence);
+            frame_fence = nullptr;
+        }
+    }
+
+    if (buffer_id != 0)
+    {
+        main_memory_tracker.unregister_object(CGUI_MEMORY_BUFFER, buffer_id);
+
+        glBindBuffer(GL_UNIFORM_BUFFER, buffer_id);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        glDeleteBuffers(1, &buffer_id);
+    }
+
+    buffer_id = 0;
+    mapped_data = nullptr;
+}
+
+/**
+ * @brief      Gets amount of bytes, that were allocated in the current frame.
+ *
+ * @return     Used part of the frame.
+ */
+std::size_t CGUIUniformRing::get_frame_usage()
+{
+    return frame_offset;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file       <CGUIUniformRing.hpp>
+ * @brief      This header file implements CGUIUniformRing class.
+ *
+ *             It is being used in order to pass per draw uniforms to shaders
+ *             through uniform buffer, that is written by CPU without any GL calls.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUIUNIFORMRING_HPP
+#define CGUIUNIFORMRING_HPP
+
+/**
+ * Include GLFW and GLAD for window handling.
+ */
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+
+#include "../../memory_tracker/CGUIMemoryTracker.hpp"
+#include "../../frame_capture/CGUIFrameCapture.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/**
+ * Amount of frames, that can be in flight, every frame owns its own part of the ring.
+ */
+#define CGUI_UNIFORM_RING_FRAMES 3
+
+/**
+ * Uniform block bindings, must match binding of blocks in shaders.
+ */
+#define CGUI_UNIFORM_BINDING_LINE   1
+#define CGUI_UNIFORM_BINDING_LAYER  2
+
+/**
+ * Part of the ring, that holds one uniform block.
+ */
+struct CGUIUniformAllocation
+{
+    uint8_t*    data    = nullptr;
+    GLintptr    offset  = 0;
+    GLsizeiptr  size    = 0;
+};
+
+/**
+ * @brief      This class implements per frame ring of std140 uniform blocks.
+ *
+ *             Buffer is mapped persistently once, every frame writes into its own part,
+ *             so allocation is a pointer bump and block is bound with glBindBufferRange.
+ *             Part of the frame is reused only after fence of that frame has signalled.
+ *             Structures, that are pushed, have to follow std140 layout of their blocks.
+ */
+class CGUIUniformRing
+{
+public:
+    CGUIUniformRing(std::size_t frame_size_arg = 256 * 1024);
+    CGUIUniformRing(const CGUIUniformRing&) = delete;
+    ~CGUIUniformRing();
+
+    void begin_frame();
+    void end_frame();
+
+    CGUIUniformAllocation allocate(std::size_t size);
+    void bind(GLuint binding, const CGUIUniformAllocation& allocation);
+
+    /**
+     * @brief      Copies block into the ring and binds it.
+     *
+     * @param[in]  binding  Binding of the block.
+     * @param[in]  block    Block with std140 layout.
+     *
+     * @return     False if frame part of the ring is full.
+     */
+    template<typename Block>
+    bool push(GLuint binding, const Block& block)
+    {
+        CGUIUniformAllocation allocation = allocate(sizeof(Block));
+        if (allocation.data == nullptr)
+        {
+            return false;
+        }
+
+        std::memcpy(allocation.data, &block, sizeof(Block));
+        bind(binding, allocation);
+        return true;
+    }
+
+    void destroy();
+
+    std::size_t get_frame_usage();
+
+private:
+    GLuint      buffer_id       = 0;
+    uint8_t*    mapped_data     = nullptr;
+
+    std::size_t frame_size;
+    std::size_t offset_alignment    = 256;
+
+    std::size_t frame_slot          = 0;
+    std::size_t frame_offset        = 0;
+    bool        overflow_reported   = false;
+
+    GLsync      frame_fences[CGUI_UNIFORM_RING_FRAMES] = {};
+
+    CGUIDebugHandler debug_handler = CGUIDebugHandler(false);
+};
+
+#endif // CGUIUNIFORMRING_HPP
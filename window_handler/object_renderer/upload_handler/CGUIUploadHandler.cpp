@@ -0,0 +1,511 @@
+/**
+ * @file       <CGUIUploadHandler.cpp>
+ * @brief      This source file implements CGUIUploader class.
+ *
+ *             It is being used in order to stream buffer and texture data
+ *             to GPU from background thread with shared GL context.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUIUploadHandler.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+/**
+ * Timeout of a single fence wait in nanoseconds.
+ */
+#define CGUI_UPLOAD_WAIT_TIMEOUT 1000000
+
+/**
+ * Total time in nanoseconds, after which waited upload is considered failed.
+ */
+#define CGUI_UPLOAD_FENCE_TIMEOUT 5000000000ULL
+
+/**
+ * @brief      Constructs a new uploader and starts its thread.
+ *
+ * @param      shared_window     Hidden window, created with main window as share parameter.
+ * @param[in]  staging_size_arg  Size of every staging buffer in bytes.
+ */
+CGUIUploader::CGUIUploader(GLFWwindow* shared_window, std::size_t staging_size_arg)
+{
+    debug_handler = CGUIDebugHandler(main_debug_handler);
+
+    upload_window = shared_window;
+    staging_size = std::max<std::size_t>(staging_size_arg, 64 * 1024);
+
+    if (upload_window == NULL)
+    {
+        debug_handler.post_log("Unable to start uploader, shared window is not created.", DEBUG_MODE_ERROR);
+        is_stopped = true;
+        return;
+    }
+
+    worker = std::thread(&CGUIUploader::upload_thread, this);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, "New instance of uploader created.");
+}
+
+/**
+ * @brief      Destroys uploader.
+ */
+CGUIUploader::~CGUIUploader()
+{
+    stop();
+}
+
+/**
+ * @brief      Queues buffer upload, buffer storage is reallocated with given size.
+ *
+ * @param[in]  target     Buffer target, e.g. GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER.
+ * @param[in]  buffer_id  Buffer, generated in any context of the share group.
+ * @param[in]  data       Data to upload, it is kept alive and unchanged until upload is submitted.
+ * @param[in]  size       Size of data in bytes.
+ * @param[in]  usage      Buffer usage hint.
+ *
+ * @return     Ticket of the upload.
+ */
+CGUIUploadTicket CGUIUploader::upload_buffer(GLenum target, GLuint buffer_id, std::shared_ptr<const void> data, std::size_t size, GLenum usage)
+{
+    CGUIUploadJob job;
+
+    job.target = target;
+    job.object_id = buffer_id;
+    job.usage = usage;
+    job.data = std::move(data);
+    job.data_size = size;
+
+    return push_job(std::move(job));
+}
+
+/**
+ * @brief      Queues 2D texture upload, texture storage is reallocated with given size.
+ *
+ * @param[in]  texture_id       Texture, generated in any context of the share group.
+ * @param[in]  size             Size of the texture in pixels.
+ * @param[in]  internal_format  Internal format of the texture.
+ * @param[in]  format           Format of pixel data.
+ * @param[in]  type             Type of pixel data.
+ * @param[in]  data             Tightly packed rows, they are kept alive and unchanged until upload is submitted.
+ * @param[in]  data_size        Size of data in bytes.
+ *
+ * @return     Ticket of the upload.
+ */
+CGUIUploadTicket CGUIUploader::upload_texture(GLuint texture_id, glm::ivec2 size, GLint internal_format, GLenum format, GLenum type, std::shared_ptr<const void> data, std::size_t data_size)
+{
+    CGUIUploadJob job;
+
+    job.target = GL_TEXTURE_2D;
+    job.object_id = texture_id;
+    job.size = size;
+    job.internal_format = internal_format;
+    job.format = format;
+    job.type = type;
+    job.data = std::move(data);
+    job.data_size = data_size;
+
+    return push_job(std::move(job));
+}
+
+/**
+ * @brief      Checks if upload is finished by GPU, never blocks.
+ *
+ *             Has to be called from thread with context of the same share group.
+ *
+ * @param[in]  ticket  Ticket of the upload.
+ *
+ * @return     True if upload is finished or failed, False otherwise, is_failed tells them apart.
+ */
+bool CGUIUploader::is_complete(const CGUIUploadTicket& ticket)
+{
+    if (ticket == nullptr || ticket->complete == true)
+    {
+        return true;
+    }
+
+    if (ticket->submitted.load() == false)
+    {
+        return false;
+    }
+
+    GLsync fence = ticket->fence.load();
+    if (fence != nullptr)
+    {
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status == GL_WAIT_FAILED)
+        {
+            debug_handler.post_log("Unable to wait for upload fence.", DEBUG_MODE_ERROR);
+            fail_ticket(ticket);
+            return true;
+        }
+
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+        {
+            return false;
+        }
+
+        glDeleteSync(fence);
+        ticket->fence.store(nullptr);
+    }
+
+    ticket->complete = true;
+    return true;
+}
+
+/**
+ * @brief      Checks if upload has failed, object of such upload must never be drawn.
+ *
+ * @param[in]  ticket  Ticket of the upload.
+ *
+ * @return     True if upload has failed, False if it is finished or still running.
+ */
+bool CGUIUploader::is_failed(const CGUIUploadTicket& ticket)
+{
+    return ticket != nullptr && ticket->failed.load();
+}
+
+/**
+ * @brief      Blocks until upload is finished by GPU or fence timeout has passed.
+ *
+ * @param[in]  ticket  Ticket of the upload.
+ */
+void CGUIUploader::wait(const CGUIUploadTicket& ticket)
+{
+    if (ticket == nullptr)
+    {
+        return;
+    }
+
+    {
+        std::unique_lock job_lock(job_mutex);
+        done_con_v.wait(job_lock, [&ticket]{ return ticket->submitted.load(); });
+    }
+
+    uint64_t waited_time = 0;
+    while (is_complete(ticket) == false)
+    {
+        if (waited_time >= CGUI_UPLOAD_FENCE_TIMEOUT)
+        {
+            debug_handler.post_log("Upload fence has timed out.", DEBUG_MODE_ERROR);
+            fail_ticket(ticket);
+            return;
+        }
+
+        glClientWaitSync(ticket->fence.load(), 0, CGUI_UPLOAD_WAIT_TIMEOUT);
+        waited_time += CGUI_UPLOAD_WAIT_TIMEOUT;
+    }
+}
+
+/**
+ * @brief      Stops uploader thread, jobs, that were not started yet, are marked as failed.
+ */
+void CGUIUploader::stop()
+{
+    {
+        std::lock_guard job_lock(job_mutex);
+        if (is_stopped == true && worker.joinable() == false)
+        {
+            return;
+        }
+        is_stopped = true;
+    }
+    job_con_v.notify_all();
+
+    if (worker.joinable() == true)
+    {
+        worker.join();
+    }
+
+    std::lock_guard job_lock(job_mutex);
+    for (CGUIUploadJob& job : jobs)
+    {
+        job.ticket->failed.store(true);
+        job.ticket->submitted.store(true);
+    }
+    jobs.clear();
+    done_con_v.notify_all();
+}
+
+/**
+ * @brief      Gets amount of jobs, that were not started yet.
+ *
+ * @return     Amount of queued jobs.
+ */
+std::size_t CGUIUploader::get_pending_count()
+{
+    std::lock_guard job_lock(job_mutex);
+    return jobs.size();
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Queues job and wakes uploader thread.
+ *
+ * @param      job   Job to queue.
+ *
+ * @return     Ticket of the job.
+ */
+CGUIUploadTicket CGUIUploader::push_job(CGUIUploadJob&& job)
+{
+    job.ticket = std::make_shared<CGUIUploadState>();
+    CGUIUploadTicket ticket = job.ticket;
+
+    {
+        std::lock_guard job_lock(job_mutex);
+        if (is_stopped == true)
+        {
+            debug_handler.post_log("Upload was requested from stopped uploader.", DEBUG_MODE_ERROR);
+            ticket->failed.store(true);
+            ticket->submitted.store(true);
+            return ticket;
+        }
+        jobs.push_back(std::move(job));
+    }
+    job_con_v.notify_one();
+
+    return ticket;
+}
+
+/**
+ * @brief      Marks submitted upload as failed and releases its fence.
+ *
+ *             Has to be called from thread with context of the same share group.
+ *
+ * @param[in]  ticket  Ticket of the upload.
+ */
+void CGUIUploader::fail_ticket(const CGUIUploadTicket& ticket)
+{
+    GLsync fence = ticket->fence.exchange(nullptr);
+    if (fence != nullptr)
+    {
+        glDeleteSync(fence);
+    }
+
+    ticket->failed.store(true);
+    ticket->complete = true;
+}
+
+/**
+ * @brief      Uploader thread, it owns shared context while running.
+ */
+void CGUIUploader::upload_thread()
+{
+    glfwMakeContextCurrent(upload_window);
+
+    // Rows of staged pixels are tightly packed
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    for (CGUIStagingBuffer& staging : staging_buffers)
+    {
+        glGenBuffers(1, &staging.buffer_id);
+        glBindBuffer(GL_COPY_READ_BUFFER, staging.buffer_id);
+        glBufferData(GL_COPY_READ_BUFFER, staging_size, NULL, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    while (true)
+    {
+        CGUIUploadJob job;
+        {
+            std::unique_lock job_lock(job_mutex);
+            job_con_v.wait(job_lock, [this]{ return is_stopped || !jobs.empty(); });
+
+            if (is_stopped == true)
+            {
+                break;
+            }
+
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        // Errors of previous jobs must not be reported for this one
+        while (glGetError() != GL_NO_ERROR)
+        {
+        }
+
+        if (job.target == GL_TEXTURE_2D)
+        {
+            process_texture(job);
+        }
+        else
+        {
+            process_buffer(job);
+        }
+
+        if (glGetError() != GL_NO_ERROR)
+        {
+            debug_handler.post_log("Upload has failed with GL error.", DEBUG_MODE_ERROR);
+            job.ticket->failed.store(true);
+        }
+
+        // Caller's data is released as soon as it is staged
+        job.data.reset();
+
+        // Flush is required, otherwise fence might never reach GPU from idle context
+        if (job.ticket->failed.load() == false)
+        {
+            job.ticket->fence.store(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        }
+        glFlush();
+
+        {
+            std::lock_guard job_lock(job_mutex);
+            job.ticket->submitted.store(true);
+        }
+        done_con_v.notify_all();
+    }
+
+    for (CGUIStagingBuffer& staging : staging_buffers)
+    {
+        if (staging.fence != nullptr)
+        {
+            glDeleteSync(staging.fence);
+            staging.fence = nullptr;
+        }
+        glDeleteBuffers(1, &staging.buffer_id);
+        staging.buffer_id = 0;
+    }
+    glFinish();
+
+    glfwMakeContextCurrent(NULL);
+}
+
+/**
+ * @brief      Copies buffer data through staging buffers.
+ *
+ * @param      job   Buffer job.
+ */
+void CGUIUploader::process_buffer(CGUIUploadJob& job)
+{
+    glBindBuffer(GL_COPY_WRITE_BUFFER, job.object_id);
+    glBufferData(GL_COPY_WRITE_BUFFER, job.data_size, NULL, job.usage);
+
+    const uint8_t* job_data = static_cast<const uint8_t*>(job.data.get());
+
+    for (std::size_t offset = 0; offset < job.data_size; offset += staging_size)
+    {
+        std::size_t chunk_size = std::min(staging_size, job.data_size - offset);
+        CGUIStagingBuffer& staging = acquire_staging();
+
+        glBindBuffer(GL_COPY_READ_BUFFER, staging.buffer_id);
+        void* mapped_data = glMapBufferRange(GL_COPY_READ_BUFFER, 0, chunk_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (mapped_data == NULL)
+        {
+            debug_handler.post_log("Unable to map staging buffer.", DEBUG_MODE_ERROR);
+            job.ticket->failed.store(true);
+            break;
+        }
+
+        std::memcpy(mapped_data, job_data + offset, chunk_size);
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, offset, chunk_size);
+        staging.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+/**
+ * @brief      Copies texture rows through staging buffers, bound as PBO.
+ *
+ * @param      job   Texture job.
+ */
+void CGUIUploader::process_texture(CGUIUploadJob& job)
+{
+    if (job.size.x <= 0 || job.size.y <= 0)
+    {
+        debug_handler.post_log("Texture upload has invalid size.", DEBUG_MODE_ERROR);
+        job.ticket->failed.store(true);
+        return;
+    }
+
+    std::size_t row_size = job.data_size / job.size.y;
+    const uint8_t* job_data = static_cast<const uint8_t*>(job.data.get());
+
+    glBindTexture(GL_TEXTURE_2D, job.object_id);
+    glTexImage2D(GL_TEXTURE_2D, 0, job.internal_format, job.size.x, job.size.y, 0, job.format, job.type, NULL);
+
+    if (row_size == 0)
+    {
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return;
+    }
+
+    // Row, that does not fit staging buffer, is uploaded from client memory
+    if (row_size > staging_size)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, job.size.x, job.size.y, job.format, job.type, job_data);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return;
+    }
+
+    GLint rows_per_chunk = (GLint)(staging_size / row_size);
+
+    for (GLint row = 0; row < job.size.y; row += rows_per_chunk)
+    {
+        GLint chunk_rows = std::min(rows_per_chunk, job.size.y - row);
+        std::size_t chunk_size = chunk_rows * row_size;
+        CGUIStagingBuffer& staging = acquire_staging();
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.buffer_id);
+        void* mapped_data = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, chunk_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (mapped_data == NULL)
+        {
+            debug_handler.post_log("Unable to map pixel unpack buffer.", DEBUG_MODE_ERROR);
+            job.ticket->failed.store(true);
+            break;
+        }
+
+        std::memcpy(mapped_data, job_data + row * row_size, chunk_size);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, row, job.size.x, chunk_rows, job.format, job.type, (void*)0);
+        staging.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ * @brief      Takes next staging buffer, waiting until GPU stops reading it.
+ *
+ * @return     Staging buffer, that can be mapped unsynchronized.
+ */
+CGUIStagingBuffer& CGUIUploader::acquire_staging()
+{
+    CGUIStagingBuffer& staging = staging_buffers[staging_index];
+    staging_index = (staging_index + 1) % CGUI_UPLOAD_STAGING_COUNT;
+
+    if (staging.fence != nullptr)
+    {
+        while (glClientWaitSync(staging.fence, GL_SYNC_FLUSH_COMMANDS_BIT, CGUI_UPLOAD_WAIT_TIMEOUT) == GL_TIMEOUT_EXPIRED)
+        {
+        }
+        glDeleteSync(staging.fence);
+        staging.fence = nullptr;
+    }
+
+    return staging;
+}
@@ -0,0 +1,206 @@
+/**
+ * @file       <CGUIUploadHandler.hpp>
+ * @brief      This header file implements CGUIUploader class.
+ *
+ *             It is being used in order to stream buffer and texture data
+ *             to GPU from background thread with shared GL context.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUIUPLOADHANDLER_HPP
+#define CGUIUPLOADHANDLER_HPP
+
+/**
+ * Include GLFW and GLAD for window handling.
+ */
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+
+#include "../../debug_handler/CGUIDebugHandler.hpp"
+
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Amount of staging buffers, uploader cycles through them, so CPU copy
+ * into the next one overlaps with GPU copy from the previous one.
+ */
+#define CGUI_UPLOAD_STAGING_COUNT 2
+
+/**
+ * State of one upload, shared between uploader thread and its caller.
+ */
+struct CGUIUploadState
+{
+    std::atomic<GLsync> fence       = nullptr;
+    std::atomic<bool>   submitted   = false;
+    std::atomic<bool>   failed      = false;
+    bool                complete    = false;
+};
+
+using CGUIUploadTicket = std::shared_ptr<CGUIUploadState>;
+
+/**
+ * Upload job, data is shared with the caller, it is never copied before staging.
+ */
+struct CGUIUploadJob
+{
+    GLenum                  target          = GL_ARRAY_BUFFER;
+    GLuint                  object_id       = 0;
+    GLenum                  usage           = GL_STATIC_DRAW;
+
+    // Texture only parameters
+    glm::ivec2              size            = {0, 0};
+    GLint                   internal_format = GL_RGBA8;
+    GLenum                  format          = GL_RGBA;
+    GLenum                  type            = GL_UNSIGNED_BYTE;
+
+    std::shared_ptr<const void> data;
+    std::size_t                 data_size   = 0;
+    CGUIUploadTicket            ticket;
+};
+
+/**
+ * Staging buffer, that is reused as PBO for textures.
+ */
+struct CGUIStagingBuffer
+{
+    GLuint  buffer_id   = 0;
+    GLsync  fence       = nullptr;
+};
+
+/**
+ * @brief      This class implements background uploader.
+ *
+ *             Uploader owns hidden window, whose context shares objects with the main one.
+ *             Jobs are copied into staging buffers and then into destination objects by GPU,
+ *             after every job fence is inserted and flushed, so render thread can check it
+ *             without waiting. Destination object has to be rebound after upload is complete,
+ *             otherwise render context might not see its new contents.
+ */
+class CGUIUploader
+{
+public:
+    CGUIUploader(GLFWwindow* shared_window, std::size_t staging_size_arg = 4 * 1024 * 1024);
+    CGUIUploader(const CGUIUploader&) = delete;
+    ~CGUIUploader();
+
+    CGUIUploadTicket upload_buffer(GLenum target, GLuint buffer_id, std::shared_ptr<const void> data, std::size_t size, GLenum usage);
+    CGUIUploadTicket upload_texture(GLuint texture_id, glm::ivec2 size, GLint internal_format, GLenum format, GLenum type, std::shared_ptr<const void> data, std::size_t data_size);
+
+    /**
+     * @brief      Queues buffer upload, that takes ownership of the vector.
+     *
+     * @param[in]  target     Buffer target, e.g. GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER.
+     * @param[in]  buffer_id  Buffer, generated in any context of the share group.
+     * @param[in]  data       Data to upload, it is moved without copying.
+     * @param[in]  usage      Buffer usage hint.
+     *
+     * @tparam     T          Trivially copyable type.
+     *
+     * @return     Ticket of the upload.
+     */
+    template<typename T>
+        CGUIUploadTicket upload_buffer(GLenum target, GLuint buffer_id, std::vector<T>&& data, GLenum usage)
+        {
+            std::size_t size = data.size() * sizeof(T);
+            return upload_buffer(target, buffer_id, share_data(std::move(data)), size, usage);
+        }
+
+    /**
+     * @brief      Queues 2D texture upload, that takes ownership of the vector.
+     *
+     * @param[in]  texture_id       Texture, generated in any context of the share group.
+     * @param[in]  size             Size of the texture in pixels.
+     * @param[in]  internal_format  Internal format of the texture.
+     * @param[in]  format           Format of pixel data.
+     * @param[in]  type             Type of pixel data.
+     * @param[in]  data             Tightly packed rows, they are moved without copying.
+     *
+     * @tparam     T                Trivially copyable type.
+     *
+     * @return     Ticket of the upload.
+     */
+    template<typename T>
+        CGUIUploadTicket upload_texture(GLuint texture_id, glm::ivec2 size, GLint internal_format, GLenum format, GLenum type, std::vector<T>&& data)
+        {
+            std::size_t data_size = data.size() * sizeof(T);
+            return upload_texture(texture_id, size, internal_format, format, type, share_data(std::move(data)), data_size);
+        }
+
+    bool is_complete(const CGUIUploadTicket& ticket);
+    bool is_failed(const CGUIUploadTicket& ticket);
+    void wait(const CGUIUploadTicket& ticket);
+
+    void stop();
+
+    std::size_t get_pending_count();
+
+private:
+    /**
+     * @brief      Moves vector into shared buffer, that points at its data.
+     *
+     * @param[in]  data  Vector to move.
+     *
+     * @tparam     T     Trivially copyable type.
+     *
+     * @return     Pointer to data, that keeps the vector alive.
+     */
+    template<typename T>
+        static std::shared_ptr<const void> share_data(std::vector<T>&& data)
+        {
+            std::shared_ptr<std::vector<T>> data_owner = std::make_shared<std::vector<T>>(std::move(data));
+            return std::shared_ptr<const void>(data_owner, data_owner->data());
+        }
+
+    CGUIUploadTicket push_job(CGUIUploadJob&& job);
+    void fail_ticket(const CGUIUploadTicket& ticket);
+
+    void upload_thread();
+    void process_buffer(CGUIUploadJob& job);
+    void process_texture(CGUIUploadJob& job);
+
+    CGUIStagingBuffer& acquire_staging();
+
+private:
+    GLFWwindow*     upload_window;
+    std::size_t     staging_size;
+
+    CGUIStagingBuffer   staging_buffers[CGUI_UPLOAD_STAGING_COUNT];
+    std::size_t         staging_index = 0;
+
+    std::deque<CGUIUploadJob>   jobs;
+    std::mutex                  job_mutex;
+    std::condition_variable     job_con_v;
+    std::condition_variable     done_con_v;
+
+    std::thread     worker;
+    bool            is_stopped = false;
+
+    CGUIDebugHandler debug_handler = CGUIDebugHandler(false);
+};
+
+#endif // CGUIUPLOADHANDLER_HPP
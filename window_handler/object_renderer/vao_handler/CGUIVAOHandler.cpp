@@ -24,11 +24,20 @@
  */
 #include "CGUIVAOHandler.hpp"
 
-CGUIVAO::CGUIVAO(bool is_buffer_static)
+CGUIVAO::CGUIVAO(bool is_buffer_static, const std::string& owner)
 {
     buffer_static = is_buffer_static;
 
     glGenVertexArrays(1, &buffer_id);
+
+    // Vertex array has no storage of its own, so only amount of them is tracked
+    main_memory_tracker.register_object(CGUI_MEMORY_VERTEX_ARRAY, buffer_id, 0, GL_NONE, owner);
+}
+
+// Destroys the VAO, queueing it for deletion
+CGUIVAO::~CGUIVAO()
+{
+    destroy();
 }
 
 // Binds the VAO
@@ -43,10 +52,17 @@ void CGUIVAO::unbind()
     glBindVertexArray(0);
 }
 
-// Deletes the VAO
+// Queues the VAO for deletion, can be called from any thread
 void CGUIVAO::destroy()
 {
-    glDeleteVertexArrays(1, &buffer_id);
+    if (buffer_id == 0)
+    {
+        return;
+    }
+
+    // Object is deleted by render thread, once GPU has finished frames, that might use it
+    main_deletion_queue.push(CGUI_MEMORY_VERTEX_ARRAY, buffer_id);
+    buffer_id = 0;
 }
 
 void CGUIVAO::link_attributes(CGUIVBO& VBO, GLuint layout, GLuint components_number, GLenum type, GLsizeiptr byte_offset, void* offset)
@@ -31,11 +31,14 @@
 #include <glad/gl.h>
 #include <GLFW/glfw3.h>
 #include "../vbo_handler/CGUIVBOHandler.hpp"
+#include "../../memory_tracker/CGUIMemoryTracker.hpp"
+#include "../deletion_queue/CGUIDeletionQueue.hpp"
 
 class CGUIVAO
 {
 public:
-    CGUIVAO(bool is_buffer_static = false);
+    CGUIVAO(bool is_buffer_static = false, const std::string& owner = "CGUIVAO");
+    CGUIVAO(const CGUIVAO&) = delete;
     ~CGUIVAO();
 
     void bind();
@@ -48,7 +51,7 @@ public:
 
 private:
     bool    buffer_static;
-    GLuint  buffer_id;
+    GLuint  buffer_id = 0;
 };
 
 #endif // CGUIVAOHANDLER_HPP
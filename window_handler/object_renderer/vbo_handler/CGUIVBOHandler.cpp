@@ -29,14 +29,48 @@
  *
  * @param      vertices          Vertecies vector
  * @param[in]  is_buffer_static  Indicates if buffer is static
+ * @param[in]  owner             Owner tag for memory tracker
  */
-CGUIVBO::CGUIVBO(std::vector<CGUIVertex>& vertices, bool is_buffer_static)
+CGUIVBO::CGUIVBO(std::vector<CGUIVertex>& vertices, bool is_buffer_static, const std::string& owner)
 {
     buffer_static = is_buffer_static;
     
     glGenBuffers(1, &buffer_id);
     glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(CGUIVertex), vertices.data(), (buffer_static == true) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
+
+    main_memory_tracker.register_object(CGUI_MEMORY_BUFFER, buffer_id, vertices.size() * sizeof(CGUIVertex), (buffer_static == true) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW, owner);
+}
+
+/**
+ * @brief      Constructs a new VBO, which data is uploaded by background uploader.
+ *
+ *             VBO should not be drawn until is_uploaded returns true.
+ *
+ * @param      uploader          Background uploader.
+ * @param      vertices          Vertecies vector, it is moved into uploader
+ * @param[in]  is_buffer_static  Indicates if buffer is static
+ * @param[in]  owner             Owner tag for memory tracker
+ */
+CGUIVBO::CGUIVBO(CGUIUploader& uploader, std::vector<CGUIVertex>&& vertices, bool is_buffer_static, const std::string& owner)
+{
+    buffer_static = is_buffer_static;
+    buffer_uploader = &uploader;
+
+    std::size_t buffer_size = vertices.size() * sizeof(CGUIVertex);
+
+    glGenBuffers(1, &buffer_id);
+    upload_ticket = uploader.upload_buffer(GL_ARRAY_BUFFER, buffer_id, std::move(vertices), (buffer_static == true) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
+
+    main_memory_tracker.register_object(CGUI_MEMORY_BUFFER, buffer_id, buffer_size, (buffer_static == true) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW, owner);
+}
+
+/**
+ * @brief      Destroys VBO, queueing its buffer for deletion.
+ */
+CGUIVBO::~CGUIVBO()
+{
+    destroy();
 }
 
 /**
@@ -44,6 +78,12 @@ CGUIVBO::CGUIVBO(std::vector<CGUIVertex>& vertices, bool is_buffer_static)
  */
 void CGUIVBO::bind()
 {
+    // Buffer of failed upload has undefined contents
+    if (buffer_uploader != nullptr && buffer_uploader->is_failed(upload_ticket))
+    {
+        return;
+    }
+
     glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
 }
 
@@ -56,11 +96,18 @@ void CGUIVBO::unbind()
 }
 
 /**
- * @brief      Deletes VBO.
+ * @brief      Queues VBO for deletion, can be called from any thread.
  */
 void CGUIVBO::destroy()
 {
-    glDeleteBuffers(1, &buffer_id);
+    if (buffer_id == 0)
+    {
+        return;
+    }
+
+    // Object is deleted by render thread, once GPU has finished frames, that might use it
+    main_deletion_queue.push(CGUI_MEMORY_BUFFER, buffer_id);
+    buffer_id = 0;
 }
 
 /**
@@ -71,4 +118,18 @@ void CGUIVBO::destroy()
 bool CGUIVBO::is_static()
 {
     return buffer_static;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief      Determines if VBO data is uploaded.
+ *
+ * @return     True if data is ready to be drawn, False if it is not uploaded yet or upload has failed.
+ */
+bool CGUIVBO::is_uploaded()
+{
+    if (buffer_uploader == nullptr)
+    {
+        return true;
+    }
+    return buffer_uploader->is_complete(upload_ticket) && !buffer_uploader->is_failed(upload_ticket);
+}
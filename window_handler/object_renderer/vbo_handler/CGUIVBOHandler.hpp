@@ -32,6 +32,10 @@
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 
+#include "../upload_handler/CGUIUploadHandler.hpp"
+#include "../../memory_tracker/CGUIMemoryTracker.hpp"
+#include "../deletion_queue/CGUIDeletionQueue.hpp"
+
 #include <vector>
 
 
@@ -58,7 +62,8 @@ struct CGUIObject
 class CGUIVBO
 {
 public:
-    CGUIVBO(std::vector<CGUIVertex>& vertices, bool is_buffer_static = false);
+    CGUIVBO(std::vector<CGUIVertex>& vertices, bool is_buffer_static = false, const std::string& owner = "CGUIVBO");
+    CGUIVBO(CGUIUploader& uploader, std::vector<CGUIVertex>&& vertices, bool is_buffer_static = false, const std::string& owner = "CGUIVBO");
     CGUIVBO(const CGUIVBO&) = delete;
     ~CGUIVBO();
 
@@ -67,10 +72,14 @@ public:
     void destroy();
 
     bool is_static();
+    bool is_uploaded();
 
 private:
     bool    buffer_static;
-    GLuint  buffer_id;
+    GLuint  buffer_id = 0;
+
+    CGUIUploader*       buffer_uploader = nullptr;
+    CGUIUploadTicket    upload_ticket;
 };
 
 #endif // CGUIVBOHANDLER_HPP
@@ -24,6 +24,8 @@
  */
 #include "CGUIShaderCompiler.hpp"
 #include <filesystem>
+#include <string_view>
+#include <algorithm>
 
 /**
  * @brief      Constructs a new instance of shader compiler.
@@ -31,7 +33,7 @@
 CGUIShaderCompiler::CGUIShaderCompiler()
 {
     debug_handler = CGUIDebugHandler(main_debug_handler);
-    debug_handler.post_log("New instance of shader compile created.", DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, "New instance of shader compile created.");
 }
 
 /**
@@ -45,7 +47,7 @@ CGUIShaderCompiler::CGUIShaderCompiler()
 CGUIShaderCompiler::CGUIShaderCompiler(const std::string& shader_name, fs::path vertext_file_path, fs::path fragment_file_path, fs::path geometry_file_path)
 {
     debug_handler = CGUIDebugHandler(main_debug_handler);
-    debug_handler.post_log("New instance of shader compile created.", DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, "New instance of shader compile created.");
 
     add_shader(shader_name, vertext_file_path, fragment_file_path, geometry_file_path);    
 }
@@ -61,7 +63,7 @@ CGUIShaderCompiler::CGUIShaderCompiler(const std::string& shader_name, fs::path
 CGUIShaderCompiler::CGUIShaderCompiler(const std::string& shader_name, const std::string& vertex_shader, const std::string& fragment_shader, const std::string& geometry_shader)
 {
     debug_handler = CGUIDebugHandler(main_debug_handler);
-    debug_handler.post_log("Shader initialization has started.", DEBUG_MODE_LOG);
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, "Shader initialization has started.");
 
     add_shader(shader_name, vertex_shader, fragment_shader, geometry_shader);
 }
@@ -78,7 +80,7 @@ CGUIShaderCompiler::CGUIShaderCompiler(const std::string& shader_name, const std
     CGUIShaderCompiler::CGUIShaderCompiler(const std::string& shader_name, unsigned int vertex_shader_rsid, unsigned int fragment_shader_rsid, unsigned int geometry_shader_rsid)
     {
         debug_handler = CGUIDebugHandler(main_debug_handler);
-        debug_handler.post_log("Shader initialization has started.", DEBUG_MODE_LOG);
+        CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, "Shader initialization has started.");
 
         add_shader(shader_name, vertex_shader_rsid, fragment_shader_rsid, geometry_shader_rsid);
     }
@@ -89,21 +91,111 @@ CGUIShaderCompiler::CGUIShaderCompiler(const std::string& shader_name, const std
  */
 CGUIShaderCompiler::~CGUIShaderCompiler()
 {
-    shader_list.clear();
+    shader_slots.clear();
+    free_slots.clear();
+    shader_names.clear();
+}
+
+/**
+ * @brief      Constructs an invalid shader handle.
+ */
+CGUIShaderFuture::CGUIShaderFuture()
+{
+}
+
+/**
+ * @brief      Constructs a handle of shader, that was added to compiler.
+ *
+ * @param      shader_compiler_arg  Compiler, that owns the shader.
+ * @param[in]  shader_handle_arg    Handle of the shader.
+ */
+CGUIShaderFuture::CGUIShaderFuture(CGUIShaderCompiler* shader_compiler_arg, CGUIShaderHandle shader_handle_arg)
+{
+    shader_compiler = shader_compiler_arg;
+    shader_handle = shader_handle_arg;
+}
+
+/**
+ * @brief      Checks whether handle refers to a shader.
+ *
+ * @return     False for handles of shaders, that were not submitted.
+ */
+bool CGUIShaderFuture::is_valid()
+{
+    return shader_compiler != nullptr;
+}
+
+/**
+ * @brief      Checks whether shader has finished compilation without waiting.
+ *
+ * @return     True if get would not block.
+ */
+bool CGUIShaderFuture::is_ready()
+{
+    return (shader_compiler == nullptr) || shader_compiler->is_shader_ready(shader_handle);
+}
+
+/**
+ * @brief      Gets program id, waits for compilation if needed.
+ *
+ * @return     Program id, 0 if shader has failed.
+ */
+GLuint CGUIShaderFuture::get()
+{
+    return (shader_compiler != nullptr) ? shader_compiler->get_shader_id(shader_handle) : 0;
+}
+
+/**
+ * @brief      Gets handle of the shader, it can be used before shader is ready.
+ *
+ * @return     Handle of the shader.
+ */
+CGUIShaderHandle CGUIShaderFuture::get_handle()
+{
+    return shader_handle;
 }
 
 
 /**
  * @brief      Compiles a new instance of shader program.
  *
+ *             Linked programs are cached on disk by hash of their sources and driver,
+ *             cache hit skips compilation and linking completely.
+ *
  * @param[in]  vertex_shader_rsid   The vertex shader source.
  * @param[in]  fragment_shader_rsid The fragment shader source.
  * @param[in]  geometry_shader_rsid The geometry shader source.
+ * @param      compile_stats        Telemetry of compilation, can be nullptr.
  */
-GLuint CGUIShaderCompiler::compile_shader(const std::string& vertex_shader, const std::string& fragment_shader, const std::string& geometry_shader)
+GLuint CGUIShaderCompiler::compile_shader(std::string_view vertex_shader, std::string_view fragment_shader, std::string_view geometry_shader, CGUIShaderStats* compile_stats)
 {
     int init_status = 0;
 
+    CGUIShaderStats local_stats;
+    CGUIShaderStats& stats = (compile_stats != nullptr) ? *compile_stats : local_stats;
+    stats.source_size = {vertex_shader.size(), fragment_shader.size(), (geometry_shader != "NONE") ? geometry_shader.size() : 0};
+
+    std::chrono::steady_clock::time_point stage_start = std::chrono::steady_clock::now();
+
+    uint64_t source_hash = 0;
+    if (is_binary_cache_supported())
+    {
+        source_hash = get_source_hash(vertex_shader, fragment_shader, geometry_shader);
+
+        GLuint cached_id = load_program_binary(source_hash);
+        if (cached_id != 0)
+        {
+            track_program_sources(cached_id, vertex_shader, fragment_shader, geometry_shader);
+
+            stats.from_cache = true;
+            stats.link_time = get_elapsed_time(stage_start);
+            stats.ready_time = stats.link_time;
+            return cached_id;
+        }
+    }
+
+    std::chrono::steady_clock::time_point compile_start = std::chrono::steady_clock::now();
+
     GLuint compiled_vertex;
     GLuint compiled_fragment;
     GLuint compiled_geometry;
@@ -114,33 +206,53 @@ GLuint CGUIShaderCompiler::compile_shader(const std::string& vertex_shader, cons
 
     GLuint id = glCreateProgram();
 
+    // Sources are passed with their lengths, so they do not have to be terminated
     compiled_vertex = glCreateShader(GL_VERTEX_SHADER);
-    const char *source_buffer = vertex_shader.c_str();
-    glad_glShaderSource(compiled_vertex, 1, (const GLchar**)&source_buffer, NULL);
+    const GLchar* source_buffer = vertex_shader.data();
+    GLint source_length = (GLint)vertex_shader.size();
+    glad_glShaderSource(compiled_vertex, 1, &source_buffer, &source_length);
+
+    // Status query waits for the driver, so times cover the whole compilation
+    stage_start = std::chrono::steady_clock::now();
     glCompileShader(compiled_vertex);
-    if(check_for_errors(compiled_vertex, "VERTEX"))
+    bool stage_compiled = check_for_errors(compiled_vertex, "VERTEX");
+    stats.compile_time[0] = get_elapsed_time(stage_start);
+
+    if(stage_compiled)
     {
         glAttachShader(id, compiled_vertex);
 
         init_status = 1;
 
         compiled_fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        source_buffer = fragment_shader.c_str();
-        glShaderSource(compiled_fragment, 1, (const GLchar**)&source_buffer, NULL);
+        source_buffer = fragment_shader.data();
+        source_length = (GLint)fragment_shader.size();
+        glShaderSource(compiled_fragment, 1, &source_buffer, &source_length);
+
+        stage_start = std::chrono::steady_clock::now();
         glCompileShader(compiled_fragment);
-        if(check_for_errors(compiled_fragment, "FRAGMENT"))
+        stage_compiled = check_for_errors(compiled_fragment, "FRAGMENT");
+        stats.compile_time[1] = get_elapsed_time(stage_start);
+
+        if(stage_compiled)
         {
             glAttachShader(id, compiled_fragment);
 
             init_status = 2;
 
             compiled_geometry = glCreateShader(GL_GEOMETRY_SHADER);
-            if (std::strcmp(geometry_shader.c_str(), "NONE") != 0)
+            if (geometry_shader != "NONE")
             {
-                source_buffer = geometry_shader.c_str();
-                glShaderSource(compiled_geometry, 1, (const GLchar**)&source_buffer, NULL);
+                source_buffer = geometry_shader.data();
+                source_length = (GLint)geometry_shader.size();
+                glShaderSource(compiled_geometry, 1, &source_buffer, &source_length);
+
+                stage_start = std::chrono::steady_clock::now();
                 glCompileShader(compiled_geometry);
-                if(check_for_errors(compiled_geometry, "GEOMETRY"))
+                stage_compiled = check_for_errors(compiled_geometry, "GEOMETRY");
+                stats.compile_time[2] = get_elapsed_time(stage_start);
+
+                if(stage_compiled)
                 {
                     glAttachShader(id, compiled_geometry);
 
@@ -165,12 +277,24 @@ GLuint CGUIShaderCompiler::compile_shader(const std::string& vertex_shader, cons
     
     if (id != 0)
     {
+        if (source_hash != 0)
+        {
+            glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+
+        stage_start = std::chrono::steady_clock::now();
         glLinkProgram(id);
+        bool program_linked = check_for_errors(id, "PROGRAM");
+        stats.link_time = get_elapsed_time(stage_start);
 
-        if(!check_for_errors(id, "PROGRAM"))
+        if(!program_linked)
         {
            id = 0;
         }
+        else if (source_hash != 0)
+        {
+            store_program_binary(id, source_hash);
+        }
     }
 
     if (init_status == 1)
@@ -189,6 +313,7 @@ GLuint CGUIShaderCompiler::compile_shader(const std::string& vertex_shader, cons
         glDeleteShader(compiled_geometry);
     }
 
+    stats.ready_time = get_elapsed_time(compile_start);
     return id;
 }
 
@@ -199,76 +324,31 @@ GLuint CGUIShaderCompiler::compile_shader(const std::string& vertex_shader, cons
  * @param[in]  vertext_file_path    The vertex shader file path.
  * @param[in]  fragment_file_path   The fragment shader file path.
  * @param[in]  geometry_file_path   The geometry shader file path.
+ * @param[in]  shader_defines       Defines, that are injected into every stage.
+ *
+ * @return     Handle of the shader, invalid if it has failed.
  */
-void CGUIShaderCompiler::add_shader(const std::string &shader_name, fs::path vertext_file_path, fs::path fragment_file_path, fs::path geometry_file_path)
+CGUIShaderHandle CGUIShaderCompiler::add_shader(const std::string &shader_name, fs::path vertext_file_path, fs::path fragment_file_path, fs::path geometry_file_path, const std::vector<std::string>& shader_defines)
 {
-    std::ifstream vertex_shader_file;
-    std::ifstream fragment_shader_file;
-    std::ifstream geometry_shader_file;
+    std::array<fs::path, 3> stage_paths = {vertext_file_path, fragment_file_path, geometry_file_path};
+    std::array<CGUIMappedFile, 3> stage_files;
+    std::array<std::string_view, 3> stage_sources;
+    std::array<std::string, 3> processed_sources;
+    std::vector<fs::path> dependency_files;
 
-    std::string vertex_shader_string;
-    std::string fragment_shader_string;
-    std::string geometry_shader_string;
-
-    try 
+    if (!read_shader_files(stage_paths, stage_files, stage_sources) ||
+        !preprocess_sources(stage_paths, stage_sources, processed_sources, shader_defines, dependency_files))
     {
-        // Load vertex shader
-        vertex_shader_file.open(fs::absolute(vertext_file_path));
-        if (vertex_shader_file.is_open())
-        {
-            vertex_shader_string = std::string((std::istreambuf_iterator<char>(vertex_shader_file)), std::istreambuf_iterator<char>());
-            vertex_shader_file.close();
-            vertex_shader_string += "\0";
-        }
-        else 
-        {
-            debug_handler.post_log(std::string("Unable to open vertex shader file: ") + fs::absolute(vertext_file_path).string(), DEBUG_MODE_ERROR);
-        }
-
-        // Load fragment shader
-        fragment_shader_file.open(fs::absolute(fragment_file_path));
-        if (fragment_shader_file.is_open())
-        {
-            fragment_shader_string = std::string((std::istreambuf_iterator<char>(fragment_shader_file)), std::istreambuf_iterator<char>());
-            fragment_shader_file.close();
-            fragment_shader_string += "\0";
-        }
-        else 
-        {
-            debug_handler.post_log(std::string("Unable to open fragment shader file: ") + fs::absolute(fragment_file_path).string(), DEBUG_MODE_ERROR);
-        }
-        
-        // Load geometry shader
-        if(geometry_file_path != "")
-        {
-            geometry_shader_file.open(fs::absolute(geometry_file_path));
-            if (geometry_shader_file.is_open())
-            {
-                geometry_shader_string = std::string((std::istreambuf_iterator<char>(geometry_shader_file)), std::istreambuf_iterator<char>());
-                geometry_shader_file.close();
-                geometry_shader_string += "\0";
-            }
-            else 
-            {
-                debug_handler.post_log(std::string("Unable to open geometry shader file: ") + fs::absolute(geometry_file_path).string(), DEBUG_MODE_ERROR);
-            }
-        }
-        else 
-        {
-            geometry_shader_string = "NONE";
-        }
+        return CGUIShaderHandle();
     }
-    catch (std::ifstream::failure& e)
+
+    CGUIShaderHandle shader_handle = link_shader(shader_name, stage_sources);
+    if (shader_handle.is_valid())
     {
-        debug_handler.post_log(std::string("Shaders cannot be loaded properly: ") + e.what(), DEBUG_MODE_ERROR);
-        return;
+        set_shader_files(*get_slot(shader_handle), stage_paths, shader_defines, dependency_files);
     }
 
-    vertex_shader_file.close();
-    fragment_shader_file.close();
-    geometry_shader_file.close();
-
-    add_shader(shader_name, vertex_shader_string, fragment_shader_string, geometry_shader_string);
+    return shader_handle;
 }
 
 #if defined(_WIN32) || defined(WIN32) || defined(__CYGWIN__) || defined(__MINGW32__) || defined(__BORLANDC__)
@@ -279,8 +359,10 @@ void CGUIShaderCompiler::add_shader(const std::string &shader_name, fs::path ver
      * @param[in]  vertex_shader_rsid   The vertex shader resource id.
      * @param[in]  fragment_shader_rsid The fragment shader resource id.
      * @param[in]  geometry_shader_rsid The geometry shader resource id.
+     *
+     * @return     Handle of the shader, invalid if it has failed.
      */
-    void CGUIShaderCompiler::add_shader(const std::string& shader_name, unsigned int vertex_shader_rsid, unsigned int fragment_shader_rsid, unsigned int geometry_shader_rsid)
+    CGUIShaderHandle CGUIShaderCompiler::add_shader(const std::string& shader_name, unsigned int vertex_shader_rsid, unsigned int fragment_shader_rsid, unsigned int geometry_shader_rsid)
     {
         std::string vertex_shader_string;
         std::string fragment_shader_string;
@@ -386,7 +468,7 @@ void CGUIShaderCompiler::add_shader(const std::string &shader_name, fs::path ver
             }
         }
 
-        add_shader(shader_name, vertex_shader_string, fragment_shader_string, geometry_shader_string);
+        return add_shader(shader_name, vertex_shader_string, fragment_shader_string, geometry_shader_string);
     }
 #endif // Windows
 
@@ -397,104 +479,2189 @@ void CGUIShaderCompiler::add_shader(const std::string &shader_name, fs::path ver
  * @param[in]  vertex_shader    The vertex shader source.
  * @param[in]  fragment_shader  The fragment shader source.
  * @param[in]  geometry_shader  The geometry shader source.
+ * @param[in]  shader_defines   Defines, that are injected into every stage.
+ *
+ * @return     Handle of the shader, invalid if it has failed.
  */
-void CGUIShaderCompiler::add_shader(const std::string &shader_name, const std::string &vertex_shader, const std::string &fragment_shader, const std::string &geometry_shader)
+CGUIShaderHandle CGUIShaderCompiler::add_shader(const std::string &shader_name, const std::string &vertex_shader, const std::string &fragment_shader, const std::string &geometry_shader, const std::vector<std::string>& shader_defines)
 {
-    GLuint new_shader_id = compile_shader(vertex_shader, fragment_shader, geometry_shader);
-    if (new_shader_id == 0)
+    std::array<std::string_view, 3> stage_sources = {vertex_shader, fragment_shader, geometry_shader};
+    std::array<std::string, 3> processed_sources;
+    std::vector<fs::path> dependency_files;
+
+    if (!preprocess_sources({}, stage_sources, processed_sources, shader_defines, dependency_files))
     {
-        debug_handler.post_log(std::string("Unable to initialize shader with id: ") + std::to_string(new_shader_id) + std::string(" : ") + shader_name, DEBUG_MODE_ERROR);
-        return;
+        return CGUIShaderHandle();
     }
 
-    debug_handler.post_log(std::string("Shader with id: ") + std::to_string(new_shader_id) + std::string(" has been successfully initialized: ") + shader_name, DEBUG_MODE_LOG);
-    shader_list.insert(std::pair<std::string, GLuint>(shader_name, new_shader_id));
+    return link_shader(shader_name, stage_sources);
 }
 
 /**
- * @brief      Deletes a shader by its name.
+ * @brief      Adds a shader to map, it is compiled and linked in background.
  *
- * @param[in]  shader_name  The shader name.
+ * @param[in]  shader_name          The shader name.
+ * @param[in]  vertext_file_path    The vertex shader file path.
+ * @param[in]  fragment_file_path   The fragment shader file path.
+ * @param[in]  geometry_file_path   The geometry shader file path.
+ * @param[in]  shader_defines       Defines, that are injected into every stage.
+ *
+ * @return     Handle of the shader, invalid if files cannot be read.
  */
-void CGUIShaderCompiler::del_shader(const std::string &shader_name)
-{   
-    GLuint shader_id;
-    auto shader_iterator = shader_list.find(shader_name);
+CGUIShaderFuture CGUIShaderCompiler::add_shader_async(const std::string& shader_name, fs::path vertext_file_path, fs::path fragment_file_path, fs::path geometry_file_path, const std::vector<std::string>& shader_defines)
+{
+    std::array<fs::path, 3> stage_paths = {vertext_file_path, fragment_file_path, geometry_file_path};
+    std::array<CGUIMappedFile, 3> stage_files;
+    std::array<std::string_view, 3> stage_sources;
+    std::array<std::string, 3> processed_sources;
+    std::vector<fs::path> dependency_files;
 
-    if (shader_iterator != shader_list.end())
+    if (!read_shader_files(stage_paths, stage_files, stage_sources) ||
+        !preprocess_sources(stage_paths, stage_sources, processed_sources, shader_defines, dependency_files))
     {
-        shader_id = shader_iterator->second;
-        glDeleteProgram(shader_id);
-        shader_list.erase(shader_name);
-        debug_handler.post_log(std::string("Shader was successfully removed: ") + shader_name, DEBUG_MODE_LOG);
+        return CGUIShaderFuture();
     }
-    else
+
+    CGUIShaderFuture shader_future = submit_shader(shader_name, stage_sources);
+    if (shader_future.is_valid())
     {
-        debug_handler.post_log(std::string("Unable to find shader: ") + shader_name, DEBUG_MODE_ERROR);
+        set_shader_files(*get_slot(shader_future.get_handle()), stage_paths, shader_defines, dependency_files);
     }
+
+    return shader_future;
 }
 
 /**
- * @brief      Applies shaders to renderer.
+ * @brief      Adds a shader to map, it is compiled and linked in background.
  *
- * @param[in]  shader_name  The shader name.
+ * @param[in]  shader_name      The shader name.
+ * @param[in]  vertex_shader    The vertex shader source.
+ * @param[in]  fragment_shader  The fragment shader source.
+ * @param[in]  geometry_shader  The geometry shader source.
+ * @param[in]  shader_defines   Defines, that are injected into every stage.
+ *
+ * @return     Handle of the shader.
  */
-void CGUIShaderCompiler::use_shader(const std::string &shader_name)
+CGUIShaderFuture CGUIShaderCompiler::add_shader_async(const std::string& shader_name, const std::string& vertex_shader, const std::string& fragment_shader, const std::string& geometry_shader, const std::vector<std::string>& shader_defines)
 {
-    GLuint shader_id;
-    auto shader_iterator = shader_list.find(shader_name);
+    std::array<std::string_view, 3> stage_sources = {vertex_shader, fragment_shader, geometry_shader};
+    std::array<std::string, 3> processed_sources;
+    std::vector<fs::path> dependency_files;
 
-    if (shader_iterator != shader_list.end())
+    if (!preprocess_sources({}, stage_sources, processed_sources, shader_defines, dependency_files))
     {
-        shader_id = shader_iterator->second;
-        glUseProgram(shader_id);
-        debug_handler.post_log(std::string("Shader was successfully applied: ") + shader_name, DEBUG_MODE_LOG);
+        return CGUIShaderFuture();
     }
-    else
+
+    return submit_shader(shader_name, stage_sources);
+}
+
+/**
+ * @brief      Adds a family of shader permutations, none of them is compiled yet.
+ *
+ *             Every bit of variant key enables one feature define, permutation is
+ *             compiled the first time it is requested by get_variant.
+ *
+ * @param[in]  shader_name          The shader name.
+ * @param[in]  vertext_file_path    The vertex shader file path.
+ * @param[in]  fragment_file_path   The fragment shader file path.
+ * @param[in]  geometry_file_path   The geometry shader file path.
+ * @param[in]  variant_features     Feature defines, bit i of variant key enables feature i.
+ *
+ * @return     Handle of the family, invalid if name is taken.
+ */
+CGUIShaderHandle CGUIShaderCompiler::add_shader_variants(const std::string& shader_name, fs::path vertext_file_path, fs::path fragment_file_path, fs::path geometry_file_path, const std::vector<std::string>& variant_features)
+{
+    CGUIShaderHandle family_handle = add_shader_variants(shader_name, std::string(), std::string(), std::string(), variant_features);
+    if (family_handle.is_valid())
     {
-        debug_handler.post_log(std::string("Unable to find shader: ") + shader_name, DEBUG_MODE_ERROR);
+        get_slot(family_handle)->shader_files = {vertext_file_path, fragment_file_path, geometry_file_path};
     }
+
+    return family_handle;
 }
 
 /**
- * @brief      Checks for errors in shader compilation.
+ * @brief      Adds a family of shader permutations, none of them is compiled yet.
  *
- * @param[in]  shader_id    The shader identifier.
- * @param[in]  shader_type  The shader type.
+ * @param[in]  shader_name       The shader name.
+ * @param[in]  vertex_shader     The vertex shader source.
+ * @param[in]  fragment_shader   The fragment shader source.
+ * @param[in]  geometry_shader   The geometry shader source.
+ * @param[in]  variant_features  Feature defines, bit i of variant key enables feature i.
  *
- * @return     Status of compilation.
+ * @return     Handle of the family, invalid if name is taken.
  */
-bool CGUIShaderCompiler::check_for_errors(GLuint shader_id, std::string shader_type)
+CGUIShaderHandle CGUIShaderCompiler::add_shader_variants(const std::string& shader_name, const std::string& vertex_shader, const std::string& fragment_shader, const std::string& geometry_shader, const std::vector<std::string>& variant_features)
 {
-    GLint success;
-    if(shader_type != "PROGRAM")
+    if (get_shader_handle(cgui_shader_name_hash(shader_name)).is_valid())
     {
-        debug_handler.post_log(std::string("Shader is being checked: ") + std::to_string(shader_id), DEBUG_MODE_LOG);
-        glGetShaderiv(shader_id, GL_COMPILE_STATUS, &success);
-        if(success == GL_FALSE)
+        debug_handler.post_log(std::string("Shader already exists: ") + shader_name, DEBUG_MODE_ERROR);
+        return CGUIShaderHandle();
+    }
+
+    if (variant_features.size() > 64)
+    {
+        debug_handler.post_log(std::string("Variant key can not hold all features: ") + shader_name, DEBUG_MODE_ERROR);
+        return CGUIShaderHandle();
+    }
+
+    CGUIShaderHandle family_handle = allocate_slot(shader_name);
+    CGUIShaderSlot& family_slot = *get_slot(family_handle);
+
+    family_slot.variant_family = true;
+    family_slot.variant_features = variant_features;
+    family_slot.variant_sources = {vertex_shader, fragment_shader, geometry_shader};
+
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, std::string("Shader variants have been added: ") + shader_name);
+    return family_handle;
+}
+
+/**
+ * @brief      Gets permutation of shader family, it is submitted for compilation on first request.
+ *
+ *             Permutation is an ordinary shader, so it is waited for on first use,
+ *             cached on disk and reloaded like any other shader.
+ *
+ * @param[in]  family_handle  Handle of the family.
+ * @param[in]  variant_key    Bitmask of enabled features.
+ *
+ * @return     Handle of the permutation, invalid if it can not be compiled.
+ */
+CGUIShaderHandle CGUIShaderCompiler::get_variant(CGUIShaderHandle family_handle, uint64_t variant_key)
+{
+    CGUIShaderSlot* family_slot = get_slot(family_handle);
+    if (family_slot == nullptr || !family_slot->variant_family)
+    {
+        debug_handler.post_log(std::string("Unable to find shader variants with index: ") + std::to_string(family_handle.index), DEBUG_MODE_ERROR);
+        return CGUIShaderHandle();
+    }
+
+    auto variant_iterator = family_slot->variants.find(variant_key);
+    if (variant_iterator != family_slot->variants.end())
+    {
+        return variant_iterator->second;
+    }
+
+    std::vector<std::string> variant_defines;
+    for (std::size_t feature_index = 0; feature_index < family_slot->variant_features.size(); ++feature_index)
+    {
+        if ((variant_key >> feature_index) & 1)
         {
-            debug_handler.post_log(std::string("Unable to compile shader id: ") + std::to_string(shader_id) + std::string(" - ") + shader_type, DEBUG_MODE_ERROR);
-            glGetShaderiv(shader_id, GL_INFO_LOG_LENGTH, &success);
-            std::vector<GLchar> info_log(success);
+            variant_defines.push_back(family_slot->variant_features[feature_index]);
+        }
+    }
 
-            glGetShaderInfoLog(shader_id, success, NULL, &info_log[0]);
-            debug_handler.post_log(std::string("Shader error log: ") + "\n" + std::string(info_log.begin(), info_log.end()), DEBUG_MODE_ERROR);
-            return false;
+    if (family_slot->variant_features.size() < 64 && (variant_key >> family_slot->variant_features.size()) != 0)
+    {
+        debug_handler.post_log(std::string("Variant key has unknown features: ") + family_slot->shader_name, DEBUG_MODE_WARNING);
+    }
+
+    std::stringstream variant_name;
+    variant_name << family_slot->shader_name << '#' << std::hex << variant_key;
+
+    // Slots might be reallocated by the new permutation
+    const std::array<fs::path, 3> stage_paths = family_slot->shader_files;
+    const std::array<std::string, 3> stage_sources = family_slot->variant_sources;
+
+    CGUIShaderFuture variant_future = (!stage_paths[0].empty())
+        ? add_shader_async(variant_name.str(), stage_paths[0], stage_paths[1], stage_paths[2], variant_defines)
+        : add_shader_async(variant_name.str(), stage_sources[0], stage_sources[1], stage_sources[2], variant_defines);
+
+    if (variant_future.is_valid())
+    {
+        get_slot(family_handle)->variants[variant_key] = variant_future.get_handle();
+    }
+
+    return variant_future.get_handle();
+}
+
+/**
+ * @brief      Compiles a new instance of compute program.
+ *
+ *             Programs are cached on disk same way as graphics ones.
+ *
+ * @param[in]  compute_shader  The compute shader source.
+ * @param      compile_stats   Telemetry of compilation, can be nullptr.
+ *
+ * @return     Linked program id, 0 if it has failed.
+ */
+GLuint CGUIShaderCompiler::compile_compute(std::string_view compute_shader, CGUIShaderStats* compile_stats)
+{
+    CGUIShaderStats local_stats;
+    CGUIShaderStats& stats = (compile_stats != nullptr) ? *compile_stats : local_stats;
+    stats.source_size = {0, 0, 0, compute_shader.size()};
+
+    std::chrono::steady_clock::time_point compile_start = std::chrono::steady_clock::now();
+
+    // Graphics programs never have empty vertex stage, so keys of compute programs can not collide with them
+    uint64_t source_hash = 0;
+    if (is_binary_cache_supported())
+    {
+        source_hash = get_source_hash(std::string_view(), std::string_view(), compute_shader);
+
+        GLuint cached_id = load_program_binary(source_hash);
+        if (cached_id != 0)
+        {
+            main_frame_capture.track_program_stage(cached_id, GL_COMPUTE_SHADER, std::string(compute_shader));
+
+            stats.from_cache = true;
+            stats.link_time = get_elapsed_time(compile_start);
+            stats.ready_time = stats.link_time;
+            return cached_id;
         }
     }
-    else
+
+    GLuint id = glCreateProgram();
+
+    GLuint compiled_compute = glCreateShader(GL_COMPUTE_SHADER);
+    const GLchar* source_buffer = compute_shader.data();
+    GLint source_length = (GLint)compute_shader.size();
+    glShaderSource(compiled_compute, 1, &source_buffer, &source_length);
+
+    std::chrono::steady_clock::time_point stage_start = std::chrono::steady_clock::now();
+    glCompileShader(compiled_compute);
+    bool stage_compiled = check_for_errors(compiled_compute, "COMPUTE");
+    stats.compile_time[3] = get_elapsed_time(stage_start);
+
+    if (stage_compiled)
     {
-        glGetProgramiv(shader_id, GL_LINK_STATUS, &success);
-        if(success == GL_FALSE)
+        glAttachShader(id, compiled_compute);
+
+        if (source_hash != 0)
         {
-            debug_handler.post_log(std::string("Unable to link program id: ") + std::to_string(shader_id) + std::string(" - ") + shader_type, DEBUG_MODE_ERROR);
-            glGetProgramiv(shader_id, GL_INFO_LOG_LENGTH, &success);
-            std::vector<GLchar> info_log(success);
+            glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
 
-            glGetProgramInfoLog(shader_id, success, NULL, &info_log[0]);
-            debug_handler.post_log(std::string("Program error log: ") + "\n" + std::string(info_log.begin(), info_log.end()), DEBUG_MODE_ERROR);
-            return false;
+        stage_start = std::chrono::steady_clock::now();
+        glLinkProgram(id);
+        bool program_linked = check_for_errors(id, "PROGRAM");
+        stats.link_time = get_elapsed_time(stage_start);
+
+        glDetachShader(id, compiled_compute);
+
+        if (program_linked && source_hash != 0)
+        {
+            store_program_binary(id, source_hash);
+        }
+        else if (!program_linked)
+        {
+            glDeleteProgram(id);
+            id = 0;
         }
     }
-    return true;
-}
\ No newline at end of file
+    else
+    {
+        glDeleteProgram(id);
+        id = 0;
+    }
+    glDeleteShader(compiled_compute);
+
+    stats.ready_time = get_elapsed_time(compile_start);
+    return id;
+}
+
+/**
+ * @brief      Adds a compute program to map.
+ *
+ * @param[in]  shader_name        The shader name.
+ * @param[in]  compute_file_path  The compute shader file path.
+ * @param[in]  shader_defines     Defines, that are injected into the shader.
+ *
+ * @return     Handle of the shader, invalid if it has failed.
+ */
+CGUIShaderHandle CGUIShaderCompiler::add_compute(const std::string& shader_name, fs::path compute_file_path, const std::vector<std::string>& shader_defines)
+{
+    std::array<fs::path, 3> stage_paths = {compute_file_path, fs::path(), fs::path()};
+    std::array<std::string_view, 3> stage_sources;
+    std::array<std::string, 3> processed_sources;
+    std::vector<fs::path> dependency_files;
+
+    CGUIMappedFile compute_file = asset_loader.load(fs::absolute(compute_file_path));
+    if (!compute_file.is_open())
+    {
+        debug_handler.post_log(std::string("Unable to open compute shader file: ") + fs::absolute(compute_file_path).string(), DEBUG_MODE_ERROR);
+        return CGUIShaderHandle();
+    }
+
+    stage_sources[0] = compute_file.get_view();
+    if (!preprocess_sources(stage_paths, stage_sources, processed_sources, shader_defines, dependency_files))
+    {
+        return CGUIShaderHandle();
+    }
+
+    CGUIShaderHandle shader_handle = link_compute(shader_name, stage_sources[0]);
+    if (shader_handle.is_valid())
+    {
+        set_shader_files(*get_slot(shader_handle), stage_paths, shader_defines, dependency_files);
+    }
+
+    return shader_handle;
+}
+
+/**
+ * @brief      Adds a compute program to map.
+ *
+ * @param[in]  shader_name     The shader name.
+ * @param[in]  compute_shader  The compute shader source.
+ * @param[in]  shader_defines  Defines, that are injected into the shader.
+ *
+ * @return     Handle of the shader, invalid if it has failed.
+ */
+CGUIShaderHandle CGUIShaderCompiler::add_compute(const std::string& shader_name, const std::string& compute_shader, const std::vector<std::string>& shader_defines)
+{
+    std::array<std::string_view, 3> stage_sources = {compute_shader, std::string_view(), std::string_view()};
+    std::array<std::string, 3> processed_sources;
+    std::vector<fs::path> dependency_files;
+
+    if (!preprocess_sources({}, stage_sources, processed_sources, shader_defines, dependency_files))
+    {
+        return CGUIShaderHandle();
+    }
+
+    return link_compute(shader_name, stage_sources[0]);
+}
+
+/**
+ * @brief      Binds compute program and dispatches work groups.
+ *
+ *             Program stays bound, results have to be made visible with memory_barrier.
+ *
+ * @param[in]  shader_handle  Handle of the compute shader.
+ * @param[in]  group_count    Amount of work groups in every dimension.
+ *
+ * @return     False if shader is not a compute program, or counts exceed driver limits.
+ */
+bool CGUIShaderCompiler::dispatch_compute(CGUIShaderHandle shader_handle, glm::uvec3 group_count)
+{
+    CGUIShaderSlot* shader_slot = get_compute_slot(shader_handle);
+    if (shader_slot == nullptr)
+    {
+        return false;
+    }
+
+    if (group_count.x == 0 || group_count.y == 0 || group_count.z == 0)
+    {
+        return true;
+    }
+
+    glm::uvec3 max_group_count = get_max_workgroup_count();
+    if (group_count.x > max_group_count.x || group_count.y > max_group_count.y || group_count.z > max_group_count.z)
+    {
+        debug_handler.post_log(std::string("Work group count exceeds driver limits: ") + shader_slot->shader_name + " " + std::to_string(group_count.x) + "x" +
+                               std::to_string(group_count.y) + "x" + std::to_string(group_count.z), DEBUG_MODE_ERROR);
+        return false;
+    }
+
+    glUseProgram(shader_slot->program_id);
+    glDispatchCompute(group_count.x, group_count.y, group_count.z);
+    return true;
+}
+
+/**
+ * @brief      Dispatches enough work groups to cover every item.
+ *
+ *             Shader has to skip invocations outside of item count, last groups are partial.
+ *
+ * @param[in]  shader_handle  Handle of the compute shader.
+ * @param[in]  item_count     Amount of items in every dimension.
+ *
+ * @return     False if shader is not a compute program, or counts exceed driver limits.
+ */
+bool CGUIShaderCompiler::dispatch_compute_items(CGUIShaderHandle shader_handle, glm::uvec3 item_count)
+{
+    glm::uvec3 workgroup_size = get_workgroup_size(shader_handle);
+    if (workgroup_size.x == 0)
+    {
+        return false;
+    }
+
+    return dispatch_compute(shader_handle, glm::uvec3((item_count.x + workgroup_size.x - 1) / workgroup_size.x,
+                                                      (item_count.y + workgroup_size.y - 1) / workgroup_size.y,
+                                                      (item_count.z + workgroup_size.z - 1) / workgroup_size.z));
+}
+
+/**
+ * @brief      Dispatches work groups, counts are read by GPU from bound GL_DISPATCH_INDIRECT_BUFFER.
+ *
+ * @param[in]  shader_handle    Handle of the compute shader.
+ * @param[in]  indirect_offset  Offset of three GLuint counts in the buffer.
+ *
+ * @return     False if shader is not a compute program.
+ */
+bool CGUIShaderCompiler::dispatch_compute_indirect(CGUIShaderHandle shader_handle, GLintptr indirect_offset)
+{
+    CGUIShaderSlot* shader_slot = get_compute_slot(shader_handle);
+    if (shader_slot == nullptr)
+    {
+        return false;
+    }
+
+    glUseProgram(shader_slot->program_id);
+    glDispatchComputeIndirect(indirect_offset);
+    return true;
+}
+
+/**
+ * @brief      Gets local size of the compute program, that was declared by its layout.
+ *
+ * @param[in]  shader_handle  Handle of the compute shader.
+ *
+ * @return     Size of work group, zeroes if shader is not a compute program.
+ */
+glm::uvec3 CGUIShaderCompiler::get_workgroup_size(CGUIShaderHandle shader_handle)
+{
+    CGUIShaderSlot* shader_slot = get_compute_slot(shader_handle);
+    return (shader_slot != nullptr) ? shader_slot->reflection.workgroup_size : glm::uvec3(0, 0, 0);
+}
+
+/**
+ * @brief      Makes writes of previous dispatches visible.
+ *
+ * @param[in]  barrier_bits  CGUI_BARRIER_* for the way results are read next.
+ */
+void CGUIShaderCompiler::memory_barrier(GLbitfield barrier_bits)
+{
+    glMemoryBarrier(barrier_bits);
+}
+
+/**
+ * @brief      Makes writes of previous fragment shaders visible to the same framebuffer region only.
+ *
+ * @param[in]  barrier_bits  CGUI_BARRIER_STORAGE, CGUI_BARRIER_IMAGES or CGUI_BARRIER_UNIFORMS.
+ */
+void CGUIShaderCompiler::memory_barrier_by_region(GLbitfield barrier_bits)
+{
+    glMemoryBarrierByRegion(barrier_bits);
+}
+
+/**
+ * @brief      Gets preprocessor, that resolves includes of every added shader.
+ *
+ * @return     The shader preprocessor.
+ */
+CGUIShaderPreprocessor* CGUIShaderCompiler::get_preprocessor()
+{
+    return &preprocessor;
+}
+
+/**
+ * @brief      Gets loader, that maps shader files, it can prefetch files of shaders, that would be added later.
+ *
+ * @return     The asset loader.
+ */
+CGUIAssetLoader* CGUIShaderCompiler::get_asset_loader()
+{
+    return &asset_loader;
+}
+
+/**
+ * @brief      Checks whether shader has finished compilation, finishes it if so.
+ *
+ * @param[in]  shader_handle  Handle of the shader.
+ *
+ * @return     True if shader is ready or failed, False if it is still being compiled.
+ */
+bool CGUIShaderCompiler::is_shader_ready(CGUIShaderHandle shader_handle)
+{
+    CGUIShaderSlot* shader_slot = get_slot(shader_handle);
+    if (shader_slot == nullptr || !shader_slot->pending)
+    {
+        return true;
+    }
+
+    if (!is_program_complete(shader_slot->pending_shader))
+    {
+        return false;
+    }
+
+    finish_shader(*shader_slot);
+    return true;
+}
+
+/**
+ * @brief      Finishes every shader, that has completed compilation.
+ *
+ * @return     Amount of shaders, that are still being compiled.
+ */
+std::size_t CGUIShaderCompiler::poll_shaders()
+{
+    std::size_t pending_count = 0;
+    for (CGUIShaderSlot& shader_slot : shader_slots)
+    {
+        if (shader_slot.pending && is_program_complete(shader_slot.pending_shader))
+        {
+            finish_shader(shader_slot);
+        }
+
+        pending_count += (shader_slot.pending) ? 1 : 0;
+    }
+
+    return pending_count;
+}
+
+/**
+ * @brief      Waits for every pending shader.
+ */
+void CGUIShaderCompiler::wait_shaders()
+{
+    for (CGUIShaderSlot& shader_slot : shader_slots)
+    {
+        finish_shader(shader_slot);
+    }
+}
+
+/**
+ * @brief      Gets source and included files of every shader, that was loaded from files.
+ *
+ * @return     Paths of the files.
+ */
+std::vector<fs::path> CGUIShaderCompiler::get_shader_files()
+{
+    std::vector<fs::path> file_paths;
+    for (const CGUIShaderSlot& shader_slot : shader_slots)
+    {
+        for (const fs::path& dependency_path : shader_slot.dependency_files)
+        {
+            if (std::find(file_paths.begin(), file_paths.end(), dependency_path) == file_paths.end())
+            {
+                file_paths.push_back(dependency_path);
+            }
+        }
+    }
+
+    return file_paths;
+}
+
+/**
+ * @brief      Gets revision of shader files, it changes every time includes are resolved again.
+ *
+ * @return     Revision, that is compared with the one of watched files.
+ */
+uint64_t CGUIShaderCompiler::get_shader_files_revision()
+{
+    return shader_files_revision;
+}
+
+/**
+ * @brief      Requests reload of every shader, that uses changed file.
+ *
+ *             Can be called from any thread, reload itself is done by update_reloads.
+ *
+ * @param[in]  changed_file  Path of the changed file.
+ */
+void CGUIShaderCompiler::request_reload(const fs::path& changed_file)
+{
+    std::lock_guard reload_lock(reload_mutex);
+    changed_files.push_back(changed_file);
+}
+
+/**
+ * @brief      Advances shader reloads, has to be called at frame boundary.
+ *
+ *             Shaders with changed files are submitted for compilation, finished ones
+ *             replace old programs. Old program is kept, if new one fails, so a typo
+ *             in the file never breaks rendering.
+ *
+ * @return     Handles of shaders, whose program ids have changed.
+ */
+std::vector<CGUIShaderHandle> CGUIShaderCompiler::update_reloads()
+{
+    std::vector<CGUIShaderHandle> swapped_shaders;
+    std::vector<fs::path> reload_files;
+    {
+        std::lock_guard reload_lock(reload_mutex);
+        reload_files.swap(changed_files);
+    }
+
+    for (const fs::path& changed_file : reload_files)
+    {
+        std::error_code path_error;
+        for (CGUIShaderSlot& shader_slot : shader_slots)
+        {
+            bool uses_file = false;
+            for (const fs::path& dependency_path : shader_slot.dependency_files)
+            {
+                uses_file = uses_file || fs::equivalent(dependency_path, changed_file, path_error);
+            }
+
+            if (uses_file)
+            {
+                submit_reload(shader_slot);
+            }
+        }
+    }
+
+    for (uint32_t slot_index = 0; slot_index < shader_slots.size(); ++slot_index)
+    {
+        CGUIShaderSlot& shader_slot = shader_slots[slot_index];
+        if (!shader_slot.reloading || !is_program_complete(shader_slot.reload_shader))
+        {
+            continue;
+        }
+
+        GLuint new_shader_id = link_pending_shader(shader_slot.reload_shader);
+        CGUIShaderStats compile_stats = shader_slot.reload_shader.stats;
+        shader_slot.reloading = false;
+        shader_slot.reload_shader = CGUIPendingShader();
+
+        if (new_shader_id == 0)
+        {
+            debug_handler.post_log(std::string("Unable to reload shader, previous program is kept: ") + shader_slot.shader_name, DEBUG_MODE_ERROR);
+            continue;
+        }
+
+        // Reload, that was started before first compilation has finished, replaces it
+        finish_shader(shader_slot);
+        if (shader_slot.program_id != 0)
+        {
+            main_memory_tracker.unregister_object(CGUI_MEMORY_PROGRAM, shader_slot.program_id);
+            glDeleteProgram(shader_slot.program_id);
+        }
+
+        register_shader(shader_slot, new_shader_id, compile_stats);
+        swapped_shaders.push_back(CGUIShaderHandle{slot_index, shader_slot.generation});
+        CGUI_POST_RECORD(debug_handler, CGUI_LOG_SHADER_RELOAD, shader_slot.shader_name);
+    }
+
+    return swapped_shaders;
+}
+
+/**
+ * @brief      Checks if any reload is requested or still being compiled.
+ *
+ * @return     True if update_reloads has to be called again.
+ */
+bool CGUIShaderCompiler::has_pending_reloads()
+{
+    {
+        std::lock_guard reload_lock(reload_mutex);
+        if (!changed_files.empty())
+        {
+            return true;
+        }
+    }
+
+    return std::any_of(shader_slots.begin(), shader_slots.end(), [](const CGUIShaderSlot& shader_slot){ return shader_slot.reloading; });
+}
+
+/**
+ * @brief      Deletes a shader, its slot is reused by next added shader.
+ *
+ * @param[in]  shader_handle  Handle of the shader.
+ */
+void CGUIShaderCompiler::del_shader(CGUIShaderHandle shader_handle)
+{
+    CGUIShaderSlot* shader_slot = get_slot(shader_handle);
+    if (shader_slot == nullptr)
+    {
+        debug_handler.post_log(std::string("Unable to find shader with index: ") + std::to_string(shader_handle.index), DEBUG_MODE_ERROR);
+        return;
+    }
+
+    // Permutations are owned by their family
+    if (shader_slot->variant_family)
+    {
+        std::vector<CGUIShaderHandle> variant_handles;
+        for (const auto& [variant_key, variant_handle] : shader_slot->variants)
+        {
+            variant_handles.push_back(variant_handle);
+        }
+
+        for (CGUIShaderHandle variant_handle : variant_handles)
+        {
+            del_shader(variant_handle);
+        }
+
+        shader_slot = get_slot(shader_handle);
+    }
+
+    finish_shader(*shader_slot);
+    drop_reload(*shader_slot);
+
+    if (shader_slot->program_id != 0)
+    {
+        main_memory_tracker.unregister_object(CGUI_MEMORY_PROGRAM, shader_slot->program_id);
+        glDeleteProgram(shader_slot->program_id);
+    }
+
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, std::string("Shader was successfully removed: ") + shader_slot->shader_name);
+    release_slot(shader_handle);
+}
+
+/**
+ * @brief      Deletes a shader by its name.
+ *
+ * @param[in]  shader_name  The shader name.
+ */
+void CGUIShaderCompiler::del_shader(const std::string &shader_name)
+{
+    CGUIShaderHandle shader_handle = get_shader_handle(shader_name);
+    if (shader_handle.is_valid())
+    {
+        del_shader(shader_handle);
+    }
+}
+
+/**
+ * @brief      Applies shaders to renderer.
+ *
+ *             Only slot is indexed, so it can be called on every draw.
+ *
+ * @param[in]  shader_handle  Handle of the shader.
+ */
+void CGUIShaderCompiler::use_shader(CGUIShaderHandle shader_handle)
+{
+    glUseProgram(get_shader_id(shader_handle));
+}
+
+/**
+ * @brief      Applies shaders to renderer.
+ *
+ *             Name is hashed on every call, handle should be kept instead.
+ *
+ * @param[in]  shader_name  The shader name.
+ */
+void CGUIShaderCompiler::use_shader(const std::string &shader_name)
+{
+    CGUIShaderHandle shader_handle = get_shader_handle(shader_name);
+    if (shader_handle.is_valid())
+    {
+        use_shader(shader_handle);
+    }
+}
+
+/**
+ * @brief      Gets program id by shader handle.
+ *
+ *             Shader, that is still being compiled, is waited for.
+ *
+ * @param[in]  shader_handle  Handle of the shader.
+ *
+ * @return     Program id, 0 if shader was not found or has failed.
+ */
+GLuint CGUIShaderCompiler::get_shader_id(CGUIShaderHandle shader_handle)
+{
+    CGUIShaderSlot* shader_slot = get_slot(shader_handle);
+    if (shader_slot == nullptr)
+    {
+        debug_handler.post_log(std::string("Unable to find shader with index: ") + std::to_string(shader_handle.index), DEBUG_MODE_ERROR);
+        return 0;
+    }
+
+    if (shader_slot->pending)
+    {
+        finish_shader(*shader_slot);
+    }
+
+    return shader_slot->program_id;
+}
+
+/**
+ * @brief      Gets program id by shader name.
+ *
+ * @param[in]  shader_name  The shader name.
+ *
+ * @return     Program id, 0 if shader was not found.
+ */
+GLuint CGUIShaderCompiler::get_shader_id(const std::string &shader_name)
+{
+    CGUIShaderHandle shader_handle = get_shader_handle(shader_name);
+    return (shader_handle.is_valid()) ? get_shader_id(shader_handle) : 0;
+}
+
+/**
+ * @brief      Gets handle of the shader by hash of its name.
+ *
+ * @param[in]  name_hash  Hash of the name, CGUI_SHADER_NAME for static names.
+ *
+ * @return     Handle of the shader, invalid if it was not found.
+ */
+CGUIShaderHandle CGUIShaderCompiler::get_shader_handle(uint64_t name_hash)
+{
+    auto name_iterator = shader_names.find(name_hash);
+    return (name_iterator != shader_names.end()) ? name_iterator->second : CGUIShaderHandle();
+}
+
+/**
+ * @brief      Gets handle of the shader by its name.
+ *
+ * @param[in]  shader_name  The shader name.
+ *
+ * @return     Handle of the shader, invalid if it was not found.
+ */
+CGUIShaderHandle CGUIShaderCompiler::get_shader_handle(const std::string& shader_name)
+{
+    CGUIShaderHandle shader_handle = get_shader_handle(cgui_shader_name_hash(shader_name));
+    if (!shader_handle.is_valid())
+    {
+        debug_handler.post_log(std::string("Unable to find shader: ") + shader_name, DEBUG_MODE_ERROR);
+    }
+
+    return shader_handle;
+}
+
+/**
+ * @brief      Gets uniforms and blocks of the shader, they are reflected once program is linked.
+ *
+ * @param[in]  shader_handle  Handle of the shader.
+ *
+ * @return     Reflection of the program, nullptr if shader was not found.
+ */
+const CGUIProgramReflection* CGUIShaderCompiler::get_reflection(CGUIShaderHandle shader_handle)
+{
+    CGUIShaderSlot* shader_slot = get_slot(shader_handle);
+    if (shader_slot == nullptr)
+    {
+        debug_handler.post_log(std::string("Unable to find shader with index: ") + std::to_string(shader_handle.index), DEBUG_MODE_ERROR);
+        return nullptr;
+    }
+
+    if (shader_slot->pending)
+    {
+        finish_shader(*shader_slot);
+    }
+
+    return &shader_slot->reflection;
+}
+
+/**
+ * @brief      Gets reflected uniform of the shader.
+ *
+ * @param[in]  shader_handle  Handle of the shader.
+ * @param[in]  name_hash      Hash of the uniform name, CGUI_UNIFORM_NAME for static names.
+ *
+ * @return     Uniform, nullptr if it is not active in program.
+ */
+const CGUIUniformInfo* CGUIShaderCompiler::get_uniform(CGUIShaderHandle shader_handle, uint64_t name_hash)
+{
+    const CGUIProgramReflection* reflection = get_reflection(shader_handle);
+    if (reflection == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto uniform_iterator = reflection->uniforms.find(name_hash);
+    return (uniform_iterator != reflection->uniforms.end()) ? &uniform_iterator->second : nullptr;
+}
+
+/**
+ * @brief      Gets reflected uniform block of the shader.
+ *
+ * @param[in]  shader_handle  Handle of the shader.
+ * @param[in]  name_hash      Hash of the block name, CGUI_UNIFORM_NAME for static names.
+ *
+ * @return     Uniform block, nullptr if it is not active in program.
+ */
+const CGUIUniformBlockInfo* CGUIShaderCompiler::get_uniform_block(CGUIShaderHandle shader_handle, uint64_t name_hash)
+{
+    const CGUIProgramReflection* reflection = get_reflection(shader_handle);
+    if (reflection == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto block_iterator = reflection->uniform_blocks.find(name_hash);
+    return (block_iterator != reflection->uniform_blocks.end()) ? &block_iterator->second : nullptr;
+}
+
+/**
+ * @brief      Gets reflected shader storage block of the shader.
+ *
+ * @param[in]  shader_handle  Handle of the shader.
+ * @param[in]  name_hash      Hash of the block name, CGUI_UNIFORM_NAME for static names.
+ *
+ * @return     Storage block, nullptr if it is not active in program.
+ */
+const CGUIStorageBlockInfo* CGUIShaderCompiler::get_storage_block(CGUIShaderHandle shader_handle, uint64_t name_hash)
+{
+    const CGUIProgramReflection* reflection = get_reflection(shader_handle);
+    if (reflection == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto block_iterator = reflection->storage_blocks.find(name_hash);
+    return (block_iterator != reflection->storage_blocks.end()) ? &block_iterator->second : nullptr;
+}
+
+/**
+ * @brief      Gets location of the uniform without querying driver.
+ *
+ * @param[in]  shader_handle  Handle of the shader.
+ * @param[in]  name_hash      Hash of the uniform name, CGUI_UNIFORM_NAME for static names.
+ *
+ * @return     Location, -1 if uniform is not active or is a member of block.
+ */
+GLint CGUIShaderCompiler::get_uniform_location(CGUIShaderHandle shader_handle, uint64_t name_hash)
+{
+    const CGUIUniformInfo* uniform = get_uniform(shader_handle, name_hash);
+    return (uniform != nullptr) ? uniform->location : -1;
+}
+
+/**
+ * @brief      Checks, that uniform block is covered by structure, that is written into it.
+ *
+ *             Structure might be larger, since drivers differ in rounding of block size.
+ *
+ * @param[in]  shader_handle  Handle of the shader.
+ * @param[in]  name_hash      Hash of the block name.
+ * @param[in]  block_size     Size of the structure.
+ *
+ * @return     False if block is missing or is larger than structure.
+ */
+bool CGUIShaderCompiler::check_uniform_block(CGUIShaderHandle shader_handle, uint64_t name_hash, std::size_t block_size)
+{
+    const CGUIUniformBlockInfo* uniform_block = get_uniform_block(shader_handle, name_hash);
+    if (uniform_block == nullptr || (std::size_t)uniform_block->data_size > block_size)
+    {
+        CGUIShaderSlot* shader_slot = get_slot(shader_handle);
+        debug_handler.post_log(std::string("Uniform block does not match its structure: ") + ((shader_slot != nullptr) ? shader_slot->shader_name : std::string()), DEBUG_MODE_ERROR);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief      Gets compile telemetry of the shader.
+ *
+ * @param[in]  shader_handle  Handle of the shader.
+ *
+ * @return     Telemetry of the last build, nullptr if shader is not ready.
+ */
+const CGUIShaderStats* CGUIShaderCompiler::get_shader_stats(CGUIShaderHandle shader_handle)
+{
+    CGUIShaderSlot* shader_slot = get_slot(shader_handle);
+    if (shader_slot == nullptr || shader_slot->program_id == 0)
+    {
+        return nullptr;
+    }
+
+    return &shader_slot->stats;
+}
+
+/**
+ * @brief      Prints compile telemetry of every ready shader, slowest first.
+ */
+void CGUIShaderCompiler::report_shader_stats()
+{
+    std::vector<const CGUIShaderSlot*> ready_slots;
+    for (const CGUIShaderSlot& shader_slot : shader_slots)
+    {
+        if (shader_slot.program_id != 0)
+        {
+            ready_slots.push_back(&shader_slot);
+        }
+    }
+
+    std::sort(ready_slots.begin(), ready_slots.end(), [](const CGUIShaderSlot* first_slot, const CGUIShaderSlot* second_slot)
+    {
+        return first_slot->stats.ready_time > second_slot->stats.ready_time;
+    });
+
+    auto format_time = [](uint64_t time_us)
+    {
+        std::stringstream time_string;
+        time_string << std::fixed << std::setprecision(3) << (double)time_us / 1000.0 << " ms";
+        return time_string.str();
+    };
+
+    const char* stage_names[4] = {"vertex", "fragment", "geometry", "compute"};
+    uint64_t total_time = 0;
+    std::size_t total_binary_size = 0;
+
+    for (const CGUIShaderSlot* shader_slot : ready_slots)
+    {
+        const CGUIShaderStats& stats = shader_slot->stats;
+        std::string report_line = std::string("Shader ") + shader_slot->shader_name + ": ready in " + format_time(stats.ready_time) +
+                                  (stats.from_cache ? " (binary cache)" : (stats.asynchronous ? " (async)" : " (sync)"));
+
+        for (std::size_t stage_index = 0; stage_index < stats.source_size.size(); ++stage_index)
+        {
+            if (stats.source_size[stage_index] != 0)
+            {
+                report_line += std::string(", ") + stage_names[stage_index] + " " + std::to_string(stats.source_size[stage_index]) + " B / " + format_time(stats.compile_time[stage_index]);
+            }
+        }
+
+        report_line += ", link " + format_time(stats.link_time) + ", binary " + std::to_string(stats.binary_size) + " B, uniforms " + std::to_string(stats.uniform_count) +
+                       ", blocks " + std::to_string(stats.uniform_block_count) + ", attributes " + std::to_string(stats.attribute_count) + ", builds " + std::to_string(stats.build_count);
+        debug_handler.post_log(report_line, DEBUG_MODE_MESSAGE);
+
+        total_time += stats.ready_time;
+        total_binary_size += stats.binary_size;
+    }
+
+    debug_handler.post_log(std::string("Shaders: ") + std::to_string(ready_slots.size()) + " programs, " + format_time(total_time) + " total, " +
+                           std::to_string(total_binary_size) + " B of binaries.", DEBUG_MODE_MESSAGE);
+}
+
+/**
+ * @brief      Writes compile telemetry of every ready shader into JSON file.
+ *
+ * @param[in]  file_path  Path of the file, empty path gives shader_stats.json next to program cache.
+ *
+ * @return     False if file can not be written.
+ */
+bool CGUIShaderCompiler::export_shader_stats(const fs::path& file_path)
+{
+    fs::path stats_path = file_path.empty() ? get_data_directory() / __CGUI_OBF__("shader_stats.json") : file_path;
+
+    std::ofstream stats_file(stats_path, std::ios::trunc);
+    if (!stats_file.is_open())
+    {
+        debug_handler.post_log(std::string("Unable to write shader stats: ") + stats_path.string(), DEBUG_MODE_ERROR);
+        return false;
+    }
+
+    const char* stage_names[4] = {"vertex", "fragment", "geometry", "compute"};
+    bool first_program = true;
+
+    stats_file << "{\n    \"programs\": [";
+    for (const CGUIShaderSlot& shader_slot : shader_slots)
+    {
+        if (shader_slot.program_id == 0)
+        {
+            continue;
+        }
+
+        const CGUIShaderStats& stats = shader_slot.stats;
+        stats_file << (first_program ? "\n" : ",\n") << "        {\n"
+                   << "            \"name\": \"" << escape_json(shader_slot.shader_name) << "\",\n"
+                   << "            \"program_id\": " << shader_slot.program_id << ",\n"
+                   << "            \"from_cache\": " << (stats.from_cache ? "true" : "false") << ",\n"
+                   << "            \"asynchronous\": " << (stats.asynchronous ? "true" : "false") << ",\n"
+                   << "            \"build_count\": " << stats.build_count << ",\n"
+                   << "            \"stages\": {";
+
+        bool first_stage = true;
+        for (std::size_t stage_index = 0; stage_index < stats.source_size.size(); ++stage_index)
+        {
+            if (stats.source_size[stage_index] == 0)
+            {
+                continue;
+            }
+
+            stats_file << (first_stage ? "" : ", ") << "\"" << stage_names[stage_index] << "\": {\"source_size\": " << stats.source_size[stage_index]
+                       << ", \"compile_us\": " << stats.compile_time[stage_index] << "}";
+            first_stage = false;
+        }
+
+        stats_file << "},\n"
+                   << "            \"link_us\": " << stats.link_time << ",\n"
+                   << "            \"ready_us\": " << stats.ready_time << ",\n"
+                   << "            \"binary_size\": " << stats.binary_size << ",\n"
+                   << "            \"uniforms\": " << stats.uniform_count << ",\n"
+                   << "            \"uniform_blocks\": " << stats.uniform_block_count << ",\n"
+                   << "            \"attributes\": " << stats.attribute_count << "\n"
+                   << "        }";
+        first_program = false;
+    }
+    stats_file << (first_program ? "]\n}\n" : "\n    ]\n}\n");
+
+    if (!stats_file.good())
+    {
+        debug_handler.post_log(std::string("Unable to write shader stats: ") + stats_path.string(), DEBUG_MODE_ERROR);
+        return false;
+    }
+
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, std::string("Shader stats have been exported: ") + stats_path.string());
+    return true;
+}
+
+/**
+ * @brief      Checks for errors in shader compilation.
+ *
+ * @param[in]  shader_id    The shader identifier.
+ * @param[in]  shader_type  The shader type.
+ *
+ * @return     Status of compilation.
+ */
+bool CGUIShaderCompiler::check_for_errors(GLuint shader_id, std::string shader_type)
+{
+    GLint success;
+    if(shader_type != "PROGRAM")
+    {
+        CGUI_POST_FORMAT(debug_handler, DEBUG_MODE_LOG, "Shader is being checked: {}", shader_id);
+        glGetShaderiv(shader_id, GL_COMPILE_STATUS, &success);
+        if(success == GL_FALSE)
+        {
+            debug_handler.post_log(std::string("Unable to compile shader id: ") + std::to_string(shader_id) + std::string(" - ") + shader_type, DEBUG_MODE_ERROR);
+            glGetShaderiv(shader_id, GL_INFO_LOG_LENGTH, &success);
+            std::vector<GLchar> info_log(success);
+
+            glGetShaderInfoLog(shader_id, success, NULL, &info_log[0]);
+            debug_handler.post_log(std::string("Shader error log: ") + "\n" + std::string(info_log.begin(), info_log.end()), DEBUG_MODE_ERROR);
+            return false;
+        }
+    }
+    else
+    {
+        glGetProgramiv(shader_id, GL_LINK_STATUS, &success);
+        if(success == GL_FALSE)
+        {
+            debug_handler.post_log(std::string("Unable to link program id: ") + std::to_string(shader_id) + std::string(" - ") + shader_type, DEBUG_MODE_ERROR);
+            glGetProgramiv(shader_id, GL_INFO_LOG_LENGTH, &success);
+            std::vector<GLchar> info_log(success);
+
+            glGetProgramInfoLog(shader_id, success, NULL, &info_log[0]);
+            debug_handler.post_log(std::string("Program error log: ") + "\n" + std::string(info_log.begin(), info_log.end()), DEBUG_MODE_ERROR);
+            return false;
+        }
+    }
+    return true;
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Maps files of every stage.
+ *
+ * @param[in]  stage_paths    Paths of vertex, fragment and geometry stages, geometry path can be empty.
+ * @param      stage_files    Mapped files, they have to outlive sources.
+ * @param      stage_sources  Views of mapped files, geometry source is "NONE" if there is no geometry stage.
+ *
+ * @return     False if some stage can not be read.
+ */
+bool CGUIShaderCompiler::read_shader_files(const std::array<fs::path, 3>& stage_paths, std::array<CGUIMappedFile, 3>& stage_files, std::array<std::string_view, 3>& stage_sources)
+{
+    const char* stage_types[3] = {"vertex", "fragment", "geometry"};
+
+    for (std::size_t stage_index = 0; stage_index < 3; ++stage_index)
+    {
+        if (stage_index == 2 && stage_paths[stage_index].empty())
+        {
+            stage_sources[stage_index] = "NONE";
+            continue;
+        }
+
+        stage_files[stage_index] = asset_loader.load(fs::absolute(stage_paths[stage_index]));
+        if (!stage_files[stage_index].is_open())
+        {
+            debug_handler.post_log(std::string("Unable to open ") + stage_types[stage_index] + " shader file: " + fs::absolute(stage_paths[stage_index]).string(), DEBUG_MODE_ERROR);
+            return false;
+        }
+
+        stage_sources[stage_index] = stage_files[stage_index].get_view();
+    }
+
+    return true;
+}
+
+/**
+ * @brief      Resolves includes and injects defines into every stage.
+ *
+ *             Stage without includes and defines is passed to driver as it is,
+ *             so mapped file is never copied.
+ *
+ * @param[in]  stage_paths        Paths of stages, empty if sources were not read from files.
+ * @param      stage_sources      Sources of stages, processed ones are replaced by views of processed sources.
+ * @param      processed_sources  Storage of processed sources.
+ * @param[in]  shader_defines     Defines, that are injected into every stage.
+ * @param      dependency_files   Stage files and every included file are appended to it.
+ *
+ * @return     False if some stage can not be preprocessed.
+ */
+bool CGUIShaderCompiler::preprocess_sources(const std::array<fs::path, 3>& stage_paths, std::array<std::string_view, 3>& stage_sources, std::array<std::string, 3>& processed_sources,
+                                            const std::vector<std::string>& shader_defines, std::vector<fs::path>& dependency_files)
+{
+    for (std::size_t stage_index = 0; stage_index < 3; ++stage_index)
+    {
+        if (stage_sources[stage_index].empty() || stage_sources[stage_index] == "NONE")
+        {
+            continue;
+        }
+
+        if (shader_defines.empty() && stage_sources[stage_index].find("#include") == std::string_view::npos)
+        {
+            if (!stage_paths[stage_index].empty())
+            {
+                std::error_code path_error;
+                dependency_files.push_back(fs::absolute(stage_paths[stage_index], path_error).lexically_normal());
+            }
+            continue;
+        }
+
+        if (!preprocessor.process(stage_sources[stage_index], stage_paths[stage_index], shader_defines, processed_sources[stage_index], dependency_files))
+        {
+            return false;
+        }
+
+        stage_sources[stage_index] = processed_sources[stage_index];
+    }
+
+    return true;
+}
+
+/**
+ * @brief      Remembers files of the shader, so it could be reloaded.
+ *
+ * @param      shader_slot       Slot of the shader.
+ * @param[in]  stage_paths       Paths of stages.
+ * @param[in]  shader_defines    Defines, that were injected.
+ * @param[in]  dependency_files  Stage files and included files.
+ */
+void CGUIShaderCompiler::set_shader_files(CGUIShaderSlot& shader_slot, const std::array<fs::path, 3>& stage_paths,
+                                          const std::vector<std::string>& shader_defines, const std::vector<fs::path>& dependency_files)
+{
+    shader_slot.shader_files = stage_paths;
+    shader_slot.shader_defines = shader_defines;
+    shader_slot.dependency_files = dependency_files;
+    ++shader_files_revision;
+}
+
+/**
+ * @brief      Compiles preprocessed sources and stores program in a new slot.
+ *
+ * @param[in]  shader_name    The shader name.
+ * @param[in]  stage_sources  Preprocessed sources of stages.
+ *
+ * @return     Handle of the shader, invalid if it has failed.
+ */
+CGUIShaderHandle CGUIShaderCompiler::link_shader(const std::string& shader_name, const std::array<std::string_view, 3>& stage_sources)
+{
+    if (get_shader_handle(cgui_shader_name_hash(shader_name)).is_valid())
+    {
+        debug_handler.post_log(std::string("Shader already exists: ") + shader_name, DEBUG_MODE_ERROR);
+        return CGUIShaderHandle();
+    }
+
+    CGUIShaderStats compile_stats;
+    GLuint new_shader_id = compile_shader(stage_sources[0], stage_sources[1], stage_sources[2], &compile_stats);
+    if (new_shader_id == 0)
+    {
+        debug_handler.post_log(std::string("Unable to initialize shader with id: ") + std::to_string(new_shader_id) + std::string(" : ") + shader_name, DEBUG_MODE_ERROR);
+        return CGUIShaderHandle();
+    }
+
+    CGUIShaderHandle shader_handle = allocate_slot(shader_name);
+    register_shader(*get_slot(shader_handle), new_shader_id, compile_stats);
+
+    return shader_handle;
+}
+
+/**
+ * @brief      Submits preprocessed sources for compilation in background.
+ *
+ *             All stages are submitted and linked without waiting for results, so
+ *             driver with parallel shader compile does the work on its own threads.
+ *             Errors are checked once program is complete, programs from binary
+ *             cache are ready immediately.
+ *
+ * @param[in]  shader_name    The shader name.
+ * @param[in]  stage_sources  Preprocessed sources of stages.
+ *
+ * @return     Handle of the shader.
+ */
+CGUIShaderFuture CGUIShaderCompiler::submit_shader(const std::string& shader_name, const std::array<std::string_view, 3>& stage_sources)
+{
+    if (get_shader_handle(cgui_shader_name_hash(shader_name)).is_valid())
+    {
+        debug_handler.post_log(std::string("Shader already exists: ") + shader_name, DEBUG_MODE_ERROR);
+        return CGUIShaderFuture();
+    }
+
+    // Enables driver threads before the first submission
+    is_parallel_compile_supported();
+
+    CGUIPendingShader pending_shader;
+    pending_shader.submit_time = std::chrono::steady_clock::now();
+
+    if (is_binary_cache_supported())
+    {
+        pending_shader.source_hash = get_source_hash(stage_sources[0], stage_sources[1], stage_sources[2]);
+
+        GLuint cached_id = load_program_binary(pending_shader.source_hash);
+        if (cached_id != 0)
+        {
+            track_program_sources(cached_id, stage_sources[0], stage_sources[1], stage_sources[2]);
+
+            CGUIShaderStats compile_stats;
+            compile_stats.source_size = {stage_sources[0].size(), stage_sources[1].size(), (stage_sources[2] != "NONE") ? stage_sources[2].size() : 0};
+            compile_stats.from_cache = true;
+            compile_stats.link_time = get_elapsed_time(pending_shader.submit_time);
+            compile_stats.ready_time = compile_stats.link_time;
+
+            CGUIShaderHandle shader_handle = allocate_slot(shader_name);
+            register_shader(*get_slot(shader_handle), cached_id, compile_stats);
+            return CGUIShaderFuture(this, shader_handle);
+        }
+    }
+
+    submit_program(stage_sources[0], stage_sources[1], stage_sources[2], pending_shader);
+
+    CGUIShaderHandle shader_handle = allocate_slot(shader_name);
+    CGUIShaderSlot& shader_slot = *get_slot(shader_handle);
+    shader_slot.pending = true;
+    shader_slot.pending_shader = pending_shader;
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, std::string("Shader has been submitted for compilation: ") + shader_name);
+
+    return CGUIShaderFuture(this, shader_handle);
+}
+
+/**
+ * @brief      Compiles preprocessed compute source and stores program in a new slot.
+ *
+ * @param[in]  shader_name     The shader name.
+ * @param[in]  compute_shader  Preprocessed compute source.
+ *
+ * @return     Handle of the shader, invalid if it has failed.
+ */
+CGUIShaderHandle CGUIShaderCompiler::link_compute(const std::string& shader_name, std::string_view compute_shader)
+{
+    if (get_shader_handle(cgui_shader_name_hash(shader_name)).is_valid())
+    {
+        debug_handler.post_log(std::string("Shader already exists: ") + shader_name, DEBUG_MODE_ERROR);
+        return CGUIShaderHandle();
+    }
+
+    CGUIShaderStats compile_stats;
+    GLuint new_shader_id = compile_compute(compute_shader, &compile_stats);
+    if (new_shader_id == 0)
+    {
+        debug_handler.post_log(std::string("Unable to initialize compute shader: ") + shader_name, DEBUG_MODE_ERROR);
+        return CGUIShaderHandle();
+    }
+
+    CGUIShaderHandle shader_handle = allocate_slot(shader_name);
+    CGUIShaderSlot& shader_slot = *get_slot(shader_handle);
+    shader_slot.compute = true;
+    register_shader(shader_slot, new_shader_id, compile_stats);
+
+    return shader_handle;
+}
+
+/**
+ * @brief      Gets slot of the compute shader.
+ *
+ * @param[in]  shader_handle  Handle of the shader.
+ *
+ * @return     Slot of the shader, nullptr if it is not a ready compute program.
+ */
+CGUIShaderSlot* CGUIShaderCompiler::get_compute_slot(CGUIShaderHandle shader_handle)
+{
+    CGUIShaderSlot* shader_slot = get_slot(shader_handle);
+    if (shader_slot == nullptr || !shader_slot->compute || shader_slot->program_id == 0)
+    {
+        debug_handler.post_log(std::string("Unable to find compute shader with index: ") + std::to_string(shader_handle.index), DEBUG_MODE_ERROR);
+        return nullptr;
+    }
+
+    return shader_slot;
+}
+
+/**
+ * @brief      Gets maximal amount of work groups in every dimension of single dispatch.
+ *
+ * @return     Limits of driver.
+ */
+glm::uvec3 CGUIShaderCompiler::get_max_workgroup_count()
+{
+    if (max_workgroup_count.x == 0)
+    {
+        GLint dimension_counts[3] = {1, 1, 1};
+        for (GLuint dimension = 0; dimension < 3; ++dimension)
+        {
+            glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_COUNT, dimension, &dimension_counts[dimension]);
+        }
+
+        max_workgroup_count = glm::uvec3((GLuint)std::max(dimension_counts[0], 1), (GLuint)std::max(dimension_counts[1], 1), (GLuint)std::max(dimension_counts[2], 1));
+    }
+
+    return max_workgroup_count;
+}
+
+/**
+ * @brief      Gets slot of the shader.
+ *
+ * @param[in]  shader_handle  Handle of the shader.
+ *
+ * @return     Slot of the shader, nullptr if handle is invalid or shader was deleted.
+ */
+CGUIShaderSlot* CGUIShaderCompiler::get_slot(CGUIShaderHandle shader_handle)
+{
+    if (shader_handle.index >= shader_slots.size() || shader_slots[shader_handle.index].generation != shader_handle.generation ||
+        shader_slots[shader_handle.index].name_hash == 0)
+    {
+        return nullptr;
+    }
+
+    return &shader_slots[shader_handle.index];
+}
+
+/**
+ * @brief      Takes free slot for the shader, or adds a new one.
+ *
+ * @param[in]  shader_name  The shader name.
+ *
+ * @return     Handle of the slot.
+ */
+CGUIShaderHandle CGUIShaderCompiler::allocate_slot(const std::string& shader_name)
+{
+    CGUIShaderHandle shader_handle;
+
+    if (!free_slots.empty())
+    {
+        shader_handle.index = free_slots.back();
+        free_slots.pop_back();
+    }
+    else
+    {
+        shader_handle.index = (uint32_t)shader_slots.size();
+        shader_slots.emplace_back();
+    }
+
+    CGUIShaderSlot& shader_slot = shader_slots[shader_handle.index];
+    shader_slot.name_hash = cgui_shader_name_hash(shader_name);
+    shader_slot.shader_name = shader_name;
+    shader_handle.generation = shader_slot.generation;
+
+    shader_names[shader_slot.name_hash] = shader_handle;
+    return shader_handle;
+}
+
+/**
+ * @brief      Frees slot of the shader, generation is bumped, so old handles become invalid.
+ *
+ * @param[in]  shader_handle  Handle of the slot.
+ */
+void CGUIShaderCompiler::release_slot(CGUIShaderHandle shader_handle)
+{
+    CGUIShaderSlot& shader_slot = shader_slots[shader_handle.index];
+    shader_names.erase(shader_slot.name_hash);
+
+    uint32_t next_generation = shader_slot.generation + 1;
+    shader_slot = CGUIShaderSlot();
+    shader_slot.generation = next_generation;
+
+    free_slots.push_back(shader_handle.index);
+}
+
+/**
+ * @brief      Stores linked program in slot of the shader.
+ *
+ * @param      shader_slot    Slot of the shader.
+ * @param[in]  shader_id      Linked program.
+ * @param[in]  compile_stats  Telemetry of compilation, program counters are added to it.
+ */
+void CGUIShaderCompiler::register_shader(CGUIShaderSlot& shader_slot, GLuint shader_id, const CGUIShaderStats& compile_stats)
+{
+    CGUI_POST_FORMAT(debug_handler, DEBUG_MODE_LOG, "Shader with id: {} has been successfully initialized: {}", shader_id, shader_slot.shader_name);
+    shader_slot.program_id = shader_id;
+    reflect_program(shader_id, shader_slot.reflection);
+
+    uint32_t build_count = shader_slot.stats.build_count + 1;
+    shader_slot.stats = compile_stats;
+    shader_slot.stats.build_count = build_count;
+    shader_slot.stats.binary_size = CGUIMemoryTracker::get_program_size(shader_id);
+    shader_slot.stats.uniform_count = shader_slot.reflection.uniforms.size();
+    shader_slot.stats.uniform_block_count = shader_slot.reflection.uniform_blocks.size();
+
+    GLint attribute_count = 0;
+    glGetProgramInterfaceiv(shader_id, GL_PROGRAM_INPUT, GL_ACTIVE_RESOURCES, &attribute_count);
+    shader_slot.stats.attribute_count = (std::size_t)std::max(attribute_count, 0);
+
+    // Local size can only be queried from compute programs
+    if (shader_slot.compute)
+    {
+        GLint workgroup_size[3] = {0, 0, 0};
+        glGetProgramiv(shader_id, GL_COMPUTE_WORK_GROUP_SIZE, workgroup_size);
+        shader_slot.reflection.workgroup_size = glm::uvec3((GLuint)workgroup_size[0], (GLuint)workgroup_size[1], (GLuint)workgroup_size[2]);
+    }
+
+    main_memory_tracker.register_object(CGUI_MEMORY_PROGRAM, shader_id, shader_slot.stats.binary_size, GL_NONE, shader_slot.shader_name);
+}
+
+/**
+ * @brief      Reflects active uniforms, uniform blocks and storage blocks of linked program.
+ *
+ * @param[in]  program_id  Linked program.
+ * @param      reflection  Reflection, that is replaced.
+ */
+void CGUIShaderCompiler::reflect_program(GLuint program_id, CGUIProgramReflection& reflection)
+{
+    reflection.uniforms.clear();
+    reflection.uniform_blocks.clear();
+    reflection.storage_blocks.clear();
+
+    GLint uniform_count = 0, block_count = 0, storage_count = 0, uniform_name_length = 0, block_name_length = 0, storage_name_length = 0;
+    glGetProgramInterfaceiv(program_id, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniform_count);
+    glGetProgramInterfaceiv(program_id, GL_UNIFORM, GL_MAX_NAME_LENGTH, &uniform_name_length);
+    glGetProgramInterfaceiv(program_id, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &block_count);
+    glGetProgramInterfaceiv(program_id, GL_UNIFORM_BLOCK, GL_MAX_NAME_LENGTH, &block_name_length);
+    glGetProgramInterfaceiv(program_id, GL_SHADER_STORAGE_BLOCK, GL_ACTIVE_RESOURCES, &storage_count);
+    glGetProgramInterfaceiv(program_id, GL_SHADER_STORAGE_BLOCK, GL_MAX_NAME_LENGTH, &storage_name_length);
+
+    std::vector<GLchar> resource_name((std::size_t)std::max({uniform_name_length, block_name_length, storage_name_length, 1}));
+    GLsizei name_length = 0;
+
+    const GLenum uniform_properties[5] = {GL_LOCATION, GL_TYPE, GL_ARRAY_SIZE, GL_BLOCK_INDEX, GL_OFFSET};
+    for (GLuint uniform_index = 0; uniform_index < (GLuint)uniform_count; ++uniform_index)
+    {
+        GLint values[5] = {-1, GL_NONE, 1, -1, -1};
+        glGetProgramResourceiv(program_id, GL_UNIFORM, uniform_index, 5, uniform_properties, 5, nullptr, values);
+        glGetProgramResourceName(program_id, GL_UNIFORM, uniform_index, (GLsizei)resource_name.size(), &name_length, resource_name.data());
+
+        // Arrays are reported as their first element
+        std::string_view uniform_name(resource_name.data(), (std::size_t)name_length);
+        if (uniform_name.ends_with("[0]"))
+        {
+            uniform_name.remove_suffix(3);
+        }
+
+        reflection.uniforms[cgui_shader_name_hash(uniform_name)] = {values[0], (GLenum)values[1], values[2], values[3], values[4]};
+    }
+
+    const GLenum block_properties[2] = {GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE};
+    for (GLuint block_index = 0; block_index < (GLuint)block_count; ++block_index)
+    {
+        GLint values[2] = {0, 0};
+        glGetProgramResourceiv(program_id, GL_UNIFORM_BLOCK, block_index, 2, block_properties, 2, nullptr, values);
+        glGetProgramResourceName(program_id, GL_UNIFORM_BLOCK, block_index, (GLsizei)resource_name.size(), &name_length, resource_name.data());
+
+        reflection.uniform_blocks[cgui_shader_name_hash(std::string_view(resource_name.data(), (std::size_t)name_length))] = {block_index, values[0], values[1]};
+    }
+
+    for (GLuint block_index = 0; block_index < (GLuint)storage_count; ++block_index)
+    {
+        GLint values[2] = {0, 0};
+        glGetProgramResourceiv(program_id, GL_SHADER_STORAGE_BLOCK, block_index, 2, block_properties, 2, nullptr, values);
+        glGetProgramResourceName(program_id, GL_SHADER_STORAGE_BLOCK, block_index, (GLsizei)resource_name.size(), &name_length, resource_name.data());
+
+        reflection.storage_blocks[cgui_shader_name_hash(std::string_view(resource_name.data(), (std::size_t)name_length))] = {block_index, values[0], values[1]};
+    }
+}
+
+/**
+ * @brief      Checks results of pending shader and stores it in its slot.
+ *
+ *             Waits for the driver, if compilation has not finished yet.
+ *             Failed shader keeps its slot with program id 0.
+ *
+ * @param      shader_slot  Slot of the shader.
+ *
+ * @return     False if shader failed, True if it was stored or was not pending.
+ */
+bool CGUIShaderCompiler::finish_shader(CGUIShaderSlot& shader_slot)
+{
+    if (!shader_slot.pending)
+    {
+        return true;
+    }
+
+    CGUIPendingShader pending_shader = shader_slot.pending_shader;
+    shader_slot.pending = false;
+    shader_slot.pending_shader = CGUIPendingShader();
+
+    GLuint shader_id = link_pending_shader(pending_shader);
+    if (shader_id == 0)
+    {
+        debug_handler.post_log(std::string("Unable to initialize shader: ") + shader_slot.shader_name, DEBUG_MODE_ERROR);
+        return false;
+    }
+
+    register_shader(shader_slot, shader_id, pending_shader.stats);
+    return true;
+}
+
+/**
+ * @brief      Creates program, compiles its stages and links it without checking results.
+ *
+ * @param[in]  vertex_shader    The vertex shader source.
+ * @param[in]  fragment_shader  The fragment shader source.
+ * @param[in]  geometry_shader  The geometry shader source.
+ * @param      pending_shader   Submitted program, its source hash has to be set already.
+ */
+void CGUIShaderCompiler::submit_program(std::string_view vertex_shader, std::string_view fragment_shader, std::string_view geometry_shader, CGUIPendingShader& pending_shader)
+{
+    const GLenum stage_types[3] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER};
+    const std::string_view stage_sources[3] = {vertex_shader, fragment_shader, geometry_shader};
+
+    pending_shader.program_id = glCreateProgram();
+
+    for (std::size_t stage_index = 0; stage_index < 3; ++stage_index)
+    {
+        if (stage_index == 2 && geometry_shader == "NONE")
+        {
+            continue;
+        }
+
+        const GLchar* source_buffer = stage_sources[stage_index].data();
+        const GLint source_length = (GLint)stage_sources[stage_index].size();
+
+        pending_shader.stage_ids[stage_index] = glCreateShader(stage_types[stage_index]);
+        glShaderSource(pending_shader.stage_ids[stage_index], 1, &source_buffer, &source_length);
+
+        // Driver with parallel compile only queues the work here, the rest is measured, when results are checked
+        std::chrono::steady_clock::time_point stage_start = std::chrono::steady_clock::now();
+        glCompileShader(pending_shader.stage_ids[stage_index]);
+        pending_shader.stats.compile_time[stage_index] = get_elapsed_time(stage_start);
+        pending_shader.stats.source_size[stage_index] = stage_sources[stage_index].size();
+
+        glAttachShader(pending_shader.program_id, pending_shader.stage_ids[stage_index]);
+    }
+
+    pending_shader.stats.asynchronous = true;
+
+    if (pending_shader.source_hash != 0)
+    {
+        glProgramParameteri(pending_shader.program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    std::chrono::steady_clock::time_point link_start = std::chrono::steady_clock::now();
+    glLinkProgram(pending_shader.program_id);
+    pending_shader.stats.link_time = get_elapsed_time(link_start);
+}
+
+/**
+ * @brief      Checks results of submitted program and releases its stages.
+ *
+ * @param      pending_shader  Submitted program, time of waiting for results is added to its telemetry.
+ *
+ * @return     Linked program, 0 if compilation or linking failed, failed program is deleted.
+ *             Program from binary cache is returned as is.
+ */
+GLuint CGUIShaderCompiler::link_pending_shader(CGUIPendingShader& pending_shader)
+{
+    if (pending_shader.program_id == 0)
+    {
+        // Compute reloads are compiled right away and keep their own times
+        if (pending_shader.stats.from_cache)
+        {
+            pending_shader.stats.link_time = get_elapsed_time(pending_shader.submit_time);
+        }
+        pending_shader.stats.ready_time = get_elapsed_time(pending_shader.submit_time);
+        return pending_shader.cached_id;
+    }
+
+    const char* stage_names[3] = {"VERTEX", "FRAGMENT", "GEOMETRY"};
+    bool compiled = true;
+
+    for (std::size_t stage_index = 0; stage_index < 3; ++stage_index)
+    {
+        if (pending_shader.stage_ids[stage_index] == 0)
+        {
+            continue;
+        }
+
+        std::chrono::steady_clock::time_point stage_start = std::chrono::steady_clock::now();
+        compiled = check_for_errors(pending_shader.stage_ids[stage_index], stage_names[stage_index]) && compiled;
+        pending_shader.stats.compile_time[stage_index] += get_elapsed_time(stage_start);
+    }
+
+    // Link log only repeats stage errors
+    std::chrono::steady_clock::time_point link_start = std::chrono::steady_clock::now();
+    compiled = compiled && check_for_errors(pending_shader.program_id, "PROGRAM");
+    pending_shader.stats.link_time += get_elapsed_time(link_start);
+    pending_shader.stats.ready_time = get_elapsed_time(pending_shader.submit_time);
+
+    for (GLuint stage_id : pending_shader.stage_ids)
+    {
+        if (stage_id != 0)
+        {
+            glDetachShader(pending_shader.program_id, stage_id);
+            glDeleteShader(stage_id);
+        }
+    }
+
+    if (!compiled)
+    {
+        glDeleteProgram(pending_shader.program_id);
+        return 0;
+    }
+
+    if (pending_shader.source_hash != 0)
+    {
+        store_program_binary(pending_shader.program_id, pending_shader.source_hash);
+    }
+
+    return pending_shader.program_id;
+}
+
+/**
+ * @brief      Checks, whether pending program has finished compilation.
+ *
+ * @param[in]  pending_shader  Submitted program.
+ *
+ * @return     True if results can be read without waiting, or driver can not tell.
+ */
+bool CGUIShaderCompiler::is_program_complete(const CGUIPendingShader& pending_shader)
+{
+    if (pending_shader.program_id == 0 || !is_parallel_compile_supported())
+    {
+        return true;
+    }
+
+    GLint completion_status = GL_FALSE;
+    glGetProgramiv(pending_shader.program_id, GL_COMPLETION_STATUS_KHR, &completion_status);
+    return completion_status == GL_TRUE;
+}
+
+/**
+ * @brief      Reads and preprocesses files of the shader again and submits them for compilation.
+ *
+ *             Reload, that is still running, is dropped, since its sources are outdated.
+ *
+ * @param      shader_slot  Slot of the shader.
+ */
+void CGUIShaderCompiler::submit_reload(CGUIShaderSlot& shader_slot)
+{
+    if (shader_slot.compute)
+    {
+        submit_compute_reload(shader_slot);
+        return;
+    }
+
+    std::array<CGUIMappedFile, 3> stage_files;
+    std::array<std::string_view, 3> stage_sources;
+    std::array<std::string, 3> processed_sources;
+    std::vector<fs::path> dependency_files;
+
+    if (!read_shader_files(shader_slot.shader_files, stage_files, stage_sources) ||
+        !preprocess_sources(shader_slot.shader_files, stage_sources, processed_sources, shader_slot.shader_defines, dependency_files))
+    {
+        return;
+    }
+
+    // Includes might have been added or removed
+    shader_slot.dependency_files = dependency_files;
+    ++shader_files_revision;
+
+    std::string_view vertex_shader_string = stage_sources[0];
+    std::string_view fragment_shader_string = stage_sources[1];
+    std::string_view geometry_shader_string = stage_sources[2];
+
+    drop_reload(shader_slot);
+
+    CGUIPendingShader pending_shader;
+    pending_shader.submit_time = std::chrono::steady_clock::now();
+
+    if (is_binary_cache_supported())
+    {
+        pending_shader.source_hash = get_source_hash(vertex_shader_string, fragment_shader_string, geometry_shader_string);
+
+        // Reverting the file gives back program from cache, it is stored as finished reload
+        GLuint cached_id = load_program_binary(pending_shader.source_hash);
+        if (cached_id != 0)
+        {
+            track_program_sources(cached_id, vertex_shader_string, fragment_shader_string, geometry_shader_string);
+
+            shader_slot.reloading = true;
+            shader_slot.reload_shader = pending_shader;
+            shader_slot.reload_shader.cached_id = cached_id;
+            shader_slot.reload_shader.stats.source_size = {vertex_shader_string.size(), fragment_shader_string.size(),
+                                                           (geometry_shader_string != "NONE") ? geometry_shader_string.size() : 0};
+            shader_slot.reload_shader.stats.from_cache = true;
+            return;
+        }
+    }
+
+    submit_program(vertex_shader_string, fragment_shader_string, geometry_shader_string, pending_shader);
+    shader_slot.reloading = true;
+    shader_slot.reload_shader = pending_shader;
+
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, std::string("Shader has been submitted for reload: ") + shader_slot.shader_name);
+}
+
+/**
+ * @brief      Reads and preprocesses file of the compute shader again and compiles it.
+ *
+ *             Compute programs are small, so they are compiled right away and
+ *             stored as finished reload.
+ *
+ * @param      shader_slot  Slot of the compute shader.
+ */
+void CGUIShaderCompiler::submit_compute_reload(CGUIShaderSlot& shader_slot)
+{
+    std::array<std::string_view, 3> stage_sources;
+    std::array<std::string, 3> processed_sources;
+    std::vector<fs::path> dependency_files;
+
+    CGUIMappedFile compute_file = asset_loader.load(fs::absolute(shader_slot.shader_files[0]));
+    if (!compute_file.is_open())
+    {
+        debug_handler.post_log(std::string("Unable to open compute shader file: ") + fs::absolute(shader_slot.shader_files[0]).string(), DEBUG_MODE_ERROR);
+        return;
+    }
+
+    stage_sources[0] = compute_file.get_view();
+    if (!preprocess_sources(shader_slot.shader_files, stage_sources, processed_sources, shader_slot.shader_defines, dependency_files))
+    {
+        return;
+    }
+
+    shader_slot.dependency_files = dependency_files;
+    ++shader_files_revision;
+    drop_reload(shader_slot);
+
+    CGUIPendingShader pending_shader;
+    pending_shader.submit_time = std::chrono::steady_clock::now();
+    pending_shader.cached_id = compile_compute(stage_sources[0], &pending_shader.stats);
+
+    if (pending_shader.cached_id == 0)
+    {
+        debug_handler.post_log(std::string("Unable to reload shader, previous program is kept: ") + shader_slot.shader_name, DEBUG_MODE_ERROR);
+        return;
+    }
+
+    shader_slot.reloading = true;
+    shader_slot.reload_shader = pending_shader;
+}
+
+/**
+ * @brief      Deletes reload, that has not replaced program of the shader yet.
+ *
+ * @param      shader_slot  Slot of the shader.
+ */
+void CGUIShaderCompiler::drop_reload(CGUIShaderSlot& shader_slot)
+{
+    if (!shader_slot.reloading)
+    {
+        return;
+    }
+
+    for (GLuint stage_id : shader_slot.reload_shader.stage_ids)
+    {
+        glDeleteShader(stage_id);
+    }
+    glDeleteProgram(shader_slot.reload_shader.program_id);
+    glDeleteProgram(shader_slot.reload_shader.cached_id);
+
+    shader_slot.reloading = false;
+    shader_slot.reload_shader = CGUIPendingShader();
+}
+
+/**
+ * @brief      Checks, whether driver compiles shaders on its own threads, and enables them.
+ *
+ * @return     True if completion status can be polled.
+ */
+bool CGUIShaderCompiler::is_parallel_compile_supported()
+{
+    if (parallel_compile_supported == -1)
+    {
+        parallel_compile_supported = 1;
+
+        // Maximum value lets driver pick amount of threads
+        if (GLAD_GL_KHR_parallel_shader_compile)
+        {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        }
+        else if (GLAD_GL_ARB_parallel_shader_compile)
+        {
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+        }
+        else
+        {
+            parallel_compile_supported = 0;
+            debug_handler.post_log("Driver does not support parallel shader compile, shaders are finished on first use.", DEBUG_MODE_WARNING);
+        }
+    }
+
+    return parallel_compile_supported == 1;
+}
+
+/**
+ * @brief      Hashes program sources together with driver, that would compile them.
+ *
+ *             Binaries are only valid for the same renderer and driver version,
+ *             so they are part of the key.
+ *
+ * @param[in]  vertex_shader    The vertex shader source.
+ * @param[in]  fragment_shader  The fragment shader source.
+ * @param[in]  geometry_shader  The geometry shader source.
+ *
+ * @return     FNV-1a hash, never 0.
+ */
+uint64_t CGUIShaderCompiler::get_source_hash(std::string_view vertex_shader, std::string_view fragment_shader, std::string_view geometry_shader)
+{
+    const char* renderer_name = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    const char* renderer_version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+
+    const std::string_view key_parts[] = {vertex_shader, fragment_shader, geometry_shader,
+        (renderer_name != nullptr) ? renderer_name : "", (renderer_version != nullptr) ? renderer_version : ""};
+
+    uint64_t source_hash = CGUI_PROGRAM_CACHE_BASIS;
+    for (std::string_view key_part : key_parts)
+    {
+        for (char key_char : key_part)
+        {
+            source_hash = (source_hash ^ (uint8_t)key_char) * CGUI_PROGRAM_CACHE_PRIME;
+        }
+
+        // Separator, so moved text between stages changes the hash
+        source_hash = (source_hash ^ 0xFF) * CGUI_PROGRAM_CACHE_PRIME;
+    }
+
+    return (source_hash != 0) ? source_hash : 1;
+}
+
+/**
+ * @brief      Loads program from binary cache.
+ *
+ *             Damaged entries and entries, rejected by driver, are removed,
+ *             so they would be replaced after compilation.
+ *
+ * @param[in]  source_hash  Hash of sources and driver.
+ *
+ * @return     Linked program id, 0 on cache miss.
+ */
+GLuint CGUIShaderCompiler::load_program_binary(uint64_t source_hash)
+{
+    fs::path cache_path = get_cache_path(source_hash);
+
+    std::ifstream cache_file(cache_path, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!cache_file.is_open())
+    {
+        return 0;
+    }
+
+    std::streamsize file_size = cache_file.tellg();
+    cache_file.seekg(0);
+
+    CGUIProgramCacheHeader cache_header;
+    std::vector<char> binary;
+
+    bool valid_entry = file_size >= (std::streamsize)sizeof(cache_header) &&
+                       cache_file.read(reinterpret_cast<char*>(&cache_header), sizeof(cache_header)).good() &&
+                       cache_header.magic == CGUI_PROGRAM_CACHE_MAGIC && cache_header.version == CGUI_PROGRAM_CACHE_VERSION &&
+                       cache_header.source_hash == source_hash && cache_header.binary_length != 0 &&
+                       file_size == (std::streamsize)(sizeof(cache_header) + cache_header.binary_length);
+
+    if (valid_entry)
+    {
+        binary.resize(cache_header.binary_length);
+        valid_entry = cache_file.read(binary.data(), (std::streamsize)binary.size()).good();
+    }
+    cache_file.close();
+
+    GLuint id = 0;
+    if (valid_entry)
+    {
+        id = glCreateProgram();
+        glProgramBinary(id, cache_header.binary_format, binary.data(), (GLsizei)binary.size());
+
+        GLint success = GL_FALSE;
+        glGetProgramiv(id, GL_LINK_STATUS, &success);
+        if (success == GL_FALSE)
+        {
+            glDeleteProgram(id);
+            id = 0;
+        }
+    }
+
+    if (id == 0)
+    {
+        std::error_code remove_error;
+        fs::remove(cache_path, remove_error);
+        debug_handler.post_log(std::string("Stale program binary has been discarded: ") + cache_path.string(), DEBUG_MODE_WARNING);
+        return 0;
+    }
+
+    CGUI_POST_LOG(debug_handler, DEBUG_MODE_LOG, std::string("Program has been loaded from binary cache: ") + cache_path.string());
+    return id;
+}
+
+/**
+ * @brief      Stores linked program in binary cache.
+ *
+ *             Entry is written to temporary file and renamed, so other instances
+ *             never read partially written binary.
+ *
+ * @param[in]  program_id   Linked program.
+ * @param[in]  source_hash  Hash of sources and driver.
+ */
+void CGUIShaderCompiler::store_program_binary(GLuint program_id, uint64_t source_hash)
+{
+    GLint binary_length = 0;
+    glGetProgramiv(program_id, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+    if (binary_length <= 0)
+    {
+        return;
+    }
+
+    CGUIProgramCacheHeader cache_header;
+    std::vector<char> binary((std::size_t)binary_length);
+    GLenum binary_format = GL_NONE;
+
+    glGetProgramBinary(program_id, binary_length, &binary_length, &binary_format, binary.data());
+    if (binary_length <= 0)
+    {
+        return;
+    }
+
+    cache_header.source_hash = source_hash;
+    cache_header.binary_format = binary_format;
+    cache_header.binary_length = (uint32_t)binary_length;
+
+    fs::path cache_path = get_cache_path(source_hash);
+    fs::path temporary_path = cache_path;
+    temporary_path += __CGUI_OBF__(".tmp");
+
+    std::ofstream cache_file(temporary_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!cache_file.is_open())
+    {
+        debug_handler.post_log(std::string("Unable to write program binary cache: ") + temporary_path.string(), DEBUG_MODE_WARNING);
+        return;
+    }
+
+    cache_file.write(reinterpret_cast<const char*>(&cache_header), sizeof(cache_header));
+    cache_file.write(binary.data(), binary_length);
+    bool is_written = cache_file.good();
+
+    // Close flushes the stream, so its failure means that file is incomplete
+    cache_file.close();
+    is_written = is_written && !cache_file.fail();
+
+    std::error_code cache_error;
+    if (is_written)
+    {
+        fs::rename(temporary_path, cache_path, cache_error);
+    }
+
+    if (!is_written || cache_error)
+    {
+        fs::remove(temporary_path, cache_error);
+        debug_handler.post_log(std::string("Unable to write program binary cache: ") + cache_path.string(), DEBUG_MODE_WARNING);
+    }
+}
+
+/**
+ * @brief      Reports sources of program, loaded from binary, to frame capture.
+ *
+ *             Capture snapshot recompiles programs from sources, that it normally
+ *             sees through glShaderSource, which is skipped on cache hit.
+ *
+ * @param[in]  program_id       Loaded program.
+ * @param[in]  vertex_shader    The vertex shader source.
+ * @param[in]  fragment_shader  The fragment shader source.
+ * @param[in]  geometry_shader  The geometry shader source.
+ */
+void CGUIShaderCompiler::track_program_sources(GLuint program_id, std::string_view vertex_shader, std::string_view fragment_shader, std::string_view geometry_shader)
+{
+    main_frame_capture.track_program_stage(program_id, GL_VERTEX_SHADER, std::string(vertex_shader));
+    main_frame_capture.track_program_stage(program_id, GL_FRAGMENT_SHADER, std::string(fragment_shader));
+
+    if (geometry_shader != "NONE")
+    {
+        main_frame_capture.track_program_stage(program_id, GL_GEOMETRY_SHADER, std::string(geometry_shader));
+    }
+}
+
+/**
+ * @brief      Checks, whether driver can give program binaries back.
+ *
+ * @return     True if binary cache can be used.
+ */
+bool CGUIShaderCompiler::is_binary_cache_supported()
+{
+    if (binary_cache_supported == -1)
+    {
+        GLint binary_format_count = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_format_count);
+        binary_cache_supported = (binary_format_count > 0) ? 1 : 0;
+
+        if (binary_cache_supported == 0)
+        {
+            debug_handler.post_log("Driver does not support program binaries, binary cache is disabled.", DEBUG_MODE_WARNING);
+        }
+    }
+
+    return binary_cache_supported == 1;
+}
+
+/**
+ * @brief      Gets path of binary cache entry.
+ *
+ * @param[in]  source_hash  Hash of sources and driver.
+ *
+ * @return     Path of the entry, its directory is created.
+ */
+fs::path CGUIShaderCompiler::get_cache_path(uint64_t source_hash)
+{
+    fs::path cache_directory = get_data_directory() / __CGUI_OBF__("program_cache");
+
+    std::error_code create_error;
+    fs::create_directories(cache_directory, create_error);
+
+    std::stringstream cache_name;
+    cache_name << std::hex << std::setw(16) << std::setfill('0') << source_hash << __CGUI_OBF__(".bin");
+
+    return cache_directory / cache_name.str();
+}
+
+/**
+ * @brief      Gets directory of files, that compiler keeps between runs.
+ *
+ * @return     Path of the directory, it is created.
+ */
+fs::path CGUIShaderCompiler::get_data_directory()
+{
+    fs::path data_directory;
+    const char* user_name = getenv("USER");
+
+    #if defined(_WIN32) || defined(WIN32) || defined(__CYGWIN__) || defined(__MINGW32__) || defined(__BORLANDC__)
+        (void)user_name;
+        data_directory = fs::current_path();
+    #endif // Windows
+    #if defined(__APPLE__)
+        data_directory = fs::path(__CGUI_OBF__("/Users/") + std::string((user_name != nullptr) ? user_name : "") + __CGUI_OBF__("/Library/Application Support/CGUI"));
+    #endif // Apple
+    #if defined(__unix__) || defined(__linux__)
+        data_directory = fs::path(__CGUI_OBF__("/home/") + std::string((user_name != nullptr) ? user_name : "") + __CGUI_OBF__("/.cgui"));
+    #endif // Unix
+
+    std::error_code create_error;
+    fs::create_directories(data_directory, create_error);
+
+    return data_directory;
+}
+
+/**
+ * @brief      Gets time, that has passed since start time.
+ *
+ * @param[in]  start_time  The start time.
+ *
+ * @return     Wall time in microseconds.
+ */
+uint64_t CGUIShaderCompiler::get_elapsed_time(std::chrono::steady_clock::time_point start_time)
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+/**
+ * @brief      Escapes string, so it could be written as JSON string.
+ *
+ * @param[in]  json_string  The string.
+ *
+ * @return     Escaped string without quotes.
+ */
+std::string CGUIShaderCompiler::escape_json(const std::string& json_string)
+{
+    std::string escaped_string;
+    escaped_string.reserve(json_string.size());
+
+    for (char string_char : json_string)
+    {
+        if (string_char == '"' || string_char == '\\')
+        {
+            escaped_string += '\\';
+            escaped_string += string_char;
+        }
+        else if ((unsigned char)string_char < 0x20)
+        {
+            char escaped_char[8];
+            std::snprintf(escaped_char, sizeof(escaped_char), "\\u%04x", (unsigned int)(unsigned char)string_char);
+            escaped_string += escaped_char;
+        }
+        else
+        {
+            escaped_string += string_char;
+        }
+    }
+
+    return escaped_string;
+}
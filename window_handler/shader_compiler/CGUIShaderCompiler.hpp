@@ -44,6 +44,11 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "../debug_handler/CGUIDebugHandler.hpp"
+#include "../memory_tracker/CGUIMemoryTracker.hpp"
+#include "../frame_capture/CGUIFrameCapture.hpp"
+
+#include "../asset_loader/CGUIAssetLoader.hpp"
+#include "CGUIShaderPreprocessor.hpp"
 
 #if defined(_WIN32) || defined(WIN32) || defined(__CYGWIN__) || defined(__MINGW32__) || defined(__BORLANDC__)
     #include "../../resources/resources.hpp"
@@ -52,8 +57,223 @@
 #endif // Windows
 
 #include <unordered_map>
+#include <type_traits>
+#include <string_view>
 #include <cstring>
+#include <cstdint>
+#include <chrono>
 #include <vector>
+#include <array>
+#include <mutex>
+
+/**
+ * Program binary cache file format, version is bumped on every layout change.
+ */
+#define CGUI_PROGRAM_CACHE_MAGIC    0x42504743  // "CGPB"
+#define CGUI_PROGRAM_CACHE_VERSION  1
+#define CGUI_PROGRAM_CACHE_PRIME    0x100000001B3ull
+#define CGUI_PROGRAM_CACHE_BASIS    0xCBF29CE484222325ull
+
+/**
+ * Interval in milliseconds, at which idle frames check reloads, that are being compiled.
+ */
+#define CGUI_RELOAD_POLL_INTERVAL   4
+
+/**
+ * Memory barriers for results of compute programs, named by the way results are read next.
+ */
+#define CGUI_BARRIER_STORAGE        GL_SHADER_STORAGE_BARRIER_BIT
+#define CGUI_BARRIER_VERTICES       (GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT)
+#define CGUI_BARRIER_INDIRECT       GL_COMMAND_BARRIER_BIT
+#define CGUI_BARRIER_UNIFORMS       GL_UNIFORM_BARRIER_BIT
+#define CGUI_BARRIER_IMAGES         (GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT)
+#define CGUI_BARRIER_READBACK       (GL_BUFFER_UPDATE_BARRIER_BIT | GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT)
+
+/**
+ * Header of cached program binary, binary itself follows it.
+ */
+struct CGUIProgramCacheHeader
+{
+    uint32_t    magic           = CGUI_PROGRAM_CACHE_MAGIC;
+    uint32_t    version         = CGUI_PROGRAM_CACHE_VERSION;
+    uint64_t    source_hash     = 0;
+    uint32_t    binary_format   = 0;
+    uint32_t    binary_length   = 0;
+};
+
+/**
+ * @brief      Hashes shader name, same FNV-1a is used for names known at runtime.
+ *
+ * @param[in]  shader_name  The shader name.
+ *
+ * @return     Hash of the name, never 0.
+ */
+constexpr uint64_t cgui_shader_name_hash(std::string_view shader_name)
+{
+    uint64_t name_hash = CGUI_PROGRAM_CACHE_BASIS;
+    for (char name_char : shader_name)
+    {
+        name_hash = (name_hash ^ (uint8_t)name_char) * CGUI_PROGRAM_CACHE_PRIME;
+    }
+
+    return (name_hash != 0) ? name_hash : 1;
+}
+
+/**
+ * Hash of static shader name, computed by compiler, so the name never gets into binary.
+ */
+#define CGUI_SHADER_NAME(shader_name) (std::integral_constant<uint64_t, cgui_shader_name_hash(shader_name)>::value)
+#define CGUI_UNIFORM_NAME(uniform_name) CGUI_SHADER_NAME(uniform_name)
+
+/**
+ * Handle of shader, index of its slot and generation, so handle of deleted shader
+ * never refers to shader, that has reused the slot.
+ */
+struct CGUIShaderHandle
+{
+    uint32_t    index       = UINT32_MAX;
+    uint32_t    generation  = 0;
+
+    bool is_valid() const { return index != UINT32_MAX; }
+    bool operator==(const CGUIShaderHandle& other_handle) const = default;
+};
+
+class CGUIShaderCompiler;
+
+/**
+ * @brief      Handle of program, that is being compiled asynchronously.
+ *
+ *             Becomes ready, once driver has finished compilation and linking.
+ *             Getting the id of program, that is not ready yet, waits for it.
+ */
+class CGUIShaderFuture
+{
+public:
+    CGUIShaderFuture();
+    CGUIShaderFuture(CGUIShaderCompiler* shader_compiler_arg, CGUIShaderHandle shader_handle_arg);
+
+    bool is_valid();
+    bool is_ready();
+    GLuint get();
+
+    CGUIShaderHandle get_handle();
+
+private:
+    CGUIShaderCompiler* shader_compiler = nullptr;
+    CGUIShaderHandle    shader_handle;
+};
+
+/**
+ * Compile telemetry of program, times are wall times in microseconds.
+ *
+ * Asynchronous stages are measured twice, when they are queued and when their results are
+ * waited for, so their times are the part of work, that was not hidden by driver threads.
+ */
+struct CGUIShaderStats
+{
+    std::array<uint64_t, 4>     compile_time        = {0, 0, 0, 0}; // Vertex, fragment, geometry, compute
+    std::array<std::size_t, 4>  source_size         = {0, 0, 0, 0};
+    uint64_t                    link_time           = 0;            // Binary load time for cached programs
+    uint64_t                    ready_time          = 0;            // From submission until program was usable
+
+    std::size_t                 binary_size         = 0;
+    std::size_t                 uniform_count       = 0;
+    std::size_t                 uniform_block_count = 0;
+    std::size_t                 attribute_count     = 0;
+
+    bool                        from_cache          = false;
+    bool                        asynchronous        = false;
+    uint32_t                    build_count         = 0;            // First build and every reload
+};
+
+/**
+ * Program, that has been submitted to driver, but was not checked yet.
+ */
+struct CGUIPendingShader
+{
+    GLuint      program_id      = 0;
+    GLuint      stage_ids[3]    = {0, 0, 0};    // Vertex, fragment, geometry
+    uint64_t    source_hash     = 0;
+    GLuint      cached_id       = 0;            // Program from binary cache, nothing to compile
+
+    CGUIShaderStats                         stats;
+    std::chrono::steady_clock::time_point   submit_time;
+};
+
+/**
+ * Reflected uniform, members of blocks have no location, but have offset inside their block.
+ */
+struct CGUIUniformInfo
+{
+    GLint       location        = -1;
+    GLenum      type            = GL_NONE;
+    GLint       array_size      = 1;
+    GLint       block_index     = -1;
+    GLint       offset          = -1;
+};
+
+/**
+ * Reflected uniform block.
+ */
+struct CGUIUniformBlockInfo
+{
+    GLuint      block_index     = GL_INVALID_INDEX;
+    GLint       binding         = 0;
+    GLint       data_size       = 0;
+};
+
+/**
+ * Reflected shader storage block, size of runtime sized array is counted once.
+ */
+struct CGUIStorageBlockInfo
+{
+    GLuint      block_index     = GL_INVALID_INDEX;
+    GLint       binding         = 0;
+    GLint       data_size       = 0;
+};
+
+/**
+ * Uniforms and blocks of linked program, keyed by hash of their names, arrays without [0].
+ */
+struct CGUIProgramReflection
+{
+    std::unordered_map<uint64_t, CGUIUniformInfo>       uniforms;
+    std::unordered_map<uint64_t, CGUIUniformBlockInfo>  uniform_blocks;
+    std::unordered_map<uint64_t, CGUIStorageBlockInfo>  storage_blocks;
+
+    glm::uvec3                                          workgroup_size = {0, 0, 0};    // Compute programs only
+};
+
+/**
+ * Shader slot, program id is read by handle without any lookup.
+ */
+struct CGUIShaderSlot
+{
+    GLuint                  program_id      = 0;
+    uint32_t                generation      = 0;
+    uint64_t                name_hash       = 0;        // 0 for free slot
+    std::string             shader_name;
+    CGUIProgramReflection   reflection;
+    CGUIShaderStats         stats;
+
+    bool                    pending         = false;
+    bool                    reloading       = false;
+    CGUIPendingShader       pending_shader;
+    CGUIPendingShader       reload_shader;
+
+    bool                    compute         = false;    // Compute program, its file is the first one
+    std::array<fs::path, 3> shader_files;               // Empty, if shader was not loaded from files
+    std::vector<std::string> shader_defines;
+    std::vector<fs::path>   dependency_files;           // Stage files and their includes
+
+    /**
+     * Family of permutations, it has no program, permutations are keyed by bitmask of features.
+     */
+    bool                                            variant_family  = false;
+    std::vector<std::string>                        variant_features;
+    std::array<std::string, 3>                      variant_sources;
+    std::unordered_map<uint64_t, CGUIShaderHandle>  variants;
+};
 
 class CGUIShaderCompiler
 {
@@ -66,22 +286,146 @@ public:
     #endif // Windows
     ~CGUIShaderCompiler();
 
-    GLuint compile_shader(const std::string& vertex_shader, const std::string& fragment_shader, const std::string& geometry_shader);
+    GLuint compile_shader(std::string_view vertex_shader, std::string_view fragment_shader, std::string_view geometry_shader, CGUIShaderStats* compile_stats = nullptr);
 
-    void add_shader(const std::string& shader_name, fs::path vertext_file_path, fs::path fragment_file_path, fs::path geometry_file_path);
-    void add_shader(const std::string& shader_name, const std::string& vertex_shader, const std::string& fragment_shader, const std::string& geometry_shader);
+    CGUIShaderHandle add_shader(const std::string& shader_name, fs::path vertext_file_path, fs::path fragment_file_path, fs::path geometry_file_path,
+                                const std::vector<std::string>& shader_defines = {});
+    CGUIShaderHandle add_shader(const std::string& shader_name, const std::string& vertex_shader, const std::string& fragment_shader, const std::string& geometry_shader,
+                                const std::vector<std::string>& shader_defines = {});
     #if defined(_WIN32) || defined(WIN32) || defined(__CYGWIN__) || defined(__MINGW32__) || defined(__BORLANDC__)
-        void add_shader(const std::string& shader_name, unsigned int vertex_shader_rsid, unsigned int fragment_shader_rsid, unsigned int geometry_shader_rsid);
+        CGUIShaderHandle add_shader(const std::string& shader_name, unsigned int vertex_shader_rsid, unsigned int fragment_shader_rsid, unsigned int geometry_shader_rsid);
     #endif // Windows
+    CGUIShaderFuture add_shader_async(const std::string& shader_name, fs::path vertext_file_path, fs::path fragment_file_path, fs::path geometry_file_path,
+                                      const std::vector<std::string>& shader_defines = {});
+    CGUIShaderFuture add_shader_async(const std::string& shader_name, const std::string& vertex_shader, const std::string& fragment_shader, const std::string& geometry_shader,
+                                      const std::vector<std::string>& shader_defines = {});
+
+    CGUIShaderHandle add_shader_variants(const std::string& shader_name, fs::path vertext_file_path, fs::path fragment_file_path, fs::path geometry_file_path,
+                                         const std::vector<std::string>& variant_features);
+    CGUIShaderHandle add_shader_variants(const std::string& shader_name, const std::string& vertex_shader, const std::string& fragment_shader, const std::string& geometry_shader,
+                                         const std::vector<std::string>& variant_features);
+    CGUIShaderHandle get_variant(CGUIShaderHandle family_handle, uint64_t variant_key);
+
+    GLuint compile_compute(std::string_view compute_shader, CGUIShaderStats* compile_stats = nullptr);
+
+    CGUIShaderHandle add_compute(const std::string& shader_name, fs::path compute_file_path, const std::vector<std::string>& shader_defines = {});
+    CGUIShaderHandle add_compute(const std::string& shader_name, const std::string& compute_shader, const std::vector<std::string>& shader_defines = {});
+
+    bool dispatch_compute(CGUIShaderHandle shader_handle, glm::uvec3 group_count);
+    bool dispatch_compute_items(CGUIShaderHandle shader_handle, glm::uvec3 item_count);
+    bool dispatch_compute_indirect(CGUIShaderHandle shader_handle, GLintptr indirect_offset);
+    glm::uvec3 get_workgroup_size(CGUIShaderHandle shader_handle);
+
+    static void memory_barrier(GLbitfield barrier_bits);
+    static void memory_barrier_by_region(GLbitfield barrier_bits);
+
+    CGUIShaderPreprocessor* get_preprocessor();
+    CGUIAssetLoader* get_asset_loader();
+
+    bool is_shader_ready(CGUIShaderHandle shader_handle);
+    std::size_t poll_shaders();
+    void wait_shaders();
+
+    std::vector<fs::path> get_shader_files();
+    uint64_t get_shader_files_revision();
+    void request_reload(const fs::path& changed_file);
+    std::vector<CGUIShaderHandle> update_reloads();
+    bool has_pending_reloads();
+
+    void del_shader(CGUIShaderHandle shader_handle);
     void del_shader(const std::string& shader_name);
+    void use_shader(CGUIShaderHandle shader_handle);
     void use_shader(const std::string& shader_name);
 
+    GLuint get_shader_id(CGUIShaderHandle shader_handle);
+    GLuint get_shader_id(const std::string& shader_name);
+
+    CGUIShaderHandle get_shader_handle(uint64_t name_hash);
+    CGUIShaderHandle get_shader_handle(const std::string& shader_name);
+
+    const CGUIProgramReflection* get_reflection(CGUIShaderHandle shader_handle);
+    const CGUIUniformInfo* get_uniform(CGUIShaderHandle shader_handle, uint64_t name_hash);
+    const CGUIUniformBlockInfo* get_uniform_block(CGUIShaderHandle shader_handle, uint64_t name_hash);
+    const CGUIStorageBlockInfo* get_storage_block(CGUIShaderHandle shader_handle, uint64_t name_hash);
+    GLint get_uniform_location(CGUIShaderHandle shader_handle, uint64_t name_hash);
+    bool check_uniform_block(CGUIShaderHandle shader_handle, uint64_t name_hash, std::size_t block_size);
+
+    const CGUIShaderStats* get_shader_stats(CGUIShaderHandle shader_handle);
+    void report_shader_stats();
+    bool export_shader_stats(const fs::path& file_path = fs::path());
+
     bool check_for_errors(GLuint shader_id, std::string shader_type);
 
-    std::string* get_shader_names();
+private:
+    bool read_shader_files(const std::array<fs::path, 3>& stage_paths, std::array<CGUIMappedFile, 3>& stage_files, std::array<std::string_view, 3>& stage_sources);
+    bool preprocess_sources(const std::array<fs::path, 3>& stage_paths, std::array<std::string_view, 3>& stage_sources, std::array<std::string, 3>& processed_sources,
+                            const std::vector<std::string>& shader_defines, std::vector<fs::path>& dependency_files);
+    void set_shader_files(CGUIShaderSlot& shader_slot, const std::array<fs::path, 3>& stage_paths,
+                          const std::vector<std::string>& shader_defines, const std::vector<fs::path>& dependency_files);
+
+    CGUIShaderHandle link_shader(const std::string& shader_name, const std::array<std::string_view, 3>& stage_sources);
+    CGUIShaderFuture submit_shader(const std::string& shader_name, const std::array<std::string_view, 3>& stage_sources);
+    CGUIShaderHandle link_compute(const std::string& shader_name, std::string_view compute_shader);
+    CGUIShaderSlot* get_compute_slot(CGUIShaderHandle shader_handle);
+    glm::uvec3 get_max_workgroup_count();
+
+    CGUIShaderSlot* get_slot(CGUIShaderHandle shader_handle);
+    CGUIShaderHandle allocate_slot(const std::string& shader_name);
+    void release_slot(CGUIShaderHandle shader_handle);
+
+    void register_shader(CGUIShaderSlot& shader_slot, GLuint shader_id, const CGUIShaderStats& compile_stats);
+    void reflect_program(GLuint program_id, CGUIProgramReflection& reflection);
+    bool finish_shader(CGUIShaderSlot& shader_slot);
+    void submit_reload(CGUIShaderSlot& shader_slot);
+    void submit_compute_reload(CGUIShaderSlot& shader_slot);
+    void drop_reload(CGUIShaderSlot& shader_slot);
+
+    void submit_program(std::string_view vertex_shader, std::string_view fragment_shader, std::string_view geometry_shader, CGUIPendingShader& pending_shader);
+    GLuint link_pending_shader(CGUIPendingShader& pending_shader);
+    bool is_program_complete(const CGUIPendingShader& pending_shader);
+    bool is_parallel_compile_supported();
+
+    uint64_t get_source_hash(std::string_view vertex_shader, std::string_view fragment_shader, std::string_view geometry_shader);
+
+    GLuint load_program_binary(uint64_t source_hash);
+    void store_program_binary(GLuint program_id, uint64_t source_hash);
+    void track_program_sources(GLuint program_id, std::string_view vertex_shader, std::string_view fragment_shader, std::string_view geometry_shader);
+
+    bool is_binary_cache_supported();
+    fs::path get_cache_path(uint64_t source_hash);
+    fs::path get_data_directory();
+
+    static uint64_t get_elapsed_time(std::chrono::steady_clock::time_point start_time);
+    static std::string escape_json(const std::string& json_string);
 
 private:
-    std::unordered_map<std::string, GLuint> shader_list;
+    /**
+     * Slots are indexed by handles, names are only hashed, when handle is looked up.
+     */
+    std::vector<CGUIShaderSlot>                     shader_slots;
+    std::vector<uint32_t>                           free_slots;
+    std::unordered_map<uint64_t, CGUIShaderHandle>  shader_names;
+
+    CGUIAssetLoader        asset_loader;
+    CGUIShaderPreprocessor preprocessor = CGUIShaderPreprocessor(&asset_loader);
+
+    /**
+     * Hot reload state, changed files are reported by event thread.
+     */
+    std::vector<fs::path>   changed_files;
+    std::mutex              reload_mutex;
+    uint64_t                shader_files_revision = 0;
+
+    /**
+     * Program binary cache state, -1 means that driver support was not checked yet.
+     */
+    int binary_cache_supported = -1;
+    int parallel_compile_supported = -1;
+
+    /**
+     * Dispatch limits of driver, 0 means that they were not queried yet.
+     */
+    glm::uvec3 max_workgroup_count = {0, 0, 0};
 
     CGUIDebugHandler debug_handler = CGUIDebugHandler(false);
 };
@@ -0,0 +1,294 @@
+/**
+ * @file       <CGUIShaderPreprocessor.cpp>
+ * @brief      This source file implements CGUIShaderPreprocessor class.
+ *
+ *             It is being used in order to resolve includes and inject defines
+ *             into shader sources, before they are passed to driver.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#include "CGUIShaderPreprocessor.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief      Constructs a new shader preprocessor.
+ *
+ * @param      asset_loader_arg  Loader of included files, it has to outlive preprocessor.
+ */
+CGUIShaderPreprocessor::CGUIShaderPreprocessor(CGUIAssetLoader* asset_loader_arg)
+{
+    debug_handler = CGUIDebugHandler(main_debug_handler);
+    asset_loader = asset_loader_arg;
+}
+
+/**
+ * @brief      Destroys shader preprocessor.
+ */
+CGUIShaderPreprocessor::~CGUIShaderPreprocessor()
+{
+    include_directories.clear();
+    include_sources.clear();
+    included_files.clear();
+}
+
+/**
+ * @brief      Adds directory, that is searched for included files.
+ *
+ * @param[in]  include_directory  Path of the directory.
+ */
+void CGUIShaderPreprocessor::add_include_directory(const fs::path& include_directory)
+{
+    include_directories.push_back(include_directory);
+}
+
+/**
+ * @brief      Registers source, that can be included by name without any file.
+ *
+ * @param[in]  include_name    Name, used in #include.
+ * @param[in]  include_source  The include source.
+ */
+void CGUIShaderPreprocessor::add_include_source(const std::string& include_name, const std::string& include_source)
+{
+    include_sources[include_name] = include_source;
+}
+
+/**
+ * @brief      Preprocesses source of one stage.
+ *
+ * @param[in]  source            The stage source.
+ * @param[in]  source_path       Path of the stage file, empty if source was not read from file.
+ * @param[in]  defines           Defines to inject, "NAME" or "NAME=VALUE".
+ * @param      processed_source  Source, that can be passed to driver.
+ * @param      dependency_files  Stage file and every included file are appended to it.
+ *
+ * @return     False if some include can not be resolved.
+ */
+bool CGUIShaderPreprocessor::process(std::string_view source, const fs::path& source_path, const std::vector<std::string>& defines,
+                                     std::string& processed_source, std::vector<fs::path>& dependency_files)
+{
+    included_files.clear();
+    source_count = 1;
+
+    processed_source.clear();
+    processed_source.reserve(source.size());
+
+    std::string_view remaining_source = source;
+    std::size_t first_line = 1;
+
+    // #version has to stay the first directive, so defines go right after it
+    std::size_t version_position = source.find("#version");
+    if (version_position != std::string::npos && source.find_first_not_of(" \t\r\n") == version_position)
+    {
+        std::size_t version_end = source.find('\n', version_position);
+        version_end = (version_end == std::string::npos) ? source.size() : version_end + 1;
+
+        processed_source.append(source, 0, version_end);
+        if (processed_source.back() != '\n')
+        {
+            processed_source += '\n';
+        }
+
+        first_line += (std::size_t)std::count(source.begin(), source.begin() + (std::ptrdiff_t)version_end, '\n');
+        remaining_source.remove_prefix(version_end);
+    }
+
+    for (const std::string& define : defines)
+    {
+        std::string define_line = define;
+        std::size_t value_position = define_line.find('=');
+        if (value_position != std::string::npos)
+        {
+            define_line[value_position] = ' ';
+        }
+
+        processed_source += "#define " + define_line + "\n";
+    }
+
+    if (!source_path.empty())
+    {
+        std::error_code path_error;
+        fs::path absolute_path = fs::absolute(source_path, path_error).lexically_normal();
+
+        included_files.insert(absolute_path.string());
+        dependency_files.push_back(absolute_path);
+    }
+
+    return expand(remaining_source, source_path, 0, first_line, processed_source, dependency_files);
+}
+
+/********************************************************************************
+ *                                  Private block                               *
+ ********************************************************************************/
+
+/**
+ * @brief      Copies source and replaces its includes recursively.
+ *
+ * @param[in]  source            The source.
+ * @param[in]  source_path       Path of the source, empty for registered sources.
+ * @param[in]  source_index      Source number, used in #line.
+ * @param[in]  first_line        Number of the first line of source.
+ * @param      processed_source  Output source.
+ * @param      dependency_files  Included files are appended to it.
+ *
+ * @return     False if some include can not be resolved.
+ */
+bool CGUIShaderPreprocessor::expand(std::string_view source, const fs::path& source_path, std::size_t source_index, std::size_t first_line,
+                                    std::string& processed_source, std::vector<fs::path>& dependency_files)
+{
+    processed_source += "#line " + std::to_string(first_line) + " " + std::to_string(source_index) + "\n";
+
+    std::size_t line_number = first_line;
+    while (!source.empty())
+    {
+        std::size_t line_end = source.find('\n');
+        std::string_view line = source.substr(0, line_end);
+        source.remove_prefix((line_end == std::string_view::npos) ? source.size() : line_end + 1);
+        line_number++;
+
+        std::string include_name;
+        if (!parse_include(line, include_name))
+        {
+            processed_source.append(line);
+            processed_source += '\n';
+            continue;
+        }
+
+        fs::path include_path;
+        std::string include_source;
+        if (!resolve_include(include_name, source_path, include_path, include_source))
+        {
+            debug_handler.post_log(std::string("Unable to resolve shader include: ") + include_name + " in " + source_path.string(), DEBUG_MODE_ERROR);
+            return false;
+        }
+
+        // Repeated include is replaced by empty line, so numbering stays the same
+        std::string include_key = (include_path.empty()) ? include_name : include_path.string();
+        if (!included_files.insert(include_key).second)
+        {
+            processed_source += '\n';
+            continue;
+        }
+
+        if (!include_path.empty())
+        {
+            dependency_files.push_back(include_path);
+        }
+
+        std::size_t include_index = source_count++;
+        if (!expand(include_source, include_path, include_index, 1, processed_source, dependency_files))
+        {
+            return false;
+        }
+
+        processed_source += "#line " + std::to_string(line_number) + " " + std::to_string(source_index) + "\n";
+    }
+
+    return true;
+}
+
+/**
+ * @brief      Finds included file.
+ *
+ * @param[in]  include_name    Name, used in #include.
+ * @param[in]  source_path     Path of the including source, empty for registered sources.
+ * @param      include_path    Absolute path of the file, empty for registered source.
+ * @param      include_source  The include source.
+ *
+ * @return     False if include was not found.
+ */
+bool CGUIShaderPreprocessor::resolve_include(const std::string& include_name, const fs::path& source_path, fs::path& include_path, std::string& include_source)
+{
+    std::vector<fs::path> candidate_paths;
+    if (!source_path.empty())
+    {
+        candidate_paths.push_back(source_path.parent_path() / include_name);
+    }
+
+    for (const fs::path& include_directory : include_directories)
+    {
+        candidate_paths.push_back(include_directory / include_name);
+    }
+
+    std::error_code path_error;
+    for (const fs::path& candidate_path : candidate_paths)
+    {
+        if (!fs::is_regular_file(candidate_path, path_error))
+        {
+            continue;
+        }
+
+        CGUIMappedFile include_file = asset_loader->load(candidate_path);
+        if (!include_file.is_open())
+        {
+            continue;
+        }
+
+        include_source = std::string(include_file.get_view());
+        include_path = fs::absolute(candidate_path, path_error).lexically_normal();
+        return true;
+    }
+
+    auto source_iterator = include_sources.find(include_name);
+    if (source_iterator != include_sources.end())
+    {
+        include_source = source_iterator->second;
+        include_path.clear();
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief      Parses #include "name" or #include <name> directive.
+ *
+ * @param[in]  line          Source line.
+ * @param      include_name  Name of included file.
+ *
+ * @return     False if line is not include directive.
+ */
+bool CGUIShaderPreprocessor::parse_include(std::string_view line, std::string& include_name)
+{
+    std::size_t position = line.find_first_not_of(" \t");
+    if (position == std::string_view::npos || line[position] != '#')
+    {
+        return false;
+    }
+
+    position = line.find_first_not_of(" \t", position + 1);
+    if (position == std::string_view::npos || line.substr(position, 7) != "include")
+    {
+        return false;
+    }
+
+    position = line.find_first_not_of(" \t", position + 7);
+    if (position == std::string_view::npos || (line[position] != '"' && line[position] != '<'))
+    {
+        return false;
+    }
+
+    std::size_t name_end = line.find((line[position] == '"') ? '"' : '>', position + 1);
+    if (name_end == std::string_view::npos)
+    {
+        return false;
+    }
+
+    include_name = std::string(line.substr(position + 1, name_end - position - 1));
+    return true;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file       <CGUIShaderPreprocessor.hpp>
+ * @brief      This header file implements CGUIShaderPreprocessor class.
+ *
+ *             It is being used in order to resolve includes and inject defines
+ *             into shader sources, before they are passed to driver.
+ *
+ * @author     THE_CHOODICK
+ * @date       30-07-2022
+ * @version    0.0.1
+ *
+ * @warning    This library is under development, so it might work unstable.
+ * @bug        Currently, there are no any known bugs.
+ *
+ *             In order to submit new ones, please contact me via bug-report@choodick.com.
+ *
+ * @copyright  Copyright 2022 Alexander. All rights reserved.
+ *
+ *             (Not really)
+ *
+ * @license    This project is released under the GNUv3 Public License.
+ *
+ * @todo       Implement the whole class.
+ */
+#ifndef CGUISHADERPREPROCESSOR_HPP
+#define CGUISHADERPREPROCESSOR_HPP
+
+#include "../debug_handler/CGUIDebugHandler.hpp"
+#include "../asset_loader/CGUIAssetLoader.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <string_view>
+#include <vector>
+#include <string>
+
+/**
+ * @brief      This class implements preprocessing of GLSL sources.
+ *
+ *             Defines are injected right after #version, every #include "name" is replaced
+ *             by the included file, which is searched next to the including file, then in
+ *             include directories and then among registered include sources. Every file is
+ *             included once per stage, so include guards are not needed. #line directives
+ *             keep line numbers of driver errors, their source number is the index of file
+ *             in the order, in which files were first included, 0 is the stage itself.
+ *             Included files are loaded by asset loader, same as stages themselves.
+ */
+class CGUIShaderPreprocessor
+{
+public:
+    CGUIShaderPreprocessor(CGUIAssetLoader* asset_loader_arg);
+    CGUIShaderPreprocessor(const CGUIShaderPreprocessor&) = delete;
+    ~CGUIShaderPreprocessor();
+
+    void add_include_directory(const fs::path& include_directory);
+    void add_include_source(const std::string& include_name, const std::string& include_source);
+
+    bool process(std::string_view source, const fs::path& source_path, const std::vector<std::string>& defines,
+                 std::string& processed_source, std::vector<fs::path>& dependency_files);
+
+private:
+    bool expand(std::string_view source, const fs::path& source_path, std::size_t source_index, std::size_t first_line,
+                std::string& processed_source, std::vector<fs::path>& dependency_files);
+    bool resolve_include(const std::string& include_name, const fs::path& source_path, fs::path& include_path, std::string& include_source);
+
+    static bool parse_include(std::string_view line, std::string& include_name);
+
+private:
+    std::vector<fs::path>                           include_directories;
+    std::unordered_map<std::string, std::string>    include_sources;
+
+    CGUIAssetLoader* asset_loader;
+
+    /**
+     * State of the stage, that is being processed.
+     */
+    std::unordered_set<std::string> included_files;
+    std::size_t                     source_count = 0;
+
+    CGUIDebugHandler debug_handler = CGUIDebugHandler(false);
+};
+
+#endif // CGUISHADERPREPROCESSOR_HPP